@@ -29,7 +29,9 @@
 #include "client.h"
 #include "compositor.h"
 #include "config.h"
+#include "detail/deltaImage.h"
 #include "detail/fileFrameWriter.h"
+#include "detail/transmitScheduler.h"
 #include "error.h"
 #include "frame.h"
 #include "frameData.h"
@@ -56,12 +58,14 @@
 #include <eq/fabric/tile.h>
 #include <eq/util/accum.h>
 #include <eq/util/objectManager.h>
+#include <eq/util/sharedMemoryRing.h>
 
 #include <co/connectionDescription.h>
 #include <co/exception.h>
 #include <co/objectICommand.h>
 #include <co/queueSlave.h>
 #include <co/sendToken.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/rng.h>
 #include <lunchbox/scopedMutex.h>
 #include <pression/plugins/compressor.h>
@@ -72,6 +76,8 @@
 #endif
 
 #include <bitset>
+#include <cstring>
+#include <limits>
 #include <set>
 
 #include "detail/channel.ipp"
@@ -91,6 +97,205 @@ using detail::STATE_RUNNING;
 using detail::STATE_FAILED;
 /** @endcond */
 
+namespace
+{
+/** The pixel data of one image attachment to transmit. */
+struct Transmission
+{
+    /** @return the size of the uncompressed pixel data. */
+    uint64_t getSize() const
+    {
+        return data ? data->pvp.getArea() * data->pixelSize : 0;
+    }
+
+    /** @return the size of the command data of the transmission. */
+    uint64_t getSendSize() const
+    {
+        uint64_t size = sizeof(FrameData::ImageHeader);
+        if (delta)
+            size += delta->getTiles().size() * sizeof(uint64_t);
+
+        if (region.size > 0)
+            return size + sizeof(region);
+        if (data && data->compressedData.isCompressed())
+            return size + data->compressedData.getSize() +
+                   data->compressedData.chunks.size() * sizeof(uint64_t) +
+                   data->compressedStripes.size() * sizeof(Vector2ui);
+        return size + sizeof(uint64_t) + getSize();
+    }
+
+    const PixelData* data;           //!< 0 for a delta without changes
+    const detail::DeltaImage* delta; //!< the delta encoding, or 0
+    const PixelData* pixels;         //!< the uncompressed pixel data
+    util::SharedMemoryRing::Region region; //!< the pixels in shared memory
+    float quality;
+    uint32_t deltaSlot;
+    uint32_t deltaSequence;
+};
+
+/** The image attachments of one image to transmit. */
+struct ImageTransmission
+{
+    const Image* image;
+    Frame::Buffer buffers;
+    std::vector<Transmission> transmissions;
+};
+
+/** A node receiving transmitted images. */
+struct Receiver
+{
+    uint128_t nodeID; //!< the identifier of the eq::Node
+    co::NodePtr node;
+    co::ConnectionPtr connection;
+    detail::CompressorSelector* selector;
+    util::SharedMemoryRing* ring; //!< for receivers on the same host, or 0
+};
+
+/**
+ * @return the transmission of the uncompressed pixels through the shared
+ *         memory ring, sent inline if the ring is full.
+ */
+Transmission _share(const Transmission& transmission,
+                    util::SharedMemoryRing& ring)
+{
+    Transmission shared = transmission;
+    shared.data = transmission.pixels;
+    shared.delta = 0; // the full image updates the delta reference as well
+
+    const uint64_t size = shared.getSize();
+    void* data = ring.allocate(size, shared.region);
+    if (data)
+        ::memcpy(data, shared.data->pixels, size);
+    else
+        shared.region.size = 0;
+    return shared;
+}
+
+/** Send the header and pixel data of an image attachment. @return the size */
+uint64_t _send(co::Connection& connection, const Transmission& transmission)
+{
+    const PixelData* data = transmission.data;
+    const PixelData& format =
+        transmission.delta ? transmission.delta->getReference() : *data;
+    const bool isShared = transmission.region.size > 0;
+    const bool isCompressed =
+        !isShared && data && data->compressedData.isCompressed();
+    const uint32_t nChunks =
+        isCompressed ? uint32_t(data->compressedData.chunks.size()) : 1;
+    const uint32_t nStripes =
+        isCompressed ? uint32_t(data->compressedStripes.size()) : 0;
+    const uint32_t nTileWords =
+        transmission.delta ? uint32_t(transmission.delta->getTiles().size())
+                           : 0;
+
+    const FrameData::ImageHeader header = {
+        format.internalFormat,
+        format.externalFormat,
+        format.pixelSize,
+        format.pvp,
+        isCompressed ? data->compressedData.compressor : EQ_COMPRESSOR_NONE,
+        data ? data->compressorFlags : 0,
+        nChunks,
+        transmission.quality,
+        nStripes,
+        transmission.deltaSlot,
+        nTileWords,
+        transmission.deltaSequence,
+        uint32_t(isShared)};
+
+    connection.send(&header, sizeof(header), true);
+    uint64_t size = sizeof(header);
+
+    if (nTileWords > 0)
+    {
+        const uint64_t tilesSize = nTileWords * sizeof(uint64_t);
+        connection.send(transmission.delta->getTiles().data(), tilesSize, true);
+        size += tilesSize;
+    }
+
+    if (isShared)
+    {
+        connection.send(&transmission.region, sizeof(transmission.region),
+                        true);
+        size += sizeof(transmission.region);
+    }
+    else if (isCompressed)
+    {
+        if (nStripes > 0)
+        {
+            const uint64_t stripesSize = nStripes * sizeof(Vector2ui);
+            connection.send(data->compressedStripes.data(), stripesSize, true);
+            size += stripesSize;
+        }
+
+        for (const auto& chunk : data->compressedData.chunks)
+        {
+            const uint64_t dataSize = chunk.getNumBytes();
+
+            connection.send(&dataSize, sizeof(dataSize), true);
+            if (dataSize > 0)
+                connection.send(chunk.data, dataSize, true);
+            size += sizeof(dataSize) + dataSize;
+        }
+    }
+    else
+    {
+        const uint64_t dataSize = transmission.getSize();
+        connection.send(&dataSize, sizeof(dataSize), true);
+        if (dataSize > 0)
+            connection.send(data->pixels, dataSize, true);
+        size += sizeof(dataSize) + dataSize;
+    }
+    return size;
+}
+
+/** Compress the pixel data of an image using the given compressor. */
+const PixelData& _compressPixelData(Image& image, const Frame::Buffer buffer,
+                                    const uint32_t name,
+                                    detail::CompressorSelector& selector)
+{
+    const PixelData& data = image.getPixelData(buffer);
+    if (data.compressorName != EQ_COMPRESSOR_AUTO)
+        return name == EQ_COMPRESSOR_NONE ? data
+                                          : image.compressPixelData(buffer);
+
+    image.useCompressor(buffer, name);
+    if (name == EQ_COMPRESSOR_NONE || data.compressedData.isCompressed())
+    {
+        image.useCompressor(buffer, EQ_COMPRESSOR_AUTO);
+        return data;
+    }
+
+    lunchbox::Clock clock;
+    image.compressPixelData(buffer);
+
+    // a compressor failing on the image is measured as not compressing
+    const uint64_t size = image.getPixelDataSize(buffer);
+    selector.addCompression(name, size,
+                            data.compressedData.isCompressed()
+                                ? data.compressedData.getSize()
+                                : size,
+                            clock.getTimef());
+    image.useCompressor(buffer, EQ_COMPRESSOR_AUTO);
+    return data;
+}
+
+/** Compress the changed tiles of a delta using the given compressor. */
+const PixelData& _compressDelta(detail::DeltaImage& delta, const uint32_t name,
+                                detail::CompressorSelector& selector)
+{
+    lunchbox::Clock clock;
+    const PixelData& data = delta.compress(name);
+    const uint64_t size = data.pvp.getArea() * data.pixelSize;
+    selector.addCompression(name, size,
+                            data.compressedData.isCompressed()
+                                ? data.compressedData.getSize()
+                                : size,
+                            clock.getTimef());
+    return data;
+}
+}
+
 Channel::Channel(Window* parent)
     : Super(parent)
     , _impl(new detail::Channel)
@@ -1247,8 +1452,11 @@ bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
                     << getTaskID() << nodes << netNodes;
             }
             else // transmit images asynchronously
+            {
+                _impl->cropImage(*frameData, *images[j]);
                 _asyncTransmit(frameData, frameNumber, j, nodes, netNodes,
                                getTaskID());
+            }
         }
     }
     return hasAsyncReadback;
@@ -1279,6 +1487,7 @@ void Channel::_finishReadback(const co::ObjectVersion& frameDataVersion,
     const GLEWContext* glewContext = window->getTransferGlewContext();
     image->finishReadback(glewContext);
     LBASSERT(!image->hasAsyncReadback());
+    _impl->cropImage(*frameData, *image);
 
     // schedule async image tranmission
     _asyncTransmit(frameData, frameNumber, imageIndex, nodes, netNodes, taskID);
@@ -1290,199 +1499,337 @@ void Channel::_asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
                              const co::NodeIDs& netNodes, const uint32_t taskID)
 {
     LBASSERT(nodes.size() == netNodes.size());
-    co::NodeIDs::const_iterator j = netNodes.begin();
-    for (std::vector<uint128_t>::const_iterator i = nodes.begin();
-         i != nodes.end(); ++i, ++j)
+    if (nodes.empty())
+        return;
+
+    _refFrame(frameNumber);
+
+    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Start transmit frame data " << frame
+                                    << " to " << nodes.size() << " receivers"
+                                    << std::endl;
+
+    // Images queued while the transmitter is busy are sent together with
+    // the pending ones, using a single command per receiver.
+    const co::ObjectVersion frameDataVersion(frame);
+    const detail::Channel::TransmitKey key(frameDataVersion.identifier,
+                                           frameDataVersion.version, nodes);
+    {
+        lunchbox::ScopedFastWrite mutex(_impl->pendingTransmits);
+        std::vector<uint64_t>& pending = _impl->pendingTransmits.data[key];
+        pending.push_back(image);
+        if (pending.size() > 1)
+            return;
+    }
+
+    // The node transmitter runs the queued transmission with the earliest
+    // deadline for each transmit command.
+    const Image* queued = frame->getImages()[image];
+    uint64_t size = 0;
+    for (const Frame::Buffer buffer :
+         {Frame::Buffer::color, Frame::Buffer::depth})
+    {
+        if (queued->hasPixelData(buffer))
+            size += queued->getPixelDataSize(buffer);
+    }
+
+    getNode()->getTransmitScheduler().push(
+        frameDataVersion, frameNumber, size * nodes.size(),
+        [this, frameDataVersion, nodes, netNodes, frameNumber, taskID] {
+            return _transmitPending(frameDataVersion, nodes, netNodes,
+                                    frameNumber, taskID);
+        });
+    send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE);
+}
+
+uint64_t Channel::_transmitPending(const co::ObjectVersion& frameDataVersion,
+                                   const std::vector<uint128_t>& nodes,
+                                   const co::NodeIDs& netNodes,
+                                   const uint32_t frameNumber,
+                                   const uint32_t taskID)
+{
+    std::vector<uint64_t> images;
     {
-        _refFrame(frameNumber);
-
-        LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Start transmit frame data " << frame
-                                        << " receiver " << *i << " on " << *j
-                                        << std::endl;
-        send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE)
-            << co::ObjectVersion(frame) << *i << *j << image << frameNumber
-            << taskID;
+        const detail::Channel::TransmitKey key(frameDataVersion.identifier,
+                                               frameDataVersion.version, nodes);
+        lunchbox::ScopedFastWrite mutex(_impl->pendingTransmits);
+        detail::Channel::PendingTransmits::iterator i =
+            _impl->pendingTransmits->find(key);
+        LBASSERT(i != _impl->pendingTransmits->end());
+        images.swap(i->second);
+        _impl->pendingTransmits->erase(i);
     }
+
+    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit frame data "
+                                    << frameDataVersion << " to "
+                                    << nodes.size() << " receivers, "
+                                    << images.size() << " images" << std::endl;
+
+    const uint64_t size = _transmitImages(frameDataVersion, nodes, netNodes,
+                                          images, frameNumber, taskID);
+    for (size_t i = 0; i < images.size(); ++i)
+        _unrefFrame(frameNumber);
+    return size;
 }
 
-void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
-                             const uint128_t& nodeID,
-                             const co::NodeID& netNodeID,
-                             const uint64_t imageIndex,
-                             const uint32_t frameNumber, const uint32_t taskID)
+uint64_t Channel::_transmitImages(const co::ObjectVersion& frameDataVersion,
+                                  const std::vector<uint128_t>& nodes,
+                                  const co::NodeIDs& netNodes,
+                                  const std::vector<uint64_t>& imageIndices,
+                                  const uint32_t frameNumber,
+                                  const uint32_t taskID)
 {
-    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit" << std::endl;
+    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit " << imageIndices.size()
+                                    << " images" << std::endl;
     FrameDataPtr frameData = getNode()->getFrameData(frameDataVersion);
     LBASSERT(frameData);
 
     if (frameData->getBuffers() == Frame::Buffer::none)
     {
         LBWARN << "No buffers for frame data" << std::endl;
-        return;
+        return 0;
     }
 
     ChannelStatistics transmitEvent(Statistic::CHANNEL_FRAME_TRANSMIT, this,
                                     frameNumber);
     transmitEvent.statistic.task = taskID;
 
-    const Images& images = frameData->getImages();
-    Image* image = images[imageIndex];
-    LBASSERT(images.size() > imageIndex);
-
-    if (image->getStorageType() == Frame::TYPE_TEXTURE)
+    // The images are compressed once and sent to all receivers. The
+    // compressor is chosen for the slowest link.
+    co::LocalNodePtr localNode = getLocalNode();
+    std::vector<Receiver> receivers;
+    std::vector<uint128_t> receiverIDs;
+    for (size_t i = 0; i < nodes.size(); ++i)
     {
-        LBWARN << "Can't transmit image of type TEXTURE" << std::endl;
-        LBUNIMPLEMENTED;
-        return;
+        const co::NodeID& netNodeID = netNodes[i];
+        Receiver receiver;
+        receiver.nodeID = nodes[i];
+        receiver.node = localNode->connect(netNodeID);
+        if (!receiver.node || !receiver.node->isReachable())
+        {
+            LBWARN << "Can't connect node " << netNodeID
+                   << " to send output frame" << std::endl;
+            continue;
+        }
+        receiver.connection = receiver.node->getConnection();
+
+        auto selector = _impl->compressorSelectors.find(netNodeID);
+        if (selector == _impl->compressorSelectors.end())
+            selector = _impl->compressorSelectors
+                           .emplace(netNodeID,
+                                    detail::CompressorSelector(
+                                        receiver.connection->getDescription()
+                                            ->bandwidth))
+                           .first;
+        receiver.selector = &selector->second;
+        receiver.ring = getNode()->getSendRing(receiver.node);
+        receivers.push_back(receiver);
+        receiverIDs.push_back(receiver.nodeID);
     }
 
-    co::LocalNodePtr localNode = getLocalNode();
-    co::NodePtr toNode = localNode->connect(netNodeID);
-    if (!toNode || !toNode->isReachable())
+    if (receivers.empty())
+        return 0;
+
+    // receivers on the same host map the uncompressed pixels
+    int64_t bandwidth = std::numeric_limits<int64_t>::max();
+    Receiver* slowest = 0;
+    for (Receiver& receiver : receivers)
     {
-        LBWARN << "Can't connect node " << netNodeID << " to send output frame"
-               << std::endl;
-        return;
-    }
+        if (receiver.ring)
+            continue;
 
-    co::ConnectionPtr connection = toNode->getConnection();
-    co::ConstConnectionDescriptionPtr description =
-        connection->getDescription();
+        bandwidth = std::min(bandwidth,
+                             receiver.connection->getDescription()->bandwidth);
+        if (!slowest || receiver.selector->getBandwidth() <
+                            slowest->selector->getBandwidth())
+        {
+            slowest = &receiver;
+        }
+    }
 
-    // use compression on links up to 2 GBit/s
-    const bool useCompression = (description->bandwidth <= 262144);
+    // use compression on links up to 2 GBit/s, unless selected per link
+    const bool useCompression = slowest && (bandwidth <= 262144);
+    detail::CompressorSelector& selector =
+        *(slowest ? slowest : &receivers.front())->selector;
 
-    std::vector<const PixelData*> pixelDatas;
-    std::vector<float> qualities;
+    // keep the last image sent to the destinations for delta encoding
+    const uint32_t deltaInterval = frameData->getDeltaInterval();
 
-    Frame::Buffer commandBuffers = Frame::Buffer::none;
+    // Prepare image pixel data of all images
+    const Images& images = frameData->getImages();
+    std::vector<ImageTransmission> imageTransmissions;
     uint64_t imageDataSize = 0;
+    for (const uint64_t imageIndex : imageIndices)
     {
+        LBASSERT(images.size() > imageIndex);
+        Image* image = images[imageIndex];
+        if (image->getStorageType() == Frame::TYPE_TEXTURE)
+        {
+            LBWARN << "Can't transmit image of type TEXTURE" << std::endl;
+            LBUNIMPLEMENTED;
+            continue;
+        }
+
+        const Frame::Buffer buffers[] = {Frame::Buffer::color,
+                                         Frame::Buffer::depth};
+        uint32_t compressors[] = {EQ_COMPRESSOR_NONE, EQ_COMPRESSOR_NONE};
+        bool compress = false;
+        for (unsigned j = 0; j < 2; ++j)
+        {
+            const Frame::Buffer buffer = buffers[j];
+            if (!image->hasPixelData(buffer))
+                continue;
+
+            const PixelData& data = image->getPixelData(buffer);
+            if (data.compressorName == EQ_COMPRESSOR_AUTO && slowest)
+            {
+                const uint32_t compressed = data.compressedData.isCompressed()
+                                                ? data.compressedData.compressor
+                                                : EQ_COMPRESSOR_NONE;
+                compressors[j] = selector.choose(
+                    detail::CompressorSelector::findCandidates(*image, buffer),
+                    image->getPixelDataSize(buffer), compressed);
+            }
+            else if (useCompression)
+                compressors[j] = data.compressorName;
+            compress = compress || compressors[j] != EQ_COMPRESSOR_NONE;
+        }
+
+        const uint32_t deltaSlot =
+            deltaInterval > 0 && slowest ? uint32_t(imageIndex) + 1 : 0;
+        ImageTransmission imageTransmission;
+        imageTransmission.image = image;
+        imageTransmission.buffers = Frame::Buffer::none;
+
         uint64_t rawSize(0);
+        uint64_t imageSize(0);
         ChannelStatistics compressEvent(Statistic::CHANNEL_FRAME_COMPRESS, this,
-                                        frameNumber,
-                                        useCompression ? AUTO : OFF);
+                                        frameNumber, compress ? AUTO : OFF);
         compressEvent.statistic.task = taskID;
         compressEvent.statistic.ratio = 1.0f;
         compressEvent.statistic.plugins[0] = EQ_COMPRESSOR_NONE;
         compressEvent.statistic.plugins[1] = EQ_COMPRESSOR_NONE;
 
-        // Prepare image pixel data
-        Frame::Buffer buffers[] = {Frame::Buffer::color, Frame::Buffer::depth};
-
         // for each image attachment
         for (unsigned j = 0; j < 2; ++j)
         {
-            Frame::Buffer buffer = buffers[j];
-            if (image->hasPixelData(buffer))
-            {
-                // format, type, nChunks, compressor name
-                imageDataSize += sizeof(FrameData::ImageHeader);
-
-                const PixelData& data = useCompression
-                                            ? image->compressPixelData(buffer)
-                                            : image->getPixelData(buffer);
-                pixelDatas.push_back(&data);
-                qualities.push_back(image->getQuality(buffer));
+            const Frame::Buffer buffer = buffers[j];
+            if (!image->hasPixelData(buffer))
+                continue;
 
-                if (data.compressedData.isCompressed())
-                {
-                    imageDataSize +=
-                        data.compressedData.getSize() +
-                        data.compressedData.chunks.size() * sizeof(uint64_t);
-                    compressEvent.statistic.plugins[j] =
-                        data.compressedData.compressor;
-                }
-                else
-                    imageDataSize +=
-                        sizeof(uint64_t) + image->getPixelDataSize(buffer);
-
-                commandBuffers |= buffer;
-                rawSize += image->getPixelDataSize(buffer);
+            detail::DeltaImage* delta = 0;
+            uint32_t deltaSequence = 0;
+            if (deltaSlot > 0)
+            {
+                delta =
+                    &frameData->getDeltaImage(receiverIDs, deltaSlot, buffer);
+                const bool isDelta =
+                    delta->encode(image->getPixelData(buffer), deltaInterval);
+                deltaSequence = delta->getSequence();
+                if (!isDelta)
+                    delta = 0; // keyframe
             }
+
+            Transmission transmission;
+            transmission.quality = image->getQuality(buffer);
+            transmission.deltaSlot = deltaSlot;
+            transmission.deltaSequence = deltaSequence;
+            transmission.delta = delta;
+            transmission.pixels = &image->getPixelData(buffer);
+            transmission.region.size = 0;
+            if (!delta)
+                transmission.data = &_compressPixelData(*image, buffer,
+                                                        compressors[j],
+                                                        selector);
+            else if (delta->getNumChanged() > 0)
+                transmission.data =
+                    &_compressDelta(*delta, compressors[j], selector);
+            else
+                transmission.data = 0;
+            imageTransmission.transmissions.push_back(transmission);
+
+            const PixelData* data = transmission.data;
+            if (data && data->compressedData.isCompressed())
+                compressEvent.statistic.plugins[j] =
+                    data->compressedData.compressor;
+            imageSize += transmission.getSendSize();
+
+            imageTransmission.buffers |= buffer;
+            rawSize += image->getPixelDataSize(buffer);
         }
 
         if (rawSize > 0)
-            compressEvent.statistic.ratio =
-                float(imageDataSize) / float(rawSize);
-    }
-
-    if (pixelDatas.empty())
-        return;
-
-    // send image pixel data command
-    co::LocalNode::SendToken token;
-    if (getIAttribute(IATTR_HINT_SENDTOKEN) == ON)
-    {
-        ChannelStatistics waitEvent(Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN,
-                                    this, frameNumber);
-        waitEvent.statistic.task = taskID;
-        token = getLocalNode()->acquireSendToken(toNode);
+            compressEvent.statistic.ratio = float(imageSize) / float(rawSize);
+        if (!imageTransmission.transmissions.empty())
+        {
+            imageTransmissions.push_back(imageTransmission);
+            imageDataSize += imageSize;
+        }
     }
-    LBASSERT(image->getPixelViewport().isValid());
 
-    co::ObjectOCommand command(co::Connections(1, connection),
-                               fabric::CMD_NODE_FRAMEDATA_TRANSMIT,
-                               co::COMMANDTYPE_OBJECT, nodeID, CO_INSTANCE_ALL);
-    command << frameDataVersion << image->getPixelViewport() << image->getZoom()
-            << image->getContext() << commandBuffers << frameNumber
-            << image->getAlphaUsage();
-    command.sendHeader(imageDataSize);
+    if (imageTransmissions.empty())
+        return 0;
 
-#ifndef NDEBUG
-    size_t sentBytes = 0;
-#endif
-
-    for (uint32_t j = 0; j < pixelDatas.size(); ++j)
+    // send image pixel data command to each receiver
+    uint64_t size = 0;
+    for (const Receiver& receiver : receivers)
     {
-#ifndef NDEBUG
-        sentBytes += sizeof(FrameData::ImageHeader);
-#endif
-        const PixelData* data = pixelDatas[j];
-        const bool isCompressed = data->compressedData.isCompressed();
-        const uint32_t nChunks =
-            isCompressed ? uint32_t(data->compressedData.chunks.size()) : 1;
-
-        const FrameData::ImageHeader header = {
-            data->internalFormat,
-            data->externalFormat,
-            data->pixelSize,
-            data->pvp,
-            isCompressed ? data->compressedData.compressor : EQ_COMPRESSOR_NONE,
-            data->compressorFlags,
-            nChunks,
-            qualities[j]};
-
-        connection->send(&header, sizeof(header), true);
-
-        if (isCompressed)
+        co::LocalNode::SendToken token;
+        if (getIAttribute(IATTR_HINT_SENDTOKEN) == ON)
         {
-            for (const auto& chunk : data->compressedData.chunks)
-            {
-                const uint64_t dataSize = chunk.getNumBytes();
+            ChannelStatistics waitEvent(Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN,
+                                        this, frameNumber);
+            waitEvent.statistic.task = taskID;
+            token = localNode->acquireSendToken(receiver.node);
+        }
 
-                connection->send(&dataSize, sizeof(dataSize), true);
-                if (dataSize > 0)
-                    connection->send(chunk.data, dataSize, true);
-#ifndef NDEBUG
-                sentBytes += sizeof(dataSize) + dataSize;
-#endif
-            }
+        std::vector<ImageTransmission> shared;
+        uint64_t dataSize = imageDataSize;
+        if (receiver.ring)
+        {
+            shared = imageTransmissions;
+            dataSize = 0;
+            for (ImageTransmission& imageTransmission : shared)
+                for (Transmission& transmission :
+                     imageTransmission.transmissions)
+                {
+                    transmission = _share(transmission, *receiver.ring);
+                    dataSize += transmission.getSendSize();
+                }
         }
-        else
+        const std::vector<ImageTransmission>& transmissions =
+            receiver.ring ? shared : imageTransmissions;
+
+        co::ObjectOCommand command(co::Connections(1, receiver.connection),
+                                   fabric::CMD_NODE_FRAMEDATA_TRANSMIT,
+                                   co::COMMANDTYPE_OBJECT, receiver.nodeID,
+                                   CO_INSTANCE_ALL);
+        command << frameDataVersion << getNode()->getID() << frameNumber
+                << uint32_t(imageTransmissions.size());
+        for (const ImageTransmission& imageTransmission : imageTransmissions)
         {
-            const uint64_t dataSize = data->pvp.getArea() * data->pixelSize;
-            connection->send(&dataSize, sizeof(dataSize), true);
-            connection->send(data->pixels, dataSize, true);
-#ifndef NDEBUG
-            sentBytes += sizeof(dataSize) + dataSize;
-#endif
+            const Image* image = imageTransmission.image;
+            LBASSERT(image->getPixelViewport().isValid());
+            command << image->getPixelViewport() << image->getZoom()
+                    << image->getContext() << imageTransmission.buffers
+                    << image->getAlphaUsage();
         }
+        command.sendHeader(dataSize);
+
+        uint64_t sentBytes = 0;
+        lunchbox::Clock clock;
+        for (const ImageTransmission& imageTransmission : transmissions)
+            for (const Transmission& transmission :
+                 imageTransmission.transmissions)
+            {
+                sentBytes += _send(*receiver.connection, transmission);
+            }
+
+        if (!receiver.ring)
+            receiver.selector->addTransmission(sentBytes, clock.getTimef());
+        LBASSERTINFO(sentBytes == dataSize, sentBytes << " != " << dataSize);
+        size += sentBytes;
     }
-#ifndef NDEBUG
-    LBASSERTINFO(sentBytes == imageDataSize, sentBytes << " != "
-                                                       << imageDataSize);
-#endif
+    return size;
 }
 
 void Channel::_setReady(const bool async, detail::RBStat* stat,
@@ -1837,23 +2184,9 @@ bool Channel::_cmdFrameSetReady(co::ICommand& cmd)
     return true;
 }
 
-bool Channel::_cmdFrameTransmitImage(co::ICommand& cmd)
+bool Channel::_cmdFrameTransmitImage(co::ICommand&)
 {
-    co::ObjectICommand command(cmd);
-    const co::ObjectVersion& frameData = command.read<co::ObjectVersion>();
-    const uint128_t& nodeID = command.read<uint128_t>();
-    const co::NodeID& netNodeID = command.read<co::NodeID>();
-    const uint64_t imageIndex = command.read<uint64_t>();
-    const uint32_t frameNumber = command.read<uint32_t>();
-    const uint32_t taskID = command.read<uint32_t>();
-
-    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit " << command << " frame data "
-                                    << frameData << " receiver " << nodeID
-                                    << " on " << netNodeID << std::endl;
-
-    _transmitImage(frameData, nodeID, netNodeID, imageIndex, frameNumber,
-                   taskID);
-    _unrefFrame(frameNumber);
+    getNode()->getTransmitScheduler().runNext();
     return true;
 }
 
@@ -1868,6 +2201,9 @@ bool Channel::_cmdFrameSetReadyNode(co::ICommand& cmd)
     const co::NodeIDs& netNodes = command.read<co::NodeIDs>();
     const uint32_t frameNumber = command.read<uint32_t>();
 
+    // images still queued have to arrive before the ready signal
+    getNode()->getTransmitScheduler().run(frameDataVersion);
+
     co::LocalNodePtr localNode = getLocalNode();
     const FrameDataPtr frameData = getNode()->getFrameData(frameDataVersion);
 
@@ -640,11 +640,20 @@ private:
     /** Check for and send frame finish reply. */
     void _unrefFrame(const uint32_t frameNumber);
 
-    /** Transmit one image of a frame to one node. */
-    void _transmitImage(const co::ObjectVersion& frameDataVersion,
-                        const uint128_t& nodeID, const co::NodeID& netNodeID,
-                        const uint64_t imageIndex, const uint32_t frameNumber,
-                        const uint32_t taskID);
+    /** Transmit the queued images of a frame. @return the bytes sent */
+    uint64_t _transmitPending(const co::ObjectVersion& frameDataVersion,
+                              const std::vector<uint128_t>& nodes,
+                              const co::NodeIDs& netNodes,
+                              const uint32_t frameNumber,
+                              const uint32_t taskID);
+
+    /** Transmit images of a frame to all its input nodes. @return the bytes
+        sent */
+    uint64_t _transmitImages(const co::ObjectVersion& frameDataVersion,
+                             const std::vector<uint128_t>& nodes,
+                             const co::NodeIDs& netNodes,
+                             const std::vector<uint64_t>& imageIndices,
+                             const uint32_t frameNumber, const uint32_t taskID);
 
     void _frameReadback(const uint128_t& frameID,
                         const co::ObjectVersions& frames);
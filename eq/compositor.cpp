@@ -35,11 +35,15 @@
 #include "window.h"
 #include "windowSystem.h"
 
+#include "detail/compositorKernels.h"
+
 #include <eq/util/accum.h>
 #include <eq/util/objectManager.h>
 #include <eq/util/shader.h>
+#include <eq/util/threadPool.h>
 
 #include <co/global.h>
+#include <lunchbox/atomic.h>
 #include <lunchbox/debug.h>
 #include <lunchbox/monitor.h>
 #include <lunchbox/os.h>
@@ -62,6 +66,32 @@ static const char* depthDBKey = shaderDBKey + 2;
 // Image used for CPU-based assembly
 static lunchbox::PerThread<Image> _resultImage;
 
+/** The source columns sampled by the destination columns of a zoomed image. */
+struct ZoomColumns
+{
+    ZoomColumns()
+        : x(0)
+        , linear(false)
+    {
+    }
+
+    int32_t x;   //!< first destination column covered by the tables
+    bool linear; //!< bilinear color filtering
+    std::vector<int32_t> nearest;
+    std::vector<int32_t> x0;
+    std::vector<int32_t> x1;
+    std::vector<float> weight;
+};
+typedef std::vector<ZoomColumns> ZoomColumnsVector;
+
+/** Temporary rows for resampling zoomed images, one set per thread. */
+struct ZoomRows
+{
+    std::vector<uint8_t> color;
+    std::vector<uint32_t> depth;
+};
+static lunchbox::PerThread<ZoomRows> _zoomRows;
+
 struct CPUAssemblyFormat
 {
     CPUAssemblyFormat(const bool blend_)
@@ -80,6 +110,27 @@ struct CPUAssemblyFormat
     const bool blend;
 };
 
+/** @return true if the format has an alpha channel usable for blending. */
+bool _isRGBA(const uint32_t externalFormat)
+{
+    switch (externalFormat)
+    {
+    case EQ_COMPRESSOR_DATATYPE_RGBA:
+    case EQ_COMPRESSOR_DATATYPE_BGRA:
+    case EQ_COMPRESSOR_DATATYPE_RGBA_UINT_8_8_8_8_REV:
+    case EQ_COMPRESSOR_DATATYPE_BGRA_UINT_8_8_8_8_REV:
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
 {
     const bool hasColor = image->hasPixelData(Frame::Buffer::color);
@@ -106,15 +157,26 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
 
     switch (format.colorExt)
     {
+    case EQ_COMPRESSOR_DATATYPE_RGBA:
+    case EQ_COMPRESSOR_DATATYPE_BGRA:
+    case EQ_COMPRESSOR_DATATYPE_RGBA_UINT_8_8_8_8_REV:
+    case EQ_COMPRESSOR_DATATYPE_BGRA_UINT_8_8_8_8_REV:
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
     case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-        if (!hasDepth)
-            // blending of RGB10A2 not implemented
-            return false;
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
         break;
 
-    case EQ_COMPRESSOR_DATATYPE_RGBA:
-    case EQ_COMPRESSOR_DATATYPE_BGRA:
+    case EQ_COMPRESSOR_DATATYPE_RGB:
+    case EQ_COMPRESSOR_DATATYPE_BGR:
+    case EQ_COMPRESSOR_DATATYPE_RGB16F:
+    case EQ_COMPRESSOR_DATATYPE_BGR16F:
+    case EQ_COMPRESSOR_DATATYPE_RGB32F:
+    case EQ_COMPRESSOR_DATATYPE_BGR32F:
+        if (!hasDepth) // no alpha to blend
+            return false;
         break;
 
     default:
@@ -138,40 +200,42 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     return format.depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
 }
 
-bool _useCPUAssembly(const Frames& frames, Channel* channel,
-                     const bool blend = false)
+bool _useCPUAssembly(const Frames& frames)
 {
     // It doesn't make sense to use CPU-assembly for only one frame
     if (frames.size() < 2)
         return false;
 
-    // Test that the input frames have color and depth buffers or that
-    // alpha-blended assembly is used with multiple RGBA buffers. We assume then
+    // Test that the input frames have color and depth buffers. We assume then
     // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly. Also test early
-    // for unsupported decomposition modes
+    // to do a CPU-based assembly. Also test early for unsupported
+    // decomposition modes
     const Frame::Buffer desiredBuffers =
-        blend ? Frame::Buffer::color
-              : Frame::Buffer::color | Frame::Buffer::depth;
+        Frame::Buffer::color | Frame::Buffer::depth;
     for (const Frame* frame : frames)
     {
-        const RenderContext& context = frame->getFrameData()->getContext();
+        const ConstFrameDataPtr frameData = frame->getFrameData();
 
+        // Zoomed pixel decompositions are not supported by CPU compositor
         if (frame->getBuffers() != desiredBuffers ||
-            context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            frame->getFrameData()->getZoom() != Zoom::NONE ||
-            frame->getZoom() != Zoom::NONE) // Not supported by CPU compositor
+            (frameData->getContext().pixel != Pixel::ALL &&
+             (frame->getZoom() != Zoom::NONE ||
+              frameData->getZoom() != Zoom::NONE)))
         {
             return false;
         }
     }
+    return true;
+}
 
+bool _useCPUAssembly(const Frames& frames, Channel* channel)
+{
     // Wait for all images to be ready and test if our assumption was correct,
     // that there are enough images to make a CPU-based assembly worthwhile and
     // all other preconditions for our CPU-based assembly code are true.
     size_t nImages = 0;
     const uint32_t timeout = channel->getConfig()->getTimeout();
-    CPUAssemblyFormat format(blend);
+    CPUAssemblyFormat format(false);
 
     for (const Frame* frame : frames)
     {
@@ -189,6 +253,13 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
             ++nImages;
         }
     }
+
+    // subpixel images are averaged per color channel
+    if (Compositor::isSubPixelDecomposition(frames) &&
+        !_isRGBA(format.colorExt))
+    {
+        return false;
+    }
     return (nImages > 1);
 }
 
@@ -203,6 +274,10 @@ bool _useCPUAssembly(const ImageOps& ops, const bool blend)
             return false;
         ++nImages;
     }
+
+    // subpixel images are averaged per color channel
+    if (Compositor::isSubPixelDecomposition(ops) && !_isRGBA(format.colorExt))
+        return false;
     return (nImages > 1);
 }
 
@@ -240,6 +315,26 @@ void _collectOutputData(const PixelData& pixelData, uint32_t& internalFormat,
     externalFormat = pixelData.externalFormat;
 }
 
+/**
+ * @return the area covered by the image in the destination, interleaved with
+ *         the other images of a pixel decomposition or zoomed.
+ */
+PixelViewport _getDestPVP(const ImageOp& op)
+{
+    PixelViewport pvp = op.image->getPixelViewport();
+    const Pixel& pixel = op.image->getContext().pixel;
+    if (pixel == Pixel::ALL)
+        pvp.apply(op.zoom);
+    else
+    {
+        pvp.x *= int32_t(pixel.w);
+        pvp.y *= int32_t(pixel.h);
+        pvp.w *= int32_t(pixel.w);
+        pvp.h *= int32_t(pixel.h);
+    }
+    return pvp + op.offset;
+}
+
 bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
                         uint32_t& colorInt, uint32_t& colorPixelSize,
                         uint32_t& colorExt, uint32_t& depthInt,
@@ -248,8 +343,8 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
     for (const ImageOp& op : ops)
     {
         const RenderContext& context = op.image->getContext();
-        if (context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            op.zoom != Zoom::NONE ||
+        if (!op.zoom.isValid() ||
+            (context.pixel != Pixel::ALL && op.zoom != Zoom::NONE) ||
             op.image->getStorageType() != Frame::TYPE_MEMORY)
         {
             return false;
@@ -258,7 +353,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        destPVP.merge(op.image->getPixelViewport() + op.offset);
+        destPVP.merge(_getDestPVP(op));
 
         _collectOutputData(op.image->getPixelData(Frame::Buffer::color),
                            colorInt, colorPixelSize, colorExt);
@@ -269,106 +364,156 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
                                depthInt, depthPixelSize, depthExt);
         }
     }
+    return true;
+}
+
+typedef detail::compositor::SIMD SIMD;
 
-    if (!destPVP.hasArea())
-        LBWARN << "Nothing to assemble: " << destPVP << std::endl;
-    return destPVP.hasArea();
+// Destination tile size of the single-pass CPU merge. All images are merged
+// tile by tile, keeping the destination color and depth (128 KB) of one tile
+// in the cache while it is visited by all input images.
+const int32_t _tileWidth = 512;
+const int32_t _tileHeight = 32;
+
+/** @return the number of rows of the given width processed by one task. */
+int64_t _getRowGrain(const int32_t width)
+{
+    return LB_MAX(int64_t(1), int64_t(_tileWidth * _tileHeight) /
+                                  LB_MAX(int64_t(width), int64_t(1)));
+}
+
+/** @return the origin of the image relative to the destination image. */
+Vector2i _getDestPosition(const Image* image, const Vector2i& offset,
+                          const PixelViewport& destPVP)
+{
+    const PixelViewport& pvp = image->getPixelViewport();
+    return Vector2i(offset.x() + pvp.x - destPVP.x,
+                    offset.y() + pvp.y - destPVP.y);
+}
+
+/** @return the part of the region covered by the image. */
+PixelViewport _getArea(const Image* image, const Vector2i& destPos,
+                       const PixelViewport& region)
+{
+    const PixelViewport& pvp = image->getPixelViewport();
+    PixelViewport area(destPos.x(), destPos.y(), pvp.w, pvp.h);
+    area.intersect(region);
+    return area;
 }
 
 void _mergeDBImage(void* destColor, void* destDepth,
                    const PixelViewport& destPVP, const Image* image,
-                   const Vector2i& offset)
+                   const Vector2i& offset, const PixelViewport& region,
+                   const SIMD simd)
 {
     LBASSERT(destColor && destDepth);
 
-    LBVERB << "CPU-DB assembly" << std::endl;
+    const Vector2i& destPos = _getDestPosition(image, offset, destPVP);
+    const PixelViewport& area = _getArea(image, destPos, region);
+    if (!area.hasArea())
+        return;
 
-    uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
+    uint8_t* destC = reinterpret_cast<uint8_t*>(destColor);
     uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
-
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
-
-    const uint32_t* color = reinterpret_cast<const uint32_t*>(
-        image->getPixelPointer(Frame::Buffer::color));
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
     const uint32_t* depth = reinterpret_cast<const uint32_t*>(
         image->getPixelPointer(Frame::Buffer::depth));
+    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
+    const detail::compositor::MergeDBRow mergeRow =
+        detail::compositor::getMergeDBRow(pixelSize, simd);
+    LBASSERTINFO(mergeRow, "Unsupported color pixel size " << pixelSize);
 
-#pragma omp parallel for
-    for (int32_t y = 0; y < pvp.h; ++y)
+    // background pixels never win the depth test, only merge the row spans
+    const std::vector<Vector2i>& spans = image->getDepthSpans();
+    for (int32_t y = area.y; y < area.getYEnd(); ++y)
     {
-        const uint32_t skip = (destY + y) * destPVP.w + destX;
-        uint32_t* destColorIt = destC + skip;
-        uint32_t* destDepthIt = destD + skip;
-        const uint32_t* colorIt = color + y * pvp.w;
-        const uint32_t* depthIt = depth + y * pvp.w;
-
-        for (int32_t x = 0; x < pvp.w; ++x)
+        const int32_t srcY = y - destPos.y();
+        int32_t begin = area.x - destPos.x();
+        int32_t end = begin + area.w;
+        if (!spans.empty())
         {
-            if (*destDepthIt > *depthIt)
-            {
-                *destColorIt = *colorIt;
-                *destDepthIt = *depthIt;
-            }
-
-            ++destColorIt;
-            ++destDepthIt;
-            ++colorIt;
-            ++depthIt;
+            begin = LB_MAX(begin, spans[srcY].x());
+            end = LB_MIN(end, spans[srcY].y());
+            if (begin >= end)
+                continue;
         }
+
+        const size_t skip = size_t(y) * destPVP.w + begin + destPos.x();
+        const size_t srcSkip = size_t(srcY) * pvp.w + begin;
+        mergeRow(destC + skip * pixelSize, destD + skip,
+                 color + srcSkip * pixelSize, depth + srcSkip, end - begin);
     }
 }
 
 void _merge2DImage(void* destColor, void* destDepth,
                    const eq::PixelViewport& destPVP, const Image* image,
-                   const Vector2i& offset)
+                   const Vector2i& offset, const PixelViewport& region)
 {
-    // This is mostly copy&paste code from _mergeDBImage :-/
-    LBVERB << "CPU-2D assembly" << std::endl;
+    LBASSERT(image->hasPixelData(Frame::Buffer::color));
+
+    const Vector2i& destPos = _getDestPosition(image, offset, destPVP);
+    const PixelViewport& area = _getArea(image, destPos, region);
+    if (!area.hasArea())
+        return;
 
     uint8_t* destC = reinterpret_cast<uint8_t*>(destColor);
-    uint8_t* destD = reinterpret_cast<uint8_t*>(destDepth);
+    uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
-
-    LBASSERT(image->hasPixelData(Frame::Buffer::color));
-
     const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
     const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
-    const size_t rowLength = pvp.w * pixelSize;
+    const size_t rowLength = area.w * pixelSize;
 
-#pragma omp parallel for
-    for (int32_t y = 0; y < pvp.h; ++y)
+    for (int32_t y = area.y; y < area.getYEnd(); ++y)
     {
-        const size_t skip = ((destY + y) * destPVP.w + destX) * pixelSize;
-        memcpy(destC + skip, color + y * pvp.w * pixelSize, rowLength);
+        const size_t skip = size_t(y) * destPVP.w + area.x;
+        const size_t srcSkip =
+            size_t(y - destPos.y()) * pvp.w + area.x - destPos.x();
+        memcpy(destC + skip * pixelSize, color + srcSkip * pixelSize,
+               rowLength);
         // clear depth, for depth-assembly into existing FB
         if (destD)
-            lunchbox::setZero(destD + skip, rowLength);
+            lunchbox::setZero(destD + skip, area.w * sizeof(uint32_t));
     }
 }
 
-void _blendImage(void* dest, const eq::PixelViewport& destPVP,
-                 const Image* image, const Vector2i& offset)
+detail::compositor::ColorFormat _getColorFormat(const uint32_t externalFormat)
 {
-    LBVERB << "CPU-Blend assembly" << std::endl;
-
-    int32_t* destColor = reinterpret_cast<int32_t*>(dest);
-
-    const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    switch (externalFormat)
+    {
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+        return detail::compositor::COLOR_RGB10A2;
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+        return detail::compositor::COLOR_RGBA16F;
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+        return detail::compositor::COLOR_RGBA32F;
+    default:
+        return detail::compositor::COLOR_RGBA8;
+    }
+}
 
-    LBASSERT(image->getPixelSize(Frame::Buffer::color) == 4);
+void _blendImage(void* dest, const eq::PixelViewport& destPVP,
+                 const Image* image, const Vector2i& offset,
+                 const PixelViewport& region, const SIMD simd)
+{
     LBASSERT(image->hasPixelData(Frame::Buffer::color));
     LBASSERT(image->hasAlpha());
 
-    const int32_t* color = reinterpret_cast<const int32_t*>(
-        image->getPixelPointer(Frame::Buffer::color));
+    const Vector2i& destPos = _getDestPosition(image, offset, destPVP);
+    const PixelViewport& area = _getArea(image, destPos, region);
+    if (!area.hasArea())
+        return;
+
+    uint8_t* destColor = reinterpret_cast<uint8_t*>(dest);
+
+    const PixelViewport& pvp = image->getPixelViewport();
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
 
     // Blending of two slices, none of which is on final image (i.e. result
     // could be blended on to something else) should be performed with:
@@ -378,48 +523,686 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
     // dstAlpha = 0*srcAlpha + srcAlpha*dstAlpha
     // because we accumulate light which is go through (= 1-Alpha) and we
     // already have colors as Alpha*Color
+    const detail::compositor::BlendRow blendRow =
+        detail::compositor::getBlendRow(
+            _getColorFormat(image->getExternalFormat(Frame::Buffer::color)),
+            simd);
+
+    for (int32_t y = area.y; y < area.getYEnd(); ++y)
+    {
+        const size_t skip = size_t(y) * destPVP.w + area.x;
+        const size_t srcSkip =
+            size_t(y - destPos.y()) * pvp.w + area.x - destPos.x();
+        blendRow(destColor + skip * pixelSize, color + srcSkip * pixelSize,
+                 area.w);
+    }
+}
 
-    int32_t* destColorStart = destColor + destY * destPVP.w + destX;
-    const uint32_t step = sizeof(int32_t);
+/**
+ * Compute the source sample for a destination pixel of a zoomed image.
+ *
+ * Pixel centers are mapped onto each other like texture sampling with
+ * GL_CLAMP_TO_EDGE does, using integer arithmetic to get exact results at
+ * sample boundaries. The nearest filter only sets index0.
+ */
+void _sample(const int32_t position, const int32_t size,
+             const int32_t zoomedSize, const bool linear, int32_t& index0,
+             int32_t& index1, float& weight)
+{
+    const int64_t denominator = 2 * int64_t(zoomedSize);
+    const int64_t center = (2 * int64_t(position) + 1) * size;
+    weight = 0.f;
+
+    if (!linear)
+    {
+        index0 = LB_MIN(int32_t(center / denominator), size - 1);
+        index1 = index0;
+        return;
+    }
+
+    const int64_t source = LB_MAX(center - zoomedSize, int64_t(0));
+    index0 = LB_MIN(int32_t(source / denominator), size - 1);
+    index1 = LB_MIN(index0 + 1, size - 1);
+    if (index1 != index0)
+        weight = float(source - index0 * denominator) / float(denominator);
+}
+
+/** @return the destination area of a zoomed image relative to destPVP. */
+PixelViewport _getZoomedPVP(const ImageOp& op, const PixelViewport& destPVP)
+{
+    PixelViewport zoomed = _getDestPVP(op);
+    zoomed.x -= destPVP.x;
+    zoomed.y -= destPVP.y;
+    return zoomed;
+}
+
+/**
+ * Compute the source columns of a zoomed image for all destination columns.
+ *
+ * The tables are computed once per image and merge, and shared by all tiles
+ * or row ranges merging the image.
+ */
+void _computeZoomColumns(const ImageOp& op, const PixelViewport& destPVP,
+                         ZoomColumns& columns)
+{
+    const Image* image = op.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const PixelViewport& zoomed = _getZoomedPVP(op, destPVP);
+    const int32_t begin = LB_MAX(zoomed.x, 0);
+    const int32_t end = LB_MIN(zoomed.getXEnd(), destPVP.w);
+    const uint32_t format = image->getExternalFormat(Frame::Buffer::color);
+
+    columns.x = begin;
+    columns.linear = op.zoomFilter == FILTER_LINEAR && _isRGBA(format);
+    if (end <= begin || !pvp.hasArea())
+        return;
+
+    const size_t width = end - begin;
+    columns.nearest.resize(width);
+    columns.x0.resize(width);
+    columns.x1.resize(width);
+    columns.weight.resize(width);
+    for (size_t i = 0; i < width; ++i)
+    {
+        const int32_t x = begin - zoomed.x + int32_t(i);
+        int32_t unused;
+        float unusedWeight;
+        _sample(x, pvp.w, zoomed.w, false, columns.nearest[i], unused,
+                unusedWeight);
+        _sample(x, pvp.w, zoomed.w, columns.linear, columns.x0[i],
+                columns.x1[i], columns.weight[i]);
+    }
+}
+
+/**
+ * Merge an image zoomed to the destination resolution.
+ *
+ * The image covers its zoomed pixel viewport in the destination. Each
+ * destination row is resampled into a temporary row, which is then merged
+ * using the same row kernels as unzoomed images. Depth is always sampled with
+ * the nearest filter, since interpolated depth values do not exist in the
+ * scene.
+ */
+void _mergeZoomedImage(const ImageOp& op, const bool blend, void* colorBuffer,
+                       void* depthBuffer, const PixelViewport& destPVP,
+                       const PixelViewport& region, const SIMD simd,
+                       const ZoomColumns& columns)
+{
+    const Image* image = op.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const PixelViewport& zoomed = _getZoomedPVP(op, destPVP);
+
+    PixelViewport area = zoomed;
+    area.intersect(region);
+    if (!area.hasArea() || !pvp.hasArea())
+        return;
+
+    const bool hasDepth = image->hasPixelData(Frame::Buffer::depth);
+    const uint32_t format = image->getExternalFormat(Frame::Buffer::color);
+    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
+    const bool linear = columns.linear;
+    LBASSERT(area.x >= columns.x);
+    LBASSERT(size_t(area.getXEnd() - columns.x) <= columns.nearest.size());
+
+    const size_t column = area.x - columns.x;
+    const int32_t* xNearest = &columns.nearest[column];
+    const int32_t* x0 = &columns.x0[column];
+    const int32_t* x1 = &columns.x1[column];
+    const float* xWeight = &columns.weight[column];
+
+    namespace kernels = detail::compositor;
+    const kernels::ResampleRow resampleColor =
+        linear ? kernels::getBilinearRow(_getColorFormat(format))
+               : kernels::getNearestRow(pixelSize);
+    const kernels::ResampleRow resampleDepth =
+        kernels::getNearestRow(sizeof(uint32_t));
+    const kernels::MergeDBRow mergeRow =
+        hasDepth ? kernels::getMergeDBRow(pixelSize, simd) : 0;
+    const kernels::BlendRow blendRow =
+        !hasDepth && blend && image->hasAlpha()
+            ? kernels::getBlendRow(_getColorFormat(format), simd)
+            : 0;
+    LBASSERTINFO(resampleColor, "Unsupported color pixel size " << pixelSize);
 
-#pragma omp parallel for
-    for (int32_t y = 0; y < pvp.h; ++y)
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+    const uint32_t* depth = hasDepth
+                                ? reinterpret_cast<const uint32_t*>(
+                                      image->getPixelPointer(
+                                          Frame::Buffer::depth))
+                                : 0;
+    const size_t rowSize = pvp.w * pixelSize;
+
+    if (!_zoomRows)
+        _zoomRows = new ZoomRows;
+    std::vector<uint8_t>& colorRow = _zoomRows->color;
+    std::vector<uint32_t>& depthRow = _zoomRows->depth;
+    if (colorRow.size() < area.w * pixelSize)
+        colorRow.resize(area.w * pixelSize);
+    if (hasDepth && depthRow.size() < size_t(area.w))
+        depthRow.resize(area.w);
+
+    uint8_t* destC = reinterpret_cast<uint8_t*>(colorBuffer);
+    uint32_t* destD = reinterpret_cast<uint32_t*>(depthBuffer);
+
+    for (int32_t y = area.y; y < area.getYEnd(); ++y)
     {
-        const unsigned char* src =
-            reinterpret_cast<const uint8_t*>(color + pvp.w * y);
-        unsigned char* dst =
-            reinterpret_cast<uint8_t*>(destColorStart + destPVP.w * y);
+        int32_t y0, y1, yNearest;
+        float yWeight;
+        _sample(y - zoomed.y, pvp.h, zoomed.h, false, yNearest, y1, yWeight);
+        _sample(y - zoomed.y, pvp.h, zoomed.h, linear, y0, y1, yWeight);
+
+        const size_t skip = size_t(y) * destPVP.w + area.x;
+        if (linear)
+            resampleColor(colorRow.data(), color + y0 * rowSize,
+                          color + y1 * rowSize, yWeight, x0, x1, xWeight,
+                          area.w);
+        else
+            resampleColor(colorRow.data(), color + yNearest * rowSize, 0, 0.f,
+                          xNearest, 0, 0, area.w);
 
-        for (int32_t x = 0; x < pvp.w; ++x)
+        if (mergeRow)
+        {
+            resampleDepth(depthRow.data(), depth + yNearest * pvp.w, 0, 0.f,
+                          xNearest, 0, 0, area.w);
+            mergeRow(destC + skip * pixelSize, destD + skip, colorRow.data(),
+                     depthRow.data(), area.w);
+        }
+        else if (blendRow)
+            blendRow(destC + skip * pixelSize, colorRow.data(), area.w);
+        else
         {
-            dst[0] = LB_MIN(src[0] + (src[3] * dst[0] >> 8), 255);
-            dst[1] = LB_MIN(src[1] + (src[3] * dst[1] >> 8), 255);
-            dst[2] = LB_MIN(src[2] + (src[3] * dst[2] >> 8), 255);
-            dst[3] = src[3] * dst[3] >> 8;
+            memcpy(destC + skip * pixelSize, colorRow.data(),
+                   area.w * pixelSize);
+            // clear depth, for depth-assembly into existing FB
+            if (destD)
+                lunchbox::setZero(destD + skip, area.w * sizeof(uint32_t));
+        }
+    }
+}
+
+/** @return the quotient rounded towards positive infinity, for divisor > 0. */
+int32_t _divideUp(const int32_t dividend, const int32_t divisor)
+{
+    return dividend > 0 ? (dividend + divisor - 1) / divisor
+                        : -(-dividend / divisor);
+}
+
+/**
+ * Merge an image of a pixel decomposition.
+ *
+ * The pixels of the image are de-interleaved into every pixel.w-th column of
+ * every pixel.h-th row of the destination using strided stores. Depth and
+ * blending merges gather the destination pixels into temporary rows, merge
+ * them with the row kernels of unzoomed images and scatter them back.
+ */
+void _mergePixelImage(const ImageOp& op, const bool blend, void* colorBuffer,
+                      void* depthBuffer, const PixelViewport& destPVP,
+                      const PixelViewport& region, const SIMD simd)
+{
+    const Image* image = op.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
+
+    // destination of the first image pixel, and the range of image pixels
+    // falling into the region
+    const int32_t startX =
+        op.offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t startY =
+        op.offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
+    const int32_t beginX = LB_MAX(_divideUp(region.x - startX, stepX), 0);
+    const int32_t endX =
+        LB_MIN(_divideUp(region.getXEnd() - startX, stepX), pvp.w);
+    const int32_t beginY = LB_MAX(_divideUp(region.y - startY, stepY), 0);
+    const int32_t endY =
+        LB_MIN(_divideUp(region.getYEnd() - startY, stepY), pvp.h);
+    if (beginX >= endX || beginY >= endY)
+        return;
+
+    const bool hasDepth = image->hasPixelData(Frame::Buffer::depth);
+    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
+    const size_t nPixels = endX - beginX;
+
+    namespace kernels = detail::compositor;
+    const kernels::StridedRow scatterColor =
+        kernels::getScatterRow(pixelSize, simd);
+    const kernels::StridedRow gatherColor =
+        kernels::getGatherRow(pixelSize, simd);
+    const kernels::StridedRow scatterDepth =
+        kernels::getScatterRow(sizeof(uint32_t), simd);
+    const kernels::StridedRow gatherDepth =
+        kernels::getGatherRow(sizeof(uint32_t), simd);
+    const kernels::MergeDBRow mergeRow =
+        hasDepth ? kernels::getMergeDBRow(pixelSize, simd) : 0;
+    const kernels::BlendRow blendRow =
+        !hasDepth && blend && image->hasAlpha()
+            ? kernels::getBlendRow(
+                  _getColorFormat(
+                      image->getExternalFormat(Frame::Buffer::color)),
+                  simd)
+            : 0;
+    LBASSERTINFO(scatterColor, "Unsupported color pixel size " << pixelSize);
 
-            src += step;
-            dst += step;
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+    const uint32_t* depth = hasDepth
+                                ? reinterpret_cast<const uint32_t*>(
+                                      image->getPixelPointer(
+                                          Frame::Buffer::depth))
+                                : 0;
+    uint8_t* destC = reinterpret_cast<uint8_t*>(colorBuffer);
+    uint32_t* destD = reinterpret_cast<uint32_t*>(depthBuffer);
+    std::vector<uint8_t> colorRow(mergeRow || blendRow ? nPixels * pixelSize
+                                                       : 0);
+    std::vector<uint32_t> depthRow(mergeRow || destD ? nPixels : 0);
+
+    for (int32_t y = beginY; y < endY; ++y)
+    {
+        const size_t skip = size_t(startY + y * stepY) * destPVP.w + startX +
+                            beginX * stepX;
+        const size_t srcSkip = size_t(y) * pvp.w + beginX;
+        uint8_t* dest = destC + skip * pixelSize;
+        const uint8_t* src = color + srcSkip * pixelSize;
+
+        if (mergeRow)
+        {
+            gatherColor(colorRow.data(), dest, stepX, nPixels);
+            gatherDepth(depthRow.data(), destD + skip, stepX, nPixels);
+            mergeRow(colorRow.data(), depthRow.data(), src, depth + srcSkip,
+                     nPixels);
+            scatterColor(dest, colorRow.data(), stepX, nPixels);
+            scatterDepth(destD + skip, depthRow.data(), stepX, nPixels);
         }
+        else if (blendRow)
+        {
+            gatherColor(colorRow.data(), dest, stepX, nPixels);
+            blendRow(colorRow.data(), src, nPixels);
+            scatterColor(dest, colorRow.data(), stepX, nPixels);
+        }
+        else
+        {
+            scatterColor(dest, src, stepX, nPixels);
+            // clear depth, for depth-assembly into existing FB
+            if (destD)
+                scatterDepth(destD + skip, depthRow.data(), stepX, nPixels);
+        }
+    }
+}
+
+void _mergeImage(const ImageOp& op, const bool blend, void* colorBuffer,
+                 void* depthBuffer, const PixelViewport& destPVP,
+                 const PixelViewport& region, const SIMD simd,
+                 const ZoomColumns& columns)
+{
+    if (!op.image->hasPixelData(Frame::Buffer::color))
+        return;
+
+    if (op.image->getContext().pixel != Pixel::ALL)
+    {
+        _mergePixelImage(op, blend, colorBuffer, depthBuffer, destPVP, region,
+                         simd);
+        return;
+    }
+
+    if (op.zoom != Zoom::NONE)
+    {
+        _mergeZoomedImage(op, blend, colorBuffer, depthBuffer, destPVP,
+                          region, simd, columns);
+        return;
+    }
+
+    if (op.image->hasPixelData(Frame::Buffer::depth))
+        _mergeDBImage(colorBuffer, depthBuffer, destPVP, op.image, op.offset,
+                      region, simd);
+    else if (blend && op.image->hasAlpha())
+        _blendImage(colorBuffer, destPVP, op.image, op.offset, region, simd);
+    else
+        _merge2DImage(colorBuffer, depthBuffer, destPVP, op.image, op.offset,
+                      region);
+}
+
+/**
+ * Merge all images in a single pass over the destination.
+ *
+ * The destination is split into tiles which are processed in parallel. Each
+ * tile is reduced over all overlapping images in the given order, so the
+ * destination buffers are accessed once instead of once per input image.
+ */
+void _mergeImagesTiled(const ImageOps& ops, const bool blend,
+                       void* colorBuffer, void* depthBuffer,
+                       const PixelViewport& destPVP, const SIMD simd,
+                       const ZoomColumnsVector& columns)
+{
+    LBVERB << "Tiled CPU assembly of " << ops.size() << " images" << std::endl;
+
+    const int32_t nTilesX = (destPVP.w + _tileWidth - 1) / _tileWidth;
+    const int32_t nTilesY = (destPVP.h + _tileHeight - 1) / _tileHeight;
+    const int32_t nTiles = nTilesX * nTilesY;
+
+    util::ThreadPool::getInstance().parallelFor(
+        0, nTiles, 1, [&](const int64_t begin, const int64_t end) {
+            for (int32_t i = int32_t(begin); i < int32_t(end); ++i)
+            {
+                const int32_t x = (i % nTilesX) * _tileWidth;
+                const int32_t y = (i / nTilesX) * _tileHeight;
+                const PixelViewport tile(x, y,
+                                         LB_MIN(_tileWidth, destPVP.w - x),
+                                         LB_MIN(_tileHeight, destPVP.h - y));
+
+                for (size_t j = 0; j < ops.size(); ++j)
+                    _mergeImage(ops[j], blend, colorBuffer, depthBuffer,
+                                destPVP, tile, simd, columns[j]);
+            }
+        });
+}
+
+/** Merge the images one after another, each in a full destination pass. */
+void _mergeImagesSequential(const ImageOps& ops, const bool blend,
+                            void* colorBuffer, void* depthBuffer,
+                            const PixelViewport& destPVP, const SIMD simd,
+                            const ZoomColumnsVector& columns)
+{
+    LBVERB << "Sequential CPU assembly of " << ops.size() << " images"
+           << std::endl;
+
+    util::ThreadPool& pool = util::ThreadPool::getInstance();
+    for (size_t i = 0; i < ops.size(); ++i)
+    {
+        pool.parallelFor(
+            0, destPVP.h, _getRowGrain(destPVP.w),
+            [&](const int64_t begin, const int64_t end) {
+                const PixelViewport rows(0, int32_t(begin), destPVP.w,
+                                         int32_t(end - begin));
+                _mergeImage(ops[i], blend, colorBuffer, depthBuffer, destPVP,
+                            rows, simd, columns[i]);
+            });
     }
 }
 
+bool _readTiled()
+{
+    // EQ_COMPOSITOR_TILED=0 selects the per-image passes for benchmarking
+    const char* env = getenv("EQ_COMPOSITOR_TILED");
+    return !env || strcmp(env, "0") != 0;
+}
+
+lunchbox::a_int32_t& _getTiled()
+{
+    static lunchbox::a_int32_t tiled(_readTiled() ? 1 : 0);
+    return tiled;
+}
+
 void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
                   void* depthBuffer, const PixelViewport& destPVP)
 {
-    for (const ImageOp& op : ops)
+    const SIMD simd = detail::compositor::getSIMD();
+
+    ZoomColumnsVector columns(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i)
     {
-        if (!op.image->hasPixelData(Frame::Buffer::color))
-            continue;
+        const ImageOp& op = ops[i];
+        if (op.zoom != Zoom::NONE &&
+            op.image->getContext().pixel == Pixel::ALL &&
+            op.image->hasPixelData(Frame::Buffer::color))
+        {
+            _computeZoomColumns(op, destPVP, columns[i]);
+        }
+    }
 
-        if (op.image->hasPixelData(Frame::Buffer::depth))
-            _mergeDBImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
-        else if (blend && op.image->hasAlpha())
-            _blendImage(colorBuffer, destPVP, op.image, op.offset);
-        else
-            _merge2DImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
+    if (!_getTiled())
+        _mergeImagesSequential(ops, blend, colorBuffer, depthBuffer, destPVP,
+                               simd, columns);
+    else
+        _mergeImagesTiled(ops, blend, colorBuffer, depthBuffer, destPVP,
+                          simd, columns);
+}
+
+/**
+ * Merges images in one or more steps into the per-thread result image.
+ *
+ * The result image covers the union of the images merged so far, and grows
+ * only when the images of a step fall outside of it, keeping the pixels merged
+ * so far. Merging the frames of a depth compositing in arrival order produces
+ * the same result as a sorted merge, since the closest fragment wins.
+ */
+class IncrementalMerge
+{
+public:
+    explicit IncrementalMerge(const bool blend)
+        : _blend(blend)
+        , _result(0)
+        , _colorInt(0)
+        , _colorExt(0)
+        , _colorPixelSize(0)
+        , _depthInt(0)
+        , _depthExt(0)
+        , _depthPixelSize(0)
+    {
+    }
+
+    /**
+     * Allocate the result for the given images, without merging them.
+     *
+     * @return false if the images can't be merged into the result.
+     */
+    bool reserve(const ImageOps& ops)
+    {
+        PixelViewport pvp;
+        uint32_t colorInt = 0;
+        uint32_t colorExt = 0;
+        uint32_t colorPixelSize = 0;
+        uint32_t depthInt = 0;
+        uint32_t depthExt = 0;
+        uint32_t depthPixelSize = 0;
+
+        if (!_collectOutputData(ops, pvp, colorInt, colorPixelSize, colorExt,
+                                depthInt, depthPixelSize, depthExt))
+        {
+            return false;
+        }
+        if (!pvp.hasArea())
+            return true;
+
+        if (!_result)
+        {
+            _colorInt = colorInt;
+            _colorExt = colorExt;
+            _colorPixelSize = colorPixelSize;
+            _depthInt = depthInt;
+            _depthExt = depthExt;
+            _depthPixelSize = depthPixelSize;
+
+            if (!_resultImage)
+                _resultImage = new Image;
+            _result = _resultImage.get();
+            _allocate(pvp);
+            return true;
+        }
+
+        // the format of the result is fixed by the first step
+        if (colorInt != _colorInt || colorExt != _colorExt ||
+            (depthInt != 0 && (depthInt != _depthInt || depthExt != _depthExt)))
+        {
+            LBVERB << "Image format changed during incremental CPU assembly"
+                   << std::endl;
+            return false;
+        }
+
+        _grow(pvp);
+        return true;
+    }
+
+    /**
+     * Merge the given images into the result.
+     *
+     * @return false if the images can't be merged into the result.
+     */
+    bool merge(const ImageOps& ops)
+    {
+        if (!reserve(ops))
+            return false;
+        if (!_result)
+            return true;
+
+        void* color = _result->getPixelPointer(Frame::Buffer::color);
+        void* depth = _depthInt ? _result->getPixelPointer(Frame::Buffer::depth)
+                                : 0;
+        _mergeImages(ops, _blend, color, depth, _result->getPixelViewport());
+        return true;
+    }
+
+    /** @return the result image, or 0 if no image has been added yet. */
+    Image* getResult() { return _result; }
+
+private:
+    const bool _blend;
+    Image* _result;
+    uint32_t _colorInt;
+    uint32_t _colorExt;
+    uint32_t _colorPixelSize;
+    uint32_t _depthInt;
+    uint32_t _depthExt;
+    uint32_t _depthPixelSize;
+
+    void _allocate(const PixelViewport& pvp)
+    {
+        // pre-condition check for current _merge implementations
+        LBASSERT(_colorInt != 0);
+
+        _result->setPixelViewport(pvp);
+
+        PixelData colorPixels;
+        colorPixels.internalFormat = _colorInt;
+        colorPixels.externalFormat = _colorExt;
+        colorPixels.pixelSize = _colorPixelSize;
+        colorPixels.pvp = pvp;
+        _result->setPixelData(Frame::Buffer::color, colorPixels);
+
+        if (_depthInt == 0) // no depth assembly
+            return;
+
+        LBASSERT(_depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
+        PixelData depthPixels;
+        depthPixels.internalFormat = _depthInt;
+        depthPixels.externalFormat = _depthExt;
+        depthPixels.pixelSize = _depthPixelSize;
+        depthPixels.pvp = pvp;
+        _result->setPixelData(Frame::Buffer::depth, depthPixels);
+    }
+
+    /** Enlarge the result to include the given area, keeping its pixels. */
+    void _grow(const PixelViewport& pvp)
+    {
+        const PixelViewport oldPVP = _result->getPixelViewport();
+        PixelViewport newPVP = oldPVP;
+        newPVP.merge(pvp);
+        if (newPVP == oldPVP)
+            return;
+
+        LBVERB << "Grow CPU assembly result from " << oldPVP << " to "
+               << newPVP << std::endl;
+
+        const uint8_t* color = _result->getPixelPointer(Frame::Buffer::color);
+        const std::vector<uint8_t> oldColor(
+            color, color + _result->getPixelDataSize(Frame::Buffer::color));
+        std::vector<uint8_t> oldDepth;
+        if (_depthInt != 0)
+        {
+            const uint8_t* depth =
+                _result->getPixelPointer(Frame::Buffer::depth);
+            oldDepth.assign(depth, depth + _result->getPixelDataSize(
+                                               Frame::Buffer::depth));
+        }
+
+        _allocate(newPVP);
+
+        const int32_t x = oldPVP.x - newPVP.x;
+        const int32_t y = oldPVP.y - newPVP.y;
+        _copy(Frame::Buffer::color, oldColor, _colorPixelSize, oldPVP, x, y);
+        if (_depthInt != 0)
+            _copy(Frame::Buffer::depth, oldDepth, _depthPixelSize, oldPVP, x,
+                  y);
+    }
+
+    void _copy(const Frame::Buffer buffer, const std::vector<uint8_t>& pixels,
+               const size_t pixelSize, const PixelViewport& pvp,
+               const int32_t x, const int32_t y)
+    {
+        const PixelViewport& destPVP = _result->getPixelViewport();
+        uint8_t* dest = _result->getPixelPointer(buffer);
+        const size_t rowSize = pvp.w * pixelSize;
+
+        util::ThreadPool::getInstance().parallelFor(
+            0, pvp.h, _getRowGrain(pvp.w),
+            [&](const int64_t begin, const int64_t end) {
+                for (int32_t i = int32_t(begin); i < int32_t(end); ++i)
+                    memcpy(dest + ((y + i) * destPVP.w + x) * pixelSize,
+                           &pixels[i * rowSize], rowSize);
+            });
     }
+};
+
+/**
+ * Average the subpixel images of an FSAA decomposition.
+ *
+ * The images of each subpixel are merged into the result image, which is then
+ * added to a float accumulation buffer. The average of all subpixels is
+ * written back to the result image, like util::Accum does on the GPU. The
+ * result depth is the depth of the last merged subpixel.
+ */
+void _mergeSubPixelImages(const ImageOps& ops, const bool blend, Image* result)
+{
+    const PixelViewport& destPVP = result->getPixelViewport();
+    const size_t rowLength = destPVP.w * 4;
+    const size_t pixelSize = result->getPixelSize(Frame::Buffer::color);
+    const detail::compositor::ColorFormat format =
+        _getColorFormat(result->getExternalFormat(Frame::Buffer::color));
+    const bool hasDepth = result->hasPixelData(Frame::Buffer::depth);
+
+    const SIMD simd = detail::compositor::getSIMD();
+    const detail::compositor::AccumRow accumRow =
+        detail::compositor::getAccumRow(format, simd);
+    const detail::compositor::ReturnRow returnRow =
+        detail::compositor::getReturnRow(format, simd);
+    std::vector<float> accum(rowLength * destPVP.h, 0.f);
+    util::ThreadPool& pool = util::ThreadPool::getInstance();
+    const int64_t grain = _getRowGrain(destPVP.w);
+
+    size_t nSteps = 0;
+    ImageOps opsLeft = ops;
+    while (!opsLeft.empty())
+    {
+        const ImageOps& current = Compositor::extractOneSubPixel(opsLeft);
+        if (nSteps > 0)
+        {
+            result->clearPixelData(Frame::Buffer::color);
+            if (hasDepth)
+                result->clearPixelData(Frame::Buffer::depth);
+        }
+
+        uint8_t* color = result->getPixelPointer(Frame::Buffer::color);
+        _mergeImages(current, blend, color,
+                     hasDepth ? result->getPixelPointer(Frame::Buffer::depth)
+                              : 0,
+                     destPVP);
+        pool.parallelFor(0, destPVP.h, grain,
+                         [&](const int64_t begin, const int64_t end) {
+                             for (int64_t y = begin; y < end; ++y)
+                                 accumRow(&accum[y * rowLength],
+                                          color + y * destPVP.w * pixelSize,
+                                          destPVP.w);
+                         });
+        ++nSteps;
+    }
+
+    const float scale = 1.f / float(nSteps);
+    uint8_t* color = result->getPixelPointer(Frame::Buffer::color);
+    pool.parallelFor(0, destPVP.h, grain,
+                     [&](const int64_t begin, const int64_t end) {
+                         for (int64_t y = begin; y < end; ++y)
+                             returnRow(color + y * destPVP.w * pixelSize,
+                                       &accum[y * rowLength], scale, destPVP.w);
+                     });
 }
 
 Vector4f _getCoords(const ImageOp& op, const PixelViewport& pvp)
@@ -681,6 +1464,16 @@ util::Accum* _obtainAccum(Channel* channel)
     accum->clear();
     return accum;
 }
+
+void _appendImageOps(const Frame* frame, ImageOps& ops)
+{
+    for (const Image* image : frame->getImages())
+    {
+        ImageOp op(frame, image);
+        op.offset = frame->getOffset();
+        ops.emplace_back(op);
+    }
+}
 }
 
 uint32_t Compositor::assembleFrames(const Frames& frames, Channel* channel,
@@ -689,8 +1482,14 @@ uint32_t Compositor::assembleFrames(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    if (_useCPUAssembly(frames, channel))
-        return assembleFramesCPU(frames, channel);
+    if (_useCPUAssembly(frames))
+    {
+        // subpixel images are averaged once all of them are available
+        if (!isSubPixelDecomposition(frames))
+            return assembleFramesCPUUnsorted(frames, channel);
+        if (_useCPUAssembly(frames, channel))
+            return assembleFramesCPU(frames, channel);
+    }
 
     // else
     return assembleFramesUnsorted(frames, channel, accum);
@@ -702,6 +1501,9 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
     if (ops.empty())
         return 0;
 
+    if (_useCPUAssembly(ops, true))
+        return assembleImagesCPU(ops, channel, true);
+
     if (isSubPixelDecomposition(ops))
     {
         const bool coreProfile =
@@ -741,13 +1543,9 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
         return count;
     }
 
-    uint32_t count = 1;
-    if (_useCPUAssembly(ops, true))
-        count = assembleImagesCPU(ops, channel, true);
-    else
-        for (const ImageOp& op : ops)
-            assembleImage(op, channel);
-    return count;
+    for (const ImageOp& op : ops)
+        assembleImage(op, channel);
+    return 1;
 }
 
 uint32_t Compositor::blendFrames(const Frames& frames, Channel* channel,
@@ -770,6 +1568,16 @@ uint32_t Compositor::blendFrames(const Frames& frames, Channel* channel,
     return blendImages(ops, channel, accum);
 }
 
+void Compositor::setSIMD(const char* name)
+{
+    detail::compositor::setSIMD(detail::compositor::parseSIMD(name));
+}
+
+void Compositor::setTiled(const bool tiled)
+{
+    _getTiled() = tiled ? 1 : 0;
+}
+
 bool Compositor::isSubPixelDecomposition(const Frames& frames)
 {
     if (frames.empty())
@@ -922,9 +1730,12 @@ uint32_t Compositor::assembleFramesUnsorted(const Frames& frames,
 class Compositor::WaitHandle
 {
 public:
-    WaitHandle(const Frames& frames, Channel* ch)
+    /** Wait with the timeout of the channel's config, or without a channel. */
+    WaitHandle(const Frames& frames, Channel* ch,
+               const uint32_t timeout_ = LB_TIMEOUT_INDEFINITE)
         : left(frames)
         , channel(ch)
+        , timeout(timeout_)
         , processed(0)
     {
     }
@@ -939,19 +1750,49 @@ public:
     lunchbox::Monitor<uint32_t> monitor;
     Frames left;
     Channel* const channel;
+    const uint32_t timeout;
     uint32_t processed;
 };
 
-Compositor::WaitHandle* Compositor::startWaitFrames(const Frames& frames,
-                                                    Channel* channel)
+namespace
 {
-    WaitHandle* handle = new WaitHandle(frames, channel);
+Compositor::WaitHandle* _startWaitFrames(const Frames& frames,
+                                         Channel* channel,
+                                         const uint32_t timeout)
+{
+    Compositor::WaitHandle* handle =
+        new Compositor::WaitHandle(frames, channel, timeout);
     for (FramesCIter i = frames.begin(); i != frames.end(); ++i)
         (*i)->addListener(handle->monitor);
 
     return handle;
 }
 
+Frame* _getReadyFrame(Compositor::WaitHandle* handle)
+{
+    for (FramesIter i = handle->left.begin(); i != handle->left.end(); ++i)
+    {
+        Frame* frame = *i;
+        if (!frame->isReady())
+            continue;
+
+        frame->removeListener(handle->monitor);
+        handle->left.erase(i);
+        return frame;
+    }
+
+    LBASSERTINFO(false, "Unreachable code");
+    delete handle;
+    return 0;
+}
+}
+
+Compositor::WaitHandle* Compositor::startWaitFrames(const Frames& frames,
+                                                    Channel* channel)
+{
+    return _startWaitFrames(frames, channel, LB_TIMEOUT_INDEFINITE);
+}
+
 Frame* Compositor::waitFrame(WaitHandle* handle)
 {
     if (handle->left.empty())
@@ -960,12 +1801,22 @@ Frame* Compositor::waitFrame(WaitHandle* handle)
         return 0;
     }
 
+    ++handle->processed;
+    if (!handle->channel)
+    {
+        if (!handle->monitor.timedWaitGE(handle->processed, handle->timeout))
+        {
+            delete handle;
+            throw Exception(Exception::TIMEOUT_INPUTFRAME);
+        }
+        return _getReadyFrame(handle);
+    }
+
     ChannelStatistics event(Statistic::CHANNEL_FRAME_WAIT_READY,
                             handle->channel);
     Config* config = handle->channel->getConfig();
     const uint32_t timeout = config->getTimeout();
 
-    ++handle->processed;
     if (timeout == LB_TIMEOUT_INDEFINITE)
         handle->monitor.waitGE(handle->processed);
     else
@@ -986,20 +1837,63 @@ Frame* Compositor::waitFrame(WaitHandle* handle)
         }
     }
 
-    for (FramesIter i = handle->left.begin(); i != handle->left.end(); ++i)
+    return _getReadyFrame(handle);
+}
+
+namespace
+{
+/**
+ * Merge frames on the CPU, recording the waits for the frames on the channel
+ * if given.
+ */
+const Image* _mergeFramesCPU(const Frames& frames, const bool blend,
+                             Channel* channel, const uint32_t timeout)
+{
+    ImageOps ops;
+    if (blend || Compositor::isSubPixelDecomposition(frames))
     {
-        Frame* frame = *i;
-        if (!frame->isReady())
-            continue;
+        // order-dependent, merge all images once all frames are ready
+        for (const Frame* frame : frames)
+        {
+            if (channel)
+            {
+                ChannelStatistics event(Statistic::CHANNEL_FRAME_WAIT_READY,
+                                        channel);
+                frame->waitReady(timeout);
+            }
+            else
+                frame->waitReady(timeout);
+            _appendImageOps(frame, ops);
+        }
+        return Compositor::mergeImagesCPU(ops, blend);
+    }
 
-        frame->removeListener(handle->monitor);
-        handle->left.erase(i);
-        return frame;
+    // Merge each frame as soon as it becomes ready, overlapping the merge with
+    // the reception of the remaining frames
+    LBVERB << "Unsorted CPU assembly" << std::endl;
+    IncrementalMerge merge(false);
+    bool merged = true;
+
+    Compositor::WaitHandle* handle =
+        _startWaitFrames(frames, channel, timeout);
+    for (Frame* frame = Compositor::waitFrame(handle); frame;
+         frame = Compositor::waitFrame(handle))
+    {
+        ImageOps frameOps;
+        _appendImageOps(frame, frameOps);
+        ops.insert(ops.end(), frameOps.begin(), frameOps.end());
+        if (merged)
+            merged = merge.merge(frameOps);
     }
 
-    LBASSERTINFO(false, "Unreachable code");
-    delete handle;
-    return 0;
+    // the images don't fit into one result incrementally, merge all at once
+    if (!merged)
+        return Compositor::mergeImagesCPU(ops, blend);
+
+    if (!merge.getResult())
+        LBWARN << "Nothing to assemble" << std::endl;
+    return merge.getResult();
+}
 }
 
 uint32_t Compositor::assembleFramesCPU(const Frames& frames, Channel* channel,
@@ -1009,14 +1903,63 @@ uint32_t Compositor::assembleFramesCPU(const Frames& frames, Channel* channel,
         return 0;
 
     // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
-    const Image* result =
-        mergeFramesCPU(frames, blend, channel->getConfig()->getTimeout());
+    const Image* result = _mergeFramesCPU(frames, blend, channel,
+                                          channel->getConfig()->getTimeout());
     return _assembleCPUImage(result, channel);
 }
 
+uint32_t Compositor::assembleFramesCPUUnsorted(const Frames& frames,
+                                               Channel* channel)
+{
+    if (frames.empty())
+        return 0;
+
+    // Merges the images of DB compounds using the CPU as soon as their frame
+    // is ready and then assembles the result image. Images not supported by
+    // the CPU merge are assembled directly, which gives the same result since
+    // depth-based compositing does not depend on the order.
+    LBVERB << "Unsorted CPU assembly" << std::endl;
+
+    IncrementalMerge merge(false);
+    CPUAssemblyFormat format(false);
+    ImageOps pending; // a single image is not worth a CPU-based assembly
+    uint32_t count = 0;
+
+    WaitHandle* handle = startWaitFrames(frames, channel);
+    for (Frame* frame = waitFrame(handle); frame; frame = waitFrame(handle))
+    {
+        ImageOps ops;
+        ops.swap(pending);
+        for (const Image* image : frame->getImages())
+        {
+            ImageOp op(frame, image);
+            op.offset = frame->getOffset();
+            count = 1;
+
+            if (_useCPUAssembly(image, format))
+                ops.push_back(op);
+            else
+                assembleImage(op, channel);
+        }
+
+        if (!merge.getResult() && ops.size() < 2)
+            pending.swap(ops);
+        else if (!merge.merge(ops))
+        {
+            for (const ImageOp& op : ops)
+                assembleImage(op, channel);
+        }
+    }
+
+    for (const ImageOp& op : pending)
+        assembleImage(op, channel);
+    _assembleCPUImage(merge.getResult(), channel);
+    return count;
+}
+
 uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
                                        const bool blend)
 {
@@ -1024,7 +1967,7 @@ uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
         return 0;
 
     // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result = mergeImagesCPU(images, blend);
@@ -1034,72 +1977,42 @@ uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
 const Image* Compositor::mergeFramesCPU(const Frames& frames, const bool blend,
                                         const uint32_t timeout)
 {
-    ImageOps ops;
-    for (const Frame* frame : frames)
-    {
-        frame->waitReady(timeout);
-        for (const Image* image : frame->getImages())
-        {
-            ImageOp op(frame, image);
-            op.offset = frame->getOffset();
-            ops.emplace_back(op);
-        }
-    }
-    return mergeImagesCPU(ops, blend);
+    return _mergeFramesCPU(frames, blend, 0, timeout);
 }
 
 const Image* Compositor::mergeImagesCPU(const ImageOps& ops, const bool blend)
 {
     LBVERB << "Sorted CPU assembly" << std::endl;
 
-    // Collect input image information and check preconditions
-    PixelViewport destPVP;
-    uint32_t colorInt = 0;
-    uint32_t colorExt = 0;
-    uint32_t colorPixelSize = 0;
-    uint32_t depthInt = 0;
-    uint32_t depthExt = 0;
-    uint32_t depthPixelSize = 0;
+    // Collect input image information, check preconditions and prepare output
+    IncrementalMerge merge(blend);
+    if (!merge.reserve(ops))
+        return 0;
 
-    if (!_collectOutputData(ops, destPVP, colorInt, colorPixelSize, colorExt,
-                            depthInt, depthPixelSize, depthExt))
+    Image* result = merge.getResult();
+    if (!result)
     {
+        LBWARN << "Nothing to assemble" << std::endl;
         return 0;
     }
 
-    // prepare output image
-    if (!_resultImage)
-        _resultImage = new Image;
-    Image* result = _resultImage.get();
-
-    // pre-condition check for current _merge implementations
-    LBASSERT(colorInt != 0);
-
-    result->setPixelViewport(destPVP);
-
-    PixelData colorPixels;
-    colorPixels.internalFormat = colorInt;
-    colorPixels.externalFormat = colorExt;
-    colorPixels.pixelSize = colorPixelSize;
-    colorPixels.pvp = destPVP;
-    result->setPixelData(Frame::Buffer::color, colorPixels);
-
-    void* destDepth = 0;
-    if (depthInt != 0) // at least one depth assembly
+    // assembly
+    if (isSubPixelDecomposition(ops))
     {
-        LBASSERT(depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
-        PixelData depthPixels;
-        depthPixels.internalFormat = depthInt;
-        depthPixels.externalFormat = depthExt;
-        depthPixels.pixelSize = depthPixelSize;
-        depthPixels.pvp = destPVP;
-        result->setPixelData(Frame::Buffer::depth, depthPixels);
-        destDepth = result->getPixelPointer(Frame::Buffer::depth);
+        if (!_isRGBA(result->getExternalFormat(Frame::Buffer::color)))
+        {
+            LBWARN << "Subpixel CPU assembly needs an RGBA color format"
+                   << std::endl;
+            return 0;
+        }
+        _mergeSubPixelImages(ops, blend, result);
     }
-
-    // assembly
-    _mergeImages(ops, blend, result->getPixelPointer(Frame::Buffer::color),
-                 destDepth, destPVP);
+    else
+        _mergeImages(ops, blend, result->getPixelPointer(Frame::Buffer::color),
+                     result->hasPixelData(Frame::Buffer::depth)
+                         ? result->getPixelPointer(Frame::Buffer::depth)
+                         : 0,
+                     result->getPixelViewport());
     return result;
 }
 
@@ -111,10 +111,34 @@ public:
     static uint32_t assembleImagesCPU(const ImageOps& ops, Channel* channel,
                                       const bool blend);
 
+    /**
+     * Assemble all frames in the order they become available in a memory
+     * buffer using the CPU before assembling the result on the given channel.
+     *
+     * The images of each frame are merged as soon as the frame is ready,
+     * overlapping the merge with the reception of the remaining frames. Images
+     * not supported by the CPU merge are assembled directly on the channel.
+     * Only used for depth-based compositing, which does not depend on the
+     * assembly order.
+     *
+     * @param frames the frames to assemble.
+     * @param channel the destination channel.
+     * @return the number of different subpixel steps assembled (0 or 1).
+     * @version 2.1
+     */
+    static uint32_t assembleFramesCPUUnsorted(const Frames& frames,
+                                              Channel* channel);
+
     /**
      * Merge the provided frames in the given order into one image in main
      * memory.
      *
+     * Zoomed images are resampled, images of pixel decompositions are
+     * de-interleaved and the images of subpixel decompositions are averaged.
+     *
+     * Without blending, each frame is merged as soon as it becomes ready,
+     * overlapping the merge with the reception of the remaining frames.
+     *
      * The returned image does not have to be freed. The compositor maintains
      * one image per thread, that is, the returned image is valid until the next
      * usage of the compositor in the current thread.
@@ -230,6 +254,24 @@ public:
     static bool isSubPixelDecomposition(const ImageOps& ops);
     static Frames extractOneSubPixel(Frames& frames);
     static ImageOps extractOneSubPixel(ImageOps& ops);
+
+    /**
+     * Limit the instruction set of the CPU compositing kernels.
+     *
+     * Overrides EQ_COMPOSITOR_SIMD, which is read once.
+     *
+     * @param name none, sse4.1, avx2 or avx512.
+     * @internal for testing and benchmarking
+     */
+    static void setSIMD(const char* name);
+
+    /**
+     * Select tiled (default) or per-image CPU merging.
+     *
+     * Overrides EQ_COMPOSITOR_TILED, which is read once.
+     * @internal for testing and benchmarking
+     */
+    static void setTiled(bool tiled);
     //@}
 
 private:
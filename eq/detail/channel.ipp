@@ -18,10 +18,16 @@
  */
 
 #include "../channel.h"
+#include "../frameData.h"
 #include "../image.h"
 #include "../resultImageListener.h"
+#include "../roiFinder.h"
+#include "compressorSelector.h"
 #include "fileFrameWriter.h"
 
+#include <mutex>
+#include <tuple>
+
 #ifdef EQUALIZER_USE_DEFLECT
 #include "../deflect/proxy.h"
 #endif
@@ -123,6 +129,13 @@ public:
         _finishImageListeners = false;
     }
 
+    /** Crop a read back image using the ROI statistics of this channel. */
+    void cropImage(eq::FrameData& frameData, eq::Image& image)
+    {
+        std::lock_guard<std::mutex> lock(roiLock);
+        frameData.cropImage(image, roiFinder);
+    }
+
     void downloadFramebuffer(eq::Channel& channel,
                              const eq::Frame::Buffer buffers)
     {
@@ -193,6 +206,21 @@ public:
     /** Dumps images when the channel is configured to do so */
     FileFrameWriter frameWriter;
 
+    /** The compressor selection per output link, used by the transmitter. */
+    std::map<co::NodeID, CompressorSelector> compressorSelectors;
+
+    /** Images waiting for transmission, by frame data id, version and
+        receivers. */
+    typedef std::tuple<uint128_t, uint128_t, std::vector<uint128_t>>
+        TransmitKey;
+    typedef std::map<TransmitKey, std::vector<uint64_t>> PendingTransmits;
+    lunchbox::Lockable<PendingTransmits, lunchbox::SpinLock> pendingTransmits;
+
+    /** Crops read back images, kept per channel since the frame data
+        objects of an output frame rotate over the frames. */
+    ROIFinder roiFinder;
+    std::mutex roiLock; //!< used by the pipe and the transfer thread
+
     bool _updateFrameBuffer;
     bool _finishImageListeners = false;
 };
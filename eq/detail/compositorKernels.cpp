@@ -0,0 +1,1407 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compositorKernels.h"
+
+#include <lunchbox/atomic.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define EQ_COMPOSITOR_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define EQ_TARGET(isa)
+#else
+#include <cpuid.h>
+#define EQ_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace compositor
+{
+namespace
+{
+/** Opaque pixel of N bytes, used to move color values of any format. */
+template <size_t N>
+struct Bytes
+{
+    uint8_t data[N];
+};
+
+template <typename T>
+void _mergeDBRow(void* destColor, uint32_t* destDepth, const void* color,
+                 const uint32_t* depth, const size_t nPixels)
+{
+    T* destC = reinterpret_cast<T*>(destColor);
+    const T* c = reinterpret_cast<const T*>(color);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        if (destDepth[i] > depth[i])
+        {
+            destC[i] = c[i];
+            destDepth[i] = depth[i];
+        }
+    }
+}
+
+/** @return x / 255, correctly rounded for x in [0, 255*255]. */
+inline uint32_t _div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+void _blendRowRGBA8(void* dest, const void* color, const size_t nPixels)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(color);
+    uint8_t* dst = reinterpret_cast<uint8_t*>(dest);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        const uint32_t alpha = src[3];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const uint32_t value = src[j] + _div255(alpha * dst[j]);
+            dst[j] = uint8_t(value < 255 ? value : 255);
+        }
+        dst[3] = uint8_t(_div255(alpha * dst[3]));
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+// GL_UNSIGNED_INT_10_10_10_2: three 10 bit channels in the upper 30 bits, a
+// two bit alpha in the lowest bits
+void _blendRowRGB10A2(void* dest, const void* color, const size_t nPixels)
+{
+    const uint32_t* src = reinterpret_cast<const uint32_t*>(color);
+    uint32_t* dst = reinterpret_cast<uint32_t*>(dest);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        const uint32_t alpha = src[i] & 0x3u;
+        uint32_t result = (alpha * (dst[i] & 0x3u) + 1) / 3;
+
+        for (uint32_t shift = 2; shift < 32; shift += 10)
+        {
+            const uint32_t srcValue = (src[i] >> shift) & 0x3FFu;
+            const uint32_t dstValue = (dst[i] >> shift) & 0x3FFu;
+            const uint32_t value = srcValue + (alpha * dstValue + 1) / 3;
+            result |= (value < 0x3FFu ? value : 0x3FFu) << shift;
+        }
+        dst[i] = result;
+    }
+}
+
+// Scalar half conversions with round-to-nearest-even, bit-exact with the F16C
+// instructions used by the SIMD kernels for all non-NaN values.
+float _halfToFloat(const uint16_t value)
+{
+    const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+    uint32_t bits = uint32_t(value & 0x7FFFu) << 13;
+    const uint32_t exponent = bits & 0x0F800000u;
+
+    bits += (127 - 15) << 23;
+    if (exponent == 0x0F800000u) // Inf, NaN
+        bits += (128 - 16) << 23;
+    else if (exponent == 0) // zero, denormal: renormalize
+    {
+        bits += 1 << 23;
+        float denormal;
+        memcpy(&denormal, &bits, 4);
+        denormal -= 6.103515625e-05f; // 2^-14
+        memcpy(&bits, &denormal, 4);
+    }
+    bits |= sign;
+
+    float result;
+    memcpy(&result, &bits, 4);
+    return result;
+}
+
+uint16_t _floatToHalf(const float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t result;
+    if (bits >= 0x47800000u) // overflow, Inf, NaN
+        result = bits > 0x7F800000u ? 0x7E00u | ((bits >> 13) & 0x3FFu)
+                                    : 0x7C00u;
+    else if (bits < 0x38800000u) // denormal or zero: let the FPU round
+    {
+        float denormal;
+        memcpy(&denormal, &bits, 4);
+        denormal += 0.5f;
+        memcpy(&result, &denormal, 4);
+        result -= 0x3F000000u;
+    }
+    else
+    {
+        const uint32_t odd = (bits >> 13) & 1u;
+        bits += (uint32_t(15 - 127) << 23) + 0xFFFu + odd;
+        result = bits >> 13;
+    }
+    return uint16_t(result | (sign >> 16));
+}
+
+void _blendRowRGBA16F(void* dest, const void* color, const size_t nPixels)
+{
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(color);
+    uint16_t* dst = reinterpret_cast<uint16_t*>(dest);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        const float alpha = _halfToFloat(src[3]);
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const float product = alpha * _halfToFloat(dst[j]);
+            dst[j] = _floatToHalf(_halfToFloat(src[j]) + product);
+        }
+        dst[3] = _floatToHalf(alpha * _halfToFloat(dst[3]));
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+void _blendRowRGBA32F(void* dest, const void* color, const size_t nPixels)
+{
+    const float* src = reinterpret_cast<const float*>(color);
+    float* dst = reinterpret_cast<float*>(dest);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        const float alpha = src[3];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const float product = alpha * dst[j];
+            dst[j] = src[j] + product;
+        }
+        dst[3] = alpha * dst[3];
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+template <typename T>
+void _nearestRow(void* dest, const void* row0, const void*, float,
+                 const int32_t* x0, const int32_t*, const float*,
+                 const size_t nPixels)
+{
+    T* dst = reinterpret_cast<T*>(dest);
+    const T* src = reinterpret_cast<const T*>(row0);
+
+    for (size_t i = 0; i < nPixels; ++i)
+        dst[i] = src[x0[i]];
+}
+
+// Pixel codecs for bilinear resampling, converting pixels to and from four
+// float channels
+struct RGBA8Codec
+{
+    typedef uint32_t Pixel;
+
+    static void decode(const Pixel pixel, float channels[4])
+    {
+        for (size_t i = 0; i < 4; ++i)
+            channels[i] = float((pixel >> (i * 8)) & 0xFFu);
+    }
+
+    static Pixel encode(const float channels[4])
+    {
+        Pixel pixel = 0;
+        for (size_t i = 0; i < 4; ++i)
+            pixel |= Pixel(channels[i] + .5f) << (i * 8);
+        return pixel;
+    }
+};
+
+struct RGB10A2Codec
+{
+    typedef uint32_t Pixel;
+
+    static void decode(const Pixel pixel, float channels[4])
+    {
+        channels[0] = float((pixel >> 22) & 0x3FFu);
+        channels[1] = float((pixel >> 12) & 0x3FFu);
+        channels[2] = float((pixel >> 2) & 0x3FFu);
+        channels[3] = float(pixel & 0x3u);
+    }
+
+    static Pixel encode(const float channels[4])
+    {
+        return (Pixel(channels[0] + .5f) << 22) |
+               (Pixel(channels[1] + .5f) << 12) |
+               (Pixel(channels[2] + .5f) << 2) | Pixel(channels[3] + .5f);
+    }
+};
+
+struct RGBA16FCodec
+{
+    typedef Bytes<8> Pixel;
+
+    static void decode(const Pixel& pixel, float channels[4])
+    {
+        uint16_t values[4];
+        memcpy(values, pixel.data, 8);
+        for (size_t i = 0; i < 4; ++i)
+            channels[i] = _halfToFloat(values[i]);
+    }
+
+    static Pixel encode(const float channels[4])
+    {
+        uint16_t values[4];
+        for (size_t i = 0; i < 4; ++i)
+            values[i] = _floatToHalf(channels[i]);
+        Pixel pixel;
+        memcpy(pixel.data, values, 8);
+        return pixel;
+    }
+};
+
+struct RGBA32FCodec
+{
+    typedef Bytes<16> Pixel;
+
+    static void decode(const Pixel& pixel, float channels[4])
+    {
+        memcpy(channels, pixel.data, 16);
+    }
+
+    static Pixel encode(const float channels[4])
+    {
+        Pixel pixel;
+        memcpy(pixel.data, channels, 16);
+        return pixel;
+    }
+};
+
+template <typename Codec>
+void _bilinearRow(void* dest, const void* row0, const void* row1,
+                  const float yWeight, const int32_t* x0, const int32_t* x1,
+                  const float* xWeight, const size_t nPixels)
+{
+    typedef typename Codec::Pixel Pixel;
+    Pixel* dst = reinterpret_cast<Pixel*>(dest);
+    const Pixel* src0 = reinterpret_cast<const Pixel*>(row0);
+    const Pixel* src1 = reinterpret_cast<const Pixel*>(row1);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        float p00[4], p01[4], p10[4], p11[4], result[4];
+        Codec::decode(src0[x0[i]], p00);
+        Codec::decode(src0[x1[i]], p01);
+        Codec::decode(src1[x0[i]], p10);
+        Codec::decode(src1[x1[i]], p11);
+
+        const float wx = xWeight[i];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const float top = p00[j] + wx * (p01[j] - p00[j]);
+            const float bottom = p10[j] + wx * (p11[j] - p10[j]);
+            result[j] = top + yWeight * (bottom - top);
+        }
+        dst[i] = Codec::encode(result);
+    }
+}
+
+template <typename T>
+void _scatterRow(void* dest, const void* src, const size_t stride,
+                 const size_t nPixels)
+{
+    T* dst = reinterpret_cast<T*>(dest);
+    const T* values = reinterpret_cast<const T*>(src);
+
+    for (size_t i = 0; i < nPixels; ++i)
+        dst[i * stride] = values[i];
+}
+
+template <typename T>
+void _gatherRow(void* dest, const void* src, const size_t stride,
+                const size_t nPixels)
+{
+    T* dst = reinterpret_cast<T*>(dest);
+    const T* values = reinterpret_cast<const T*>(src);
+
+    for (size_t i = 0; i < nPixels; ++i)
+        dst[i] = values[i * stride];
+}
+
+template <typename Codec>
+void _accumRow(float* accum, const void* color, const size_t nPixels)
+{
+    const typename Codec::Pixel* src =
+        reinterpret_cast<const typename Codec::Pixel*>(color);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        float channels[4];
+        Codec::decode(src[i], channels);
+        for (size_t j = 0; j < 4; ++j)
+            accum[i * 4 + j] += channels[j];
+    }
+}
+
+template <typename Codec>
+void _returnRow(void* color, const float* accum, const float scale,
+                const size_t nPixels)
+{
+    typename Codec::Pixel* dst =
+        reinterpret_cast<typename Codec::Pixel*>(color);
+
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        float channels[4];
+        for (size_t j = 0; j < 4; ++j)
+            channels[j] = accum[i * 4 + j] * scale;
+        dst[i] = Codec::encode(channels);
+    }
+}
+
+bool _occupiedRow(const uint32_t* values, const size_t nValues,
+                  const uint32_t* mask, const uint32_t background)
+{
+    for (size_t i = 0; i < nValues; ++i)
+        if ((values[i] ^ background) & mask[i % 4])
+            return true;
+    return false;
+}
+
+#ifdef EQ_COMPOSITOR_X86
+// SSE and AVX2 lack an unsigned 32 bit compare: flipping the sign bit of both
+// operands maps the unsigned order onto the signed order.
+EQ_TARGET("sse4.1")
+void _mergeDBRowSSE41(void* destColor, uint32_t* destDepth, const void* color,
+                      const uint32_t* depth, const size_t nPixels)
+{
+    uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
+    const uint32_t* c32 = reinterpret_cast<const uint32_t*>(color);
+    const __m128i sign = _mm_set1_epi32(int32_t(0x80000000u));
+
+    size_t i = 0;
+    for (; i + 4 <= nPixels; i += 4)
+    {
+        __m128i* dc = reinterpret_cast<__m128i*>(destC + i);
+        __m128i* dd = reinterpret_cast<__m128i*>(destDepth + i);
+        const __m128i c =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(c32 + i));
+        const __m128i d =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+        const __m128i oldC = _mm_loadu_si128(dc);
+        const __m128i oldD = _mm_loadu_si128(dd);
+
+        const __m128i mask = _mm_cmpgt_epi32(_mm_xor_si128(oldD, sign),
+                                             _mm_xor_si128(d, sign));
+        _mm_storeu_si128(dc, _mm_blendv_epi8(oldC, c, mask));
+        _mm_storeu_si128(dd, _mm_blendv_epi8(oldD, d, mask));
+    }
+    _mergeDBRow<uint32_t>(destC + i, destDepth + i, c32 + i, depth + i,
+                          nPixels - i);
+}
+
+EQ_TARGET("avx2")
+inline __m256i _closerAVX2(const __m256i oldDepth, const __m256i depth)
+{
+    const __m256i sign = _mm256_set1_epi32(int32_t(0x80000000u));
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(oldDepth, sign),
+                              _mm256_xor_si256(depth, sign));
+}
+
+EQ_TARGET("avx2")
+void _mergeDBRowAVX2(void* destColor, uint32_t* destDepth, const void* color,
+                     const uint32_t* depth, const size_t nPixels)
+{
+    uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
+    const uint32_t* c32 = reinterpret_cast<const uint32_t*>(color);
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        __m256i* dc = reinterpret_cast<__m256i*>(destC + i);
+        __m256i* dd = reinterpret_cast<__m256i*>(destDepth + i);
+        const __m256i c =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c32 + i));
+        const __m256i d =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+        const __m256i oldC = _mm256_loadu_si256(dc);
+        const __m256i oldD = _mm256_loadu_si256(dd);
+
+        const __m256i mask = _closerAVX2(oldD, d);
+        _mm256_storeu_si256(dc, _mm256_blendv_epi8(oldC, c, mask));
+        _mm256_storeu_si256(dd, _mm256_blendv_epi8(oldD, d, mask));
+    }
+    _mergeDBRowSSE41(destC + i, destDepth + i, c32 + i, depth + i,
+                     nPixels - i);
+}
+
+// Wide color formats: the 32 bit depth mask of eight pixels is widened to
+// the color pixel size before blending the color values.
+EQ_TARGET("avx2")
+void _mergeDBRow64AVX2(void* destColor, uint32_t* destDepth,
+                       const void* color, const uint32_t* depth,
+                       const size_t nPixels)
+{
+    uint64_t* destC = reinterpret_cast<uint64_t*>(destColor);
+    const uint64_t* c64 = reinterpret_cast<const uint64_t*>(color);
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        __m256i* dd = reinterpret_cast<__m256i*>(destDepth + i);
+        const __m256i d =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+        const __m256i oldD = _mm256_loadu_si256(dd);
+        const __m256i mask = _closerAVX2(oldD, d);
+        if (_mm256_testz_si256(mask, mask))
+            continue;
+
+        _mm256_storeu_si256(dd, _mm256_blendv_epi8(oldD, d, mask));
+        const __m256i masks[2] = {
+            _mm256_cvtepi32_epi64(_mm256_castsi256_si128(mask)),
+            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(mask, 1))};
+
+        for (size_t j = 0; j < 2; ++j)
+        {
+            __m256i* dc = reinterpret_cast<__m256i*>(destC + i + j * 4);
+            const __m256i c = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(c64 + i + j * 4));
+            _mm256_storeu_si256(dc, _mm256_blendv_epi8(_mm256_loadu_si256(dc),
+                                                       c, masks[j]));
+        }
+    }
+    _mergeDBRow<uint64_t>(destC + i, destDepth + i, c64 + i, depth + i,
+                          nPixels - i);
+}
+
+EQ_TARGET("avx2")
+void _mergeDBRow128AVX2(void* destColor, uint32_t* destDepth,
+                        const void* color, const uint32_t* depth,
+                        const size_t nPixels)
+{
+    typedef Bytes<16> Pixel;
+    Pixel* destC = reinterpret_cast<Pixel*>(destColor);
+    const Pixel* c128 = reinterpret_cast<const Pixel*>(color);
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        __m256i* dd = reinterpret_cast<__m256i*>(destDepth + i);
+        const __m256i d =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+        const __m256i oldD = _mm256_loadu_si256(dd);
+        const __m256i mask = _closerAVX2(oldD, d);
+        if (_mm256_testz_si256(mask, mask))
+            continue;
+
+        _mm256_storeu_si256(dd, _mm256_blendv_epi8(oldD, d, mask));
+        for (int j = 0; j < 4; ++j)
+        {
+            // two pixels per register, broadcast each pixel's mask
+            const __m256i index = _mm256_setr_epi32(j * 2, j * 2, j * 2, j * 2,
+                                                    j * 2 + 1, j * 2 + 1,
+                                                    j * 2 + 1, j * 2 + 1);
+            const __m256i pixelMask = _mm256_permutevar8x32_epi32(mask, index);
+            __m256i* dc = reinterpret_cast<__m256i*>(destC + i + j * 2);
+            const __m256i c = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(c128 + i + j * 2));
+            _mm256_storeu_si256(dc, _mm256_blendv_epi8(_mm256_loadu_si256(dc),
+                                                       c, pixelMask));
+        }
+    }
+    _mergeDBRow<Pixel>(destC + i, destDepth + i, c128 + i, depth + i,
+                       nPixels - i);
+}
+
+EQ_TARGET("avx512f")
+inline __mmask16 _closerAVX512(uint32_t* destDepth, const uint32_t* depth,
+                               const size_t left)
+{
+    const __mmask16 valid =
+        left >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << left) - 1);
+    const __m512i d = _mm512_maskz_loadu_epi32(valid, depth);
+    const __m512i oldD = _mm512_maskz_loadu_epi32(valid, destDepth);
+    const __mmask16 mask = _mm512_mask_cmpgt_epu32_mask(valid, oldD, d);
+    _mm512_mask_storeu_epi32(destDepth, mask, d);
+    return mask;
+}
+
+// The remainder of a row is handled with a partial mask instead of a scalar
+// loop. Colors are written with masked stores of the closer pixels.
+EQ_TARGET("avx512f")
+void _mergeDBRowAVX512(void* destColor, uint32_t* destDepth, const void* color,
+                       const uint32_t* depth, const size_t nPixels)
+{
+    uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
+    const uint32_t* c32 = reinterpret_cast<const uint32_t*>(color);
+
+    for (size_t i = 0; i < nPixels; i += 16)
+    {
+        const __mmask16 mask =
+            _closerAVX512(destDepth + i, depth + i, nPixels - i);
+        if (!mask)
+            continue;
+
+        const __m512i c = _mm512_maskz_loadu_epi32(mask, c32 + i);
+        _mm512_mask_storeu_epi32(destC + i, mask, c);
+    }
+}
+
+EQ_TARGET("avx512f")
+void _mergeDBRow64AVX512(void* destColor, uint32_t* destDepth,
+                         const void* color, const uint32_t* depth,
+                         const size_t nPixels)
+{
+    uint64_t* destC = reinterpret_cast<uint64_t*>(destColor);
+    const uint64_t* c64 = reinterpret_cast<const uint64_t*>(color);
+
+    for (size_t i = 0; i < nPixels; i += 16)
+    {
+        const __mmask16 mask =
+            _closerAVX512(destDepth + i, depth + i, nPixels - i);
+        if (!mask)
+            continue;
+
+        for (size_t j = 0; j < 2; ++j)
+        {
+            const __mmask8 pixelMask = __mmask8(mask >> (j * 8));
+            const size_t offset = i + j * 8;
+            const __m512i c = _mm512_maskz_loadu_epi64(pixelMask, c64 + offset);
+            _mm512_mask_storeu_epi64(destC + offset, pixelMask, c);
+        }
+    }
+}
+
+EQ_TARGET("avx512f")
+void _mergeDBRow128AVX512(void* destColor, uint32_t* destDepth,
+                          const void* color, const uint32_t* depth,
+                          const size_t nPixels)
+{
+    // four pixels per register, each mask bit expands to four lanes
+    static const __mmask16 expand[16] = {
+        0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+        0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF};
+    uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
+    const uint32_t* c32 = reinterpret_cast<const uint32_t*>(color);
+
+    for (size_t i = 0; i < nPixels; i += 16)
+    {
+        const __mmask16 mask =
+            _closerAVX512(destDepth + i, depth + i, nPixels - i);
+        if (!mask)
+            continue;
+
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const __mmask16 pixelMask = expand[(mask >> (j * 4)) & 0xF];
+            const size_t offset = (i + j * 4) * 4;
+            const __m512i c = _mm512_maskz_loadu_epi32(pixelMask, c32 + offset);
+            _mm512_mask_storeu_epi32(destC + offset, pixelMask, c);
+        }
+    }
+}
+
+// Blending works on 16 bit lanes: the source alpha is broadcast to all
+// channels of a pixel, multiplied with the destination and divided by 255
+// using (x + 128) * 257 >> 16, which is exact for all 8 bit products.
+EQ_TARGET("sse4.1")
+inline __m128i _blendSSE41(const __m128i src, const __m128i dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaLo =
+        _mm_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+    const __m128i alphaHi = _mm_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1, 15,
+                                          -1, 15, -1, 15, -1, 15, -1);
+    const __m128i alphaMask = _mm_set1_epi32(int32_t(0xFF000000u));
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i scale = _mm_set1_epi16(257);
+
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero),
+                                 _mm_shuffle_epi8(src, alphaLo));
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero),
+                                 _mm_shuffle_epi8(src, alphaHi));
+    lo = _mm_mulhi_epu16(_mm_add_epi16(lo, round), scale);
+    hi = _mm_mulhi_epu16(_mm_add_epi16(hi, round), scale);
+
+    const __m128i product = _mm_packus_epi16(lo, hi);
+    const __m128i color = _mm_adds_epu8(src, product);
+    return _mm_blendv_epi8(color, product, alphaMask);
+}
+
+EQ_TARGET("sse4.1")
+void _blendRowRGBA8SSE41(void* dest, const void* color, const size_t nPixels)
+{
+    uint32_t* dst32 = reinterpret_cast<uint32_t*>(dest);
+    const uint32_t* src32 = reinterpret_cast<const uint32_t*>(color);
+
+    size_t i = 0;
+    for (; i + 4 <= nPixels; i += 4)
+    {
+        __m128i* dst = reinterpret_cast<__m128i*>(dst32 + i);
+        const __m128i src =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src32 + i));
+        _mm_storeu_si128(dst, _blendSSE41(src, _mm_loadu_si128(dst)));
+    }
+    _blendRowRGBA8(dst32 + i, src32 + i, nPixels - i);
+}
+
+EQ_TARGET("avx2")
+void _blendRowRGBA8AVX2(void* dest, const void* color, const size_t nPixels)
+{
+    uint32_t* dst32 = reinterpret_cast<uint32_t*>(dest);
+    const uint32_t* src32 = reinterpret_cast<const uint32_t*>(color);
+
+    // shuffles, unpacks and packs operate on 128 bit lanes, which keeps the
+    // pixel order intact
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaLo =
+        _mm256_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7,
+                         -1, 3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1,
+                         7, -1);
+    const __m256i alphaHi =
+        _mm256_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15,
+                         -1, 15, -1, 11, -1, 11, -1, 11, -1, 11, -1, 15, -1,
+                         15, -1, 15, -1, 15, -1);
+    const __m256i alphaMask = _mm256_set1_epi32(int32_t(0xFF000000u));
+    const __m256i round = _mm256_set1_epi16(128);
+    const __m256i scale = _mm256_set1_epi16(257);
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        __m256i* dstPtr = reinterpret_cast<__m256i*>(dst32 + i);
+        const __m256i src =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src32 + i));
+        const __m256i dst = _mm256_loadu_si256(dstPtr);
+
+        __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero),
+                                        _mm256_shuffle_epi8(src, alphaLo));
+        __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero),
+                                        _mm256_shuffle_epi8(src, alphaHi));
+        lo = _mm256_mulhi_epu16(_mm256_add_epi16(lo, round), scale);
+        hi = _mm256_mulhi_epu16(_mm256_add_epi16(hi, round), scale);
+
+        const __m256i product = _mm256_packus_epi16(lo, hi);
+        const __m256i result = _mm256_blendv_epi8(
+            _mm256_adds_epu8(src, product), product, alphaMask);
+        _mm256_storeu_si256(dstPtr, result);
+    }
+    _blendRowRGBA8SSE41(dst32 + i, src32 + i, nPixels - i);
+}
+
+// Float blending: each 128 bit lane holds one RGBA pixel. The product is
+// computed separately from the sum (no FMA) to match the scalar kernel.
+EQ_TARGET("sse4.1")
+inline __m128 _blendSSE41(const __m128 src, const __m128 dst)
+{
+    const __m128 product =
+        _mm_mul_ps(_mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3)), dst);
+    return _mm_blend_ps(_mm_add_ps(src, product), product, 0x8);
+}
+
+EQ_TARGET("sse4.1")
+void _blendRowRGBA32FSSE41(void* dest, const void* color,
+                           const size_t nPixels)
+{
+    float* dst = reinterpret_cast<float*>(dest);
+    const float* src = reinterpret_cast<const float*>(color);
+
+    for (size_t i = 0; i < nPixels * 4; i += 4)
+        _mm_storeu_ps(dst + i, _blendSSE41(_mm_loadu_ps(src + i),
+                                           _mm_loadu_ps(dst + i)));
+}
+
+EQ_TARGET("avx2")
+inline __m256 _blendAVX2(const __m256 src, const __m256 dst)
+{
+    const __m256 product = _mm256_mul_ps(_mm256_permute_ps(src, 0xFF), dst);
+    return _mm256_blend_ps(_mm256_add_ps(src, product), product, 0x88);
+}
+
+EQ_TARGET("avx2")
+void _blendRowRGBA32FAVX2(void* dest, const void* color, const size_t nPixels)
+{
+    float* dst = reinterpret_cast<float*>(dest);
+    const float* src = reinterpret_cast<const float*>(color);
+
+    size_t i = 0;
+    for (; i + 2 <= nPixels; i += 2)
+        _mm256_storeu_ps(dst + i * 4, _blendAVX2(_mm256_loadu_ps(src + i * 4),
+                                                 _mm256_loadu_ps(dst + i * 4)));
+    _blendRowRGBA32FSSE41(dst + i * 4, src + i * 4, nPixels - i);
+}
+
+EQ_TARGET("avx512f")
+void _blendRowRGBA32FAVX512(void* dest, const void* color,
+                            const size_t nPixels)
+{
+    float* dst = reinterpret_cast<float*>(dest);
+    const float* src = reinterpret_cast<const float*>(color);
+
+    size_t i = 0;
+    for (; i + 4 <= nPixels; i += 4)
+    {
+        const __m512 s = _mm512_loadu_ps(src + i * 4);
+        const __m512 d = _mm512_loadu_ps(dst + i * 4);
+        const __m512 product = _mm512_mul_ps(_mm512_shuffle_ps(s, s, 0xFF), d);
+        _mm512_storeu_ps(dst + i * 4,
+                         _mm512_mask_blend_ps(0x8888, _mm512_add_ps(s, product),
+                                              product));
+    }
+    _blendRowRGBA32FAVX2(dst + i * 4, src + i * 4, nPixels - i);
+}
+
+// F16C converts two RGBA16F pixels into one AVX register
+EQ_TARGET("avx2,f16c")
+void _blendRowRGBA16FAVX2(void* dest, const void* color, const size_t nPixels)
+{
+    uint16_t* dst = reinterpret_cast<uint16_t*>(dest);
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(color);
+
+    size_t i = 0;
+    for (; i + 2 <= nPixels; i += 2)
+    {
+        __m128i* dstPtr = reinterpret_cast<__m128i*>(dst + i * 4);
+        const __m256 s = _mm256_cvtph_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+        const __m256 d = _mm256_cvtph_ps(_mm_loadu_si128(dstPtr));
+        _mm_storeu_si128(dstPtr, _mm256_cvtps_ph(_blendAVX2(s, d),
+                                                 _MM_FROUND_TO_NEAREST_INT));
+    }
+    _blendRowRGBA16F(dst + i * 4, src + i * 4, nPixels - i);
+}
+
+// Strided stores of 32 bit pixels. AVX2 has no scatter instruction: for small
+// strides the source pixels are permuted into their destination lanes and
+// written with a masked store.
+EQ_TARGET("avx2")
+void _scatterRowAVX2(void* dest, const void* src, const size_t stride,
+                     const size_t nPixels)
+{
+    if (stride != 2 && stride != 4)
+    {
+        _scatterRow<uint32_t>(dest, src, stride, nPixels);
+        return;
+    }
+
+    int32_t* dst = reinterpret_cast<int32_t*>(dest);
+    const int32_t* values = reinterpret_cast<const int32_t*>(src);
+    const size_t perVector = 8 / stride; // source pixels per destination vector
+    const __m256i mask = stride == 2
+                             ? _mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0)
+                             : _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m256i index0 = stride == 2
+                               ? _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3)
+                               : _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i next = _mm256_set1_epi32(int32_t(perVector));
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+    {
+        const __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i index = index0;
+        for (size_t j = 0; j < 8; j += perVector)
+        {
+            _mm256_maskstore_epi32(dst + (i + j) * stride, mask,
+                                   _mm256_permutevar8x32_epi32(v, index));
+            index = _mm256_add_epi32(index, next);
+        }
+    }
+    _scatterRow<uint32_t>(dst + i * stride, values + i, stride, nPixels - i);
+}
+
+EQ_TARGET("avx2")
+void _gatherRowAVX2(void* dest, const void* src, const size_t stride,
+                    const size_t nPixels)
+{
+    uint32_t* dst = reinterpret_cast<uint32_t*>(dest);
+    const int* values = reinterpret_cast<const int*>(src);
+    const int32_t step = int32_t(stride);
+    const __m256i index = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(step));
+
+    size_t i = 0;
+    for (; i + 8 <= nPixels; i += 8)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_i32gather_epi32(values + i * stride, index,
+                                                   4));
+    _gatherRow<uint32_t>(dst + i, values + i * stride, stride, nPixels - i);
+}
+
+EQ_TARGET("avx512f")
+void _scatterRowAVX512(void* dest, const void* src, const size_t stride,
+                       const size_t nPixels)
+{
+    int32_t* dst = reinterpret_cast<int32_t*>(dest);
+    const int32_t* values = reinterpret_cast<const int32_t*>(src);
+    const __m512i index =
+        _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                             11, 12, 13, 14, 15),
+                           _mm512_set1_epi32(int32_t(stride)));
+
+    for (size_t i = 0; i < nPixels; i += 16)
+    {
+        const size_t left = nPixels - i;
+        const __mmask16 valid =
+            left >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << left) - 1);
+        const __m512i v = _mm512_maskz_loadu_epi32(valid, values + i);
+        _mm512_mask_i32scatter_epi32(dst + i * stride, valid, index, v, 4);
+    }
+}
+
+EQ_TARGET("avx512f")
+void _gatherRowAVX512(void* dest, const void* src, const size_t stride,
+                      const size_t nPixels)
+{
+    int32_t* dst = reinterpret_cast<int32_t*>(dest);
+    const int32_t* values = reinterpret_cast<const int32_t*>(src);
+    const __m512i index =
+        _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                             11, 12, 13, 14, 15),
+                           _mm512_set1_epi32(int32_t(stride)));
+
+    for (size_t i = 0; i < nPixels; i += 16)
+    {
+        const size_t left = nPixels - i;
+        const __mmask16 valid =
+            left >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << left) - 1);
+        const __m512i v = _mm512_mask_i32gather_epi32(
+            _mm512_setzero_si512(), valid, index, values + i * stride, 4);
+        _mm512_mask_storeu_epi32(dst + i, valid, v);
+    }
+}
+
+// RGBA8 accumulation: four pixels are widened to 16 float channels per
+// iteration. Rounding adds .5 and truncates like the scalar codec.
+EQ_TARGET("avx2")
+void _accumRowRGBA8AVX2(float* accum, const void* color, const size_t nPixels)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(color);
+
+    size_t i = 0;
+    for (; i + 2 <= nPixels; i += 2)
+    {
+        const __m128i pixels =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixels));
+        _mm256_storeu_ps(accum + i * 4,
+                         _mm256_add_ps(_mm256_loadu_ps(accum + i * 4), values));
+    }
+    _accumRow<RGBA8Codec>(accum + i * 4, src + i * 4, nPixels - i);
+}
+
+EQ_TARGET("avx2")
+void _returnRowRGBA8AVX2(void* color, const float* accum, const float scale,
+                         const size_t nPixels)
+{
+    uint8_t* dst = reinterpret_cast<uint8_t*>(color);
+    const __m256 factor = _mm256_set1_ps(scale);
+    const __m256 half = _mm256_set1_ps(.5f);
+
+    size_t i = 0;
+    for (; i + 4 <= nPixels; i += 4)
+    {
+        const __m256 lo = _mm256_add_ps(
+            _mm256_mul_ps(_mm256_loadu_ps(accum + i * 4), factor), half);
+        const __m256 hi = _mm256_add_ps(
+            _mm256_mul_ps(_mm256_loadu_ps(accum + i * 4 + 8), factor), half);
+        // packs operate per 128 bit lane, restore the pixel order afterwards
+        const __m256i words = _mm256_packus_epi32(_mm256_cvttps_epi32(lo),
+                                                  _mm256_cvttps_epi32(hi));
+        const __m256i bytes = _mm256_packus_epi16(words, words);
+        const __m256i ordered = _mm256_permutevar8x32_epi32(
+            bytes, _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+                         _mm256_castsi256_si128(ordered));
+    }
+    _returnRow<RGBA8Codec>(dst + i * 4, accum + i * 4, scale, nPixels - i);
+}
+
+// The foreground tests process a multiple of the four mask elements per
+// iteration, which keeps the mask aligned to the pixels of the scalar tail.
+EQ_TARGET("sse4.1")
+bool _occupiedRowSSE41(const uint32_t* values, const size_t nValues,
+                       const uint32_t* mask, const uint32_t background)
+{
+    const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+    const __m128i bg = _mm_set1_epi32(int32_t(background));
+
+    size_t i = 0;
+    for (; i + 4 <= nValues; i += 4)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        if (!_mm_testz_si128(_mm_xor_si128(v, bg), m))
+            return true;
+    }
+    return _occupiedRow(values + i, nValues - i, mask, background);
+}
+
+EQ_TARGET("avx2")
+bool _occupiedRowAVX2(const uint32_t* values, const size_t nValues,
+                      const uint32_t* mask, const uint32_t background)
+{
+    const __m256i m = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask)));
+    const __m256i bg = _mm256_set1_epi32(int32_t(background));
+
+    size_t i = 0;
+    for (; i + 8 <= nValues; i += 8)
+    {
+        const __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        if (!_mm256_testz_si256(_mm256_xor_si256(v, bg), m))
+            return true;
+    }
+    return _occupiedRow(values + i, nValues - i, mask, background);
+}
+
+EQ_TARGET("avx512f")
+bool _occupiedRowAVX512(const uint32_t* values, const size_t nValues,
+                        const uint32_t* mask, const uint32_t background)
+{
+    const __m512i m = _mm512_set_epi32(
+        int32_t(mask[3]), int32_t(mask[2]), int32_t(mask[1]), int32_t(mask[0]),
+        int32_t(mask[3]), int32_t(mask[2]), int32_t(mask[1]), int32_t(mask[0]),
+        int32_t(mask[3]), int32_t(mask[2]), int32_t(mask[1]), int32_t(mask[0]),
+        int32_t(mask[3]), int32_t(mask[2]), int32_t(mask[1]), int32_t(mask[0]));
+    const __m512i bg = _mm512_set1_epi32(int32_t(background));
+
+    for (size_t i = 0; i < nValues; i += 16)
+    {
+        const size_t left = nValues - i;
+        const __mmask16 valid =
+            left >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << left) - 1);
+        const __m512i v = _mm512_maskz_loadu_epi32(valid, values + i);
+        if (_mm512_mask_test_epi32_mask(valid, _mm512_xor_si512(v, bg), m))
+            return true;
+    }
+    return false;
+}
+
+#ifdef _MSC_VER
+SIMD _detectSIMD()
+{
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    if (maxLeaf < 1)
+        return SIMD_NONE;
+
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 19))) // SSE4.1
+        return SIMD_NONE;
+
+    // AVX requires OS support for saving the YMM/ZMM registers
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave || !f16c || maxLeaf < 7)
+        return SIMD_SSE41;
+
+    const unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6)
+        return SIMD_SSE41;
+
+    __cpuidex(info, 7, 0);
+    if (!(info[1] & (1 << 5))) // AVX2
+        return SIMD_SSE41;
+    if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) // AVX-512F
+        return SIMD_AVX512;
+    return SIMD_AVX2;
+}
+#else
+SIMD _detectSIMD()
+{
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse4.1"))
+        return SIMD_NONE;
+
+    // The AVX2 kernels also use F16C, which all AVX2 CPUs implement
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_F16C))
+        return SIMD_SSE41;
+
+    if (__builtin_cpu_supports("avx512f"))
+        return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+    return SIMD_SSE41;
+}
+#endif
+#else
+SIMD _detectSIMD()
+{
+    return SIMD_NONE;
+}
+#endif
+
+SIMD _readSIMD()
+{
+    const char* env = getenv("EQ_COMPOSITOR_SIMD");
+    const SIMD supported = getSupportedSIMD();
+    if (!env)
+        return supported;
+
+    const SIMD requested = parseSIMD(env);
+    return requested < supported ? requested : supported;
+}
+
+lunchbox::a_int32_t& _getSelectedSIMD()
+{
+    // EQ_COMPOSITOR_SIMD is read once, kernels are looked up per merge
+    static lunchbox::a_int32_t simd(_readSIMD());
+    return simd;
+}
+}
+
+SIMD getSupportedSIMD()
+{
+    static const SIMD simd = _detectSIMD();
+    return simd;
+}
+
+SIMD getSIMD()
+{
+    return SIMD(int32_t(_getSelectedSIMD()));
+}
+
+void setSIMD(const SIMD simd)
+{
+    const SIMD supported = getSupportedSIMD();
+    _getSelectedSIMD() = simd < supported ? simd : supported;
+}
+
+SIMD parseSIMD(const char* name)
+{
+    if (strcmp(name, "avx512") == 0)
+        return SIMD_AVX512;
+    if (strcmp(name, "avx2") == 0)
+        return SIMD_AVX2;
+    if (strcmp(name, "sse4.1") == 0 || strcmp(name, "sse41") == 0)
+        return SIMD_SSE41;
+    return SIMD_NONE;
+}
+
+const char* getName(const SIMD simd)
+{
+    switch (simd)
+    {
+    case SIMD_SSE41:
+        return "sse4.1";
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_AVX512:
+        return "avx512";
+    default:
+        return "none";
+    }
+}
+
+MergeDBRow getMergeDBRow(const size_t colorSize, const SIMD simd)
+{
+    switch (colorSize)
+    {
+    case 3:
+        return _mergeDBRow<Bytes<3>>;
+    case 6:
+        return _mergeDBRow<Bytes<6>>;
+    case 12:
+        return _mergeDBRow<Bytes<12>>;
+
+    case 4:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _mergeDBRowAVX512;
+        case SIMD_AVX2:
+            return _mergeDBRowAVX2;
+        case SIMD_SSE41:
+            return _mergeDBRowSSE41;
+#endif
+        default:
+            return _mergeDBRow<uint32_t>;
+        }
+
+    case 8:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _mergeDBRow64AVX512;
+        case SIMD_AVX2:
+            return _mergeDBRow64AVX2;
+#endif
+        default:
+            return _mergeDBRow<uint64_t>;
+        }
+
+    case 16:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _mergeDBRow128AVX512;
+        case SIMD_AVX2:
+            return _mergeDBRow128AVX2;
+#endif
+        default:
+            return _mergeDBRow<Bytes<16>>;
+        }
+
+    default:
+        return 0;
+    }
+}
+
+BlendRow getBlendRow(const ColorFormat format, const SIMD simd)
+{
+    switch (format)
+    {
+    case COLOR_RGBA8:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512: // 16 bit lane operations need AVX-512BW, use AVX2
+        case SIMD_AVX2:
+            return _blendRowRGBA8AVX2;
+        case SIMD_SSE41:
+            return _blendRowRGBA8SSE41;
+#endif
+        default:
+            return _blendRowRGBA8;
+        }
+
+    case COLOR_RGB10A2:
+        return _blendRowRGB10A2;
+
+    case COLOR_RGBA16F:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+        case SIMD_AVX2:
+            return _blendRowRGBA16FAVX2;
+#endif
+        default:
+            return _blendRowRGBA16F;
+        }
+
+    case COLOR_RGBA32F:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _blendRowRGBA32FAVX512;
+        case SIMD_AVX2:
+            return _blendRowRGBA32FAVX2;
+        case SIMD_SSE41:
+            return _blendRowRGBA32FSSE41;
+#endif
+        default:
+            return _blendRowRGBA32F;
+        }
+
+    default:
+        return 0;
+    }
+}
+
+ResampleRow getNearestRow(const size_t pixelSize)
+{
+    switch (pixelSize)
+    {
+    case 3:
+        return _nearestRow<Bytes<3>>;
+    case 4:
+        return _nearestRow<uint32_t>;
+    case 6:
+        return _nearestRow<Bytes<6>>;
+    case 8:
+        return _nearestRow<uint64_t>;
+    case 12:
+        return _nearestRow<Bytes<12>>;
+    case 16:
+        return _nearestRow<Bytes<16>>;
+    default:
+        return 0;
+    }
+}
+
+ResampleRow getBilinearRow(const ColorFormat format)
+{
+    switch (format)
+    {
+    case COLOR_RGBA8:
+        return _bilinearRow<RGBA8Codec>;
+    case COLOR_RGB10A2:
+        return _bilinearRow<RGB10A2Codec>;
+    case COLOR_RGBA16F:
+        return _bilinearRow<RGBA16FCodec>;
+    case COLOR_RGBA32F:
+        return _bilinearRow<RGBA32FCodec>;
+    default:
+        return 0;
+    }
+}
+
+StridedRow getScatterRow(const size_t pixelSize, const SIMD simd)
+{
+    switch (pixelSize)
+    {
+    case 3:
+        return _scatterRow<Bytes<3>>;
+    case 4:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _scatterRowAVX512;
+        case SIMD_AVX2:
+            return _scatterRowAVX2;
+#endif
+        default:
+            return _scatterRow<uint32_t>;
+        }
+    case 6:
+        return _scatterRow<Bytes<6>>;
+    case 8:
+        return _scatterRow<uint64_t>;
+    case 12:
+        return _scatterRow<Bytes<12>>;
+    case 16:
+        return _scatterRow<Bytes<16>>;
+    default:
+        return 0;
+    }
+}
+
+StridedRow getGatherRow(const size_t pixelSize, const SIMD simd)
+{
+    switch (pixelSize)
+    {
+    case 3:
+        return _gatherRow<Bytes<3>>;
+    case 4:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+            return _gatherRowAVX512;
+        case SIMD_AVX2:
+            return _gatherRowAVX2;
+#endif
+        default:
+            return _gatherRow<uint32_t>;
+        }
+    case 6:
+        return _gatherRow<Bytes<6>>;
+    case 8:
+        return _gatherRow<uint64_t>;
+    case 12:
+        return _gatherRow<Bytes<12>>;
+    case 16:
+        return _gatherRow<Bytes<16>>;
+    default:
+        return 0;
+    }
+}
+
+AccumRow getAccumRow(const ColorFormat format, const SIMD simd)
+{
+    switch (format)
+    {
+    case COLOR_RGBA8:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+        case SIMD_AVX2:
+            return _accumRowRGBA8AVX2;
+#endif
+        default:
+            return _accumRow<RGBA8Codec>;
+        }
+    case COLOR_RGB10A2:
+        return _accumRow<RGB10A2Codec>;
+    case COLOR_RGBA16F:
+        return _accumRow<RGBA16FCodec>;
+    case COLOR_RGBA32F:
+        return _accumRow<RGBA32FCodec>;
+    default:
+        return 0;
+    }
+}
+
+ReturnRow getReturnRow(const ColorFormat format, const SIMD simd)
+{
+    switch (format)
+    {
+    case COLOR_RGBA8:
+        switch (simd)
+        {
+#ifdef EQ_COMPOSITOR_X86
+        case SIMD_AVX512:
+        case SIMD_AVX2:
+            return _returnRowRGBA8AVX2;
+#endif
+        default:
+            return _returnRow<RGBA8Codec>;
+        }
+    case COLOR_RGB10A2:
+        return _returnRow<RGB10A2Codec>;
+    case COLOR_RGBA16F:
+        return _returnRow<RGBA16FCodec>;
+    case COLOR_RGBA32F:
+        return _returnRow<RGBA32FCodec>;
+    default:
+        return 0;
+    }
+}
+
+OccupiedRow getOccupiedRow(const SIMD simd)
+{
+    switch (simd)
+    {
+#ifdef EQ_COMPOSITOR_X86
+    case SIMD_AVX512:
+        return _occupiedRowAVX512;
+    case SIMD_AVX2:
+        return _occupiedRowAVX2;
+    case SIMD_SSE41:
+        return _occupiedRowSSE41;
+#endif
+    default:
+        return _occupiedRow;
+    }
+}
+}
+}
+}
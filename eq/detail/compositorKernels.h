@@ -0,0 +1,179 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_COMPOSITORKERNELS_H
+#define EQ_DETAIL_COMPOSITORKERNELS_H
+
+#include <eq/api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Row kernels used by the CPU compositor.
+ *
+ * Each kernel exists as a portable scalar implementation and, on x86, as
+ * SSE4.1, AVX2 and AVX-512 implementations. The implementation is selected at
+ * runtime based on the capabilities of the CPU. The environment variable
+ * EQ_COMPOSITOR_SIMD (none, sse4.1, avx2 or avx512) limits the selection to
+ * the given instruction set, which is used for testing and benchmarking.
+ */
+namespace compositor
+{
+/** The instruction set used by the compositing kernels. */
+enum SIMD
+{
+    SIMD_NONE,   //!< Portable scalar implementation
+    SIMD_SSE41,  //!< SSE 4.1, 4 pixels per iteration
+    SIMD_AVX2,   //!< AVX2, 8 pixels per iteration
+    SIMD_AVX512, //!< AVX-512F, 16 pixels per iteration
+    SIMD_ALL
+};
+
+/** The color formats supported by the blending kernels. */
+enum ColorFormat
+{
+    COLOR_RGBA8,   //!< 8 bit RGBA or BGRA
+    COLOR_RGB10A2, //!< GL_UNSIGNED_INT_10_10_10_2 RGB10_A2 or BGR10_A2
+    COLOR_RGBA16F, //!< half float RGBA or BGRA
+    COLOR_RGBA32F  //!< float RGBA or BGRA
+};
+
+/**
+ * Merge one row of color and unsigned int depth pixels.
+ *
+ * Pixels closer than the destination depth replace destination color and
+ * depth.
+ */
+typedef void (*MergeDBRow)(void* destColor, uint32_t* destDepth,
+                           const void* color, const uint32_t* depth,
+                           size_t nPixels);
+
+/**
+ * Blend one row of premultiplied color pixels onto the destination.
+ *
+ * Computes dstColor = srcColor + srcAlpha * dstColor and dstAlpha = srcAlpha *
+ * dstAlpha, i.e., glBlendFuncSeparate( GL_ONE, GL_SRC_ALPHA, GL_ZERO,
+ * GL_SRC_ALPHA ). Integer formats are saturated and use correctly rounded
+ * divisions by their maximum value.
+ */
+typedef void (*BlendRow)(void* dest, const void* color, size_t nPixels);
+
+/**
+ * Resample one row of pixels for zoomed compositing.
+ *
+ * Output pixel i interpolates the source pixels x0[i] and x1[i] of row0 and
+ * row1, weighting the second pixel with xWeight[i] and the second row with
+ * yWeight. Nearest neighbor kernels only read x0 of row0.
+ */
+typedef void (*ResampleRow)(void* dest, const void* row0, const void* row1,
+                            float yWeight, const int32_t* x0,
+                            const int32_t* x1, const float* xWeight,
+                            size_t nPixels);
+
+/**
+ * Copy one row of pixels to or from every stride-th pixel.
+ *
+ * Scatter kernels write dest[i * stride] = src[i], gather kernels read
+ * dest[i] = src[i * stride]. Used to de-interleave pixel decompositions.
+ */
+typedef void (*StridedRow)(void* dest, const void* src, size_t stride,
+                           size_t nPixels);
+
+/** Add one row of color pixels to a float RGBA accumulation row. */
+typedef void (*AccumRow)(float* accum, const void* color, size_t nPixels);
+
+/** Convert one row of scaled accumulated values back to color pixels. */
+typedef void (*ReturnRow)(void* color, const float* accum, float scale,
+                          size_t nPixels);
+
+/**
+ * Test one row of 32 bit pixel values for foreground pixels.
+ *
+ * A value is foreground if it differs from the background in any bit set in
+ * the mask. The mask has four elements which repeat along the row, to mask
+ * the alpha channel of pixels up to 16 bytes.
+ *
+ * @return true if the row contains a foreground value.
+ */
+typedef bool (*OccupiedRow)(const uint32_t* values, size_t nValues,
+                            const uint32_t* mask, uint32_t background);
+
+/** @return the best instruction set supported by the CPU. */
+EQ_API SIMD getSupportedSIMD();
+
+/**
+ * @return the instruction set to use, limited by EQ_COMPOSITOR_SIMD when the
+ *         kernels are first used, or by setSIMD().
+ */
+EQ_API SIMD getSIMD();
+
+/** Limit the instruction set to use, capped to the supported set. */
+void setSIMD(SIMD simd);
+
+/** @return the instruction set of the given name, SIMD_NONE if unknown. */
+SIMD parseSIMD(const char* name);
+
+/** @return the name of the given instruction set. */
+EQ_API const char* getName(SIMD simd);
+
+/**
+ * @return the depth merge kernel for the given color pixel size in bytes, or
+ *         0 if the pixel size is not supported.
+ */
+MergeDBRow getMergeDBRow(size_t colorSize, SIMD simd = getSIMD());
+
+/** @return the alpha blending kernel for the given format. */
+BlendRow getBlendRow(ColorFormat format, SIMD simd = getSIMD());
+
+/**
+ * @return the nearest neighbor resampling kernel for the given pixel size in
+ *         bytes, or 0 if the pixel size is not supported.
+ */
+ResampleRow getNearestRow(size_t pixelSize);
+
+/** @return the bilinear resampling kernel for the given format. */
+ResampleRow getBilinearRow(ColorFormat format);
+
+/**
+ * @return the strided store kernel for the given pixel size in bytes, or 0 if
+ *         the pixel size is not supported.
+ */
+StridedRow getScatterRow(size_t pixelSize, SIMD simd = getSIMD());
+
+/**
+ * @return the strided load kernel for the given pixel size in bytes, or 0 if
+ *         the pixel size is not supported.
+ */
+StridedRow getGatherRow(size_t pixelSize, SIMD simd = getSIMD());
+
+/** @return the accumulation kernel for the given format. */
+AccumRow getAccumRow(ColorFormat format, SIMD simd = getSIMD());
+
+/** @return the accumulation return kernel for the given format. */
+ReturnRow getReturnRow(ColorFormat format, SIMD simd = getSIMD());
+
+/** @return the foreground test kernel. */
+EQ_API OccupiedRow getOccupiedRow(SIMD simd = getSIMD());
+}
+}
+}
+
+#endif // EQ_DETAIL_COMPOSITORKERNELS_H
@@ -0,0 +1,173 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorSelector.h"
+
+#include <eq/image.h>
+
+#include <pression/plugin.h>
+#include <pression/pluginRegistry.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+/** The weight of a new measurement in the moving averages. */
+const float _weight = 0.25f;
+
+/** Retry the compressor with the oldest measurement every nth image. */
+const uint64_t _retryInterval = 16;
+
+/** Smaller sends measure the latency, not the bandwidth of the link. */
+const uint64_t _minSendSize = 65536;
+
+/** The bandwidth assumed for links of unknown speed, in KB/s. */
+const int64_t _defaultBandwidth = 131072;
+
+/** The shortest measurable time, in ms. */
+const float _minTime = 0.001f;
+
+float _average(const float value, const float sample)
+{
+    return value + _weight * (sample - value);
+}
+}
+
+CompressorSelector::CompressorSelector(const int64_t bandwidth)
+    : _bandwidth(float(bandwidth > 0 ? bandwidth : _defaultBandwidth) * 1.024f)
+    , _nChoices(0)
+{
+}
+
+uint32_t CompressorSelector::choose(const std::vector<uint32_t>& candidates,
+                                    const uint64_t size,
+                                    const uint32_t compressed)
+{
+    ++_nChoices;
+    for (const uint32_t name : candidates)
+        if (_estimates.find(name) == _estimates.end())
+            return name; // measure first
+
+    uint32_t best = EQ_COMPRESSOR_NONE;
+    float bestTime = getTransferTime(EQ_COMPRESSOR_NONE, size, false);
+    for (const uint32_t name : candidates)
+    {
+        const float time = getTransferTime(name, size, name == compressed);
+        if (time < bestTime)
+        {
+            best = name;
+            bestTime = time;
+        }
+    }
+
+    if (_nChoices % _retryInterval == 0)
+    {
+        const uint32_t oldest = _findOldest(candidates, best);
+        if (oldest != EQ_COMPRESSOR_NONE)
+            return oldest;
+    }
+    return best;
+}
+
+void CompressorSelector::addCompression(const uint32_t name,
+                                        const uint64_t size,
+                                        const uint64_t compressedSize,
+                                        const float time)
+{
+    if (size == 0 || name == EQ_COMPRESSOR_NONE)
+        return;
+
+    const float speed = float(size) / std::max(time, _minTime);
+    const float ratio = float(compressedSize) / float(size);
+
+    auto i = _estimates.find(name);
+    if (i == _estimates.end())
+    {
+        const Estimate estimate = {speed, ratio, _nChoices};
+        _estimates[name] = estimate;
+        return;
+    }
+
+    Estimate& estimate = i->second;
+    estimate.speed = _average(estimate.speed, speed);
+    estimate.ratio = _average(estimate.ratio, ratio);
+    estimate.updated = _nChoices;
+}
+
+void CompressorSelector::addTransmission(const uint64_t size, const float time)
+{
+    if (size >= _minSendSize)
+        _bandwidth =
+            _average(_bandwidth, float(size) / std::max(time, _minTime));
+}
+
+float CompressorSelector::getTransferTime(const uint32_t name,
+                                          const uint64_t size,
+                                          const bool compressed) const
+{
+    if (name == EQ_COMPRESSOR_NONE)
+        return float(size) / _bandwidth;
+
+    auto i = _estimates.find(name);
+    if (i == _estimates.end())
+        return 0.f;
+
+    const Estimate& estimate = i->second;
+    const float coding = float(size) / estimate.speed;
+    const float send = float(size) * estimate.ratio / _bandwidth;
+    return (compressed ? coding : 2.f * coding) + send;
+}
+
+std::vector<uint32_t> CompressorSelector::findCandidates(
+    const Image& image, const Frame::Buffer buffer)
+{
+    const pression::PluginRegistry& registry =
+        pression::PluginRegistry::getInstance();
+    const float quality = image.getQuality(buffer);
+
+    std::vector<uint32_t> candidates;
+    for (const uint32_t name : image.findCompressors(buffer))
+    {
+        const pression::Plugin* plugin = registry.findPlugin(name);
+        if (plugin && plugin->findInfo(name).quality >= quality)
+            candidates.push_back(name);
+    }
+    return candidates;
+}
+
+uint32_t CompressorSelector::_findOldest(
+    const std::vector<uint32_t>& candidates, const uint32_t exclude) const
+{
+    uint32_t oldest = EQ_COMPRESSOR_NONE;
+    uint64_t updated = _nChoices;
+    for (const uint32_t name : candidates)
+    {
+        auto i = _estimates.find(name);
+        if (name != exclude && i != _estimates.end() &&
+            i->second.updated < updated)
+        {
+            oldest = name;
+            updated = i->second.updated;
+        }
+    }
+    return oldest;
+}
+}
+}
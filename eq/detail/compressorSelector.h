@@ -0,0 +1,105 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_COMPRESSORSELECTOR_H
+#define EQ_DETAIL_COMPRESSORSELECTOR_H
+
+#include <eq/api.h>
+#include <eq/frame.h> // Frame::Buffer
+#include <eq/types.h>
+
+#include <map>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Selects the compressor for the images transmitted over one link.
+ *
+ * The selector tracks the achieved send bandwidth of the link, and the
+ * compression speed and ratio of each compressor used on it. For each image
+ * it chooses the compressor, or none, with the smallest expected transfer
+ * time, that is, the time to compress, send and decompress the image. The
+ * receiver decompresses the data, so the decompression speed is assumed to be
+ * the measured compression speed.
+ *
+ * All estimates are moving averages, updated with each transmitted image.
+ * Compressors without measurements are tried once, and every few images the
+ * compressor with the oldest measurement is tried again, so that the choice
+ * follows changes of the load and of the image content.
+ */
+class CompressorSelector
+{
+public:
+    /** Construct a new selector for a link of the given nominal bandwidth. */
+    EQ_API explicit CompressorSelector(int64_t bandwidth = 0);
+
+    /**
+     * Choose the compressor for the next image.
+     *
+     * @param candidates the compressors applicable to the image.
+     * @param size the uncompressed size of the image in bytes.
+     * @param compressed the compressor of already compressed image data, or
+     *                   EQ_COMPRESSOR_NONE.
+     * @return the compressor to use, or EQ_COMPRESSOR_NONE.
+     */
+    EQ_API uint32_t choose(const std::vector<uint32_t>& candidates,
+                           uint64_t size, uint32_t compressed);
+
+    /**
+     * Add a measurement of the compressor used for an image.
+     *
+     * A compressor which did not produce compressed data is measured with
+     * the uncompressed size, so that it is not chosen again until retried.
+     */
+    EQ_API void addCompression(uint32_t name, uint64_t size,
+                               uint64_t compressedSize, float time);
+
+    /** Add a measurement of the time used to send the given bytes. */
+    EQ_API void addTransmission(uint64_t size, float time);
+
+    /** @return the estimated send bandwidth of the link in bytes per ms. */
+    float getBandwidth() const { return _bandwidth; }
+
+    /** @return the expected transfer time in ms of the given compressor. */
+    EQ_API float getTransferTime(uint32_t name, uint64_t size,
+                                 bool compressed) const;
+
+    /** @return the compressors applicable to the image buffer. */
+    static std::vector<uint32_t> findCandidates(const Image& image,
+                                                Frame::Buffer buffer);
+
+private:
+    struct Estimate
+    {
+        float speed;      //!< uncompressed bytes per ms
+        float ratio;      //!< compressed to uncompressed size
+        uint64_t updated; //!< the choice of the last measurement
+    };
+
+    std::map<uint32_t, Estimate> _estimates;
+    float _bandwidth; //!< sent bytes per ms
+    uint64_t _nChoices;
+
+    uint32_t _findOldest(const std::vector<uint32_t>& candidates,
+                         uint32_t exclude) const;
+};
+}
+}
+
+#endif // EQ_DETAIL_COMPRESSORSELECTOR_H
@@ -0,0 +1,297 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "deltaImage.h"
+
+#include <eq/log.h>
+#include <eq/util/threadPool.h>
+
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace eq
+{
+namespace detail
+{
+const int32_t DeltaImage::tileSize;
+
+namespace
+{
+/** The geometry of a tile of the image. */
+struct Tile
+{
+    Tile(const PixelViewport& pvp, const int32_t x_, const int32_t y_)
+        : x(x_ * DeltaImage::tileSize)
+        , y(y_ * DeltaImage::tileSize)
+        , w(std::min(DeltaImage::tileSize, pvp.w - x))
+        , h(std::min(DeltaImage::tileSize, pvp.h - y))
+    {
+    }
+
+    const int32_t x;
+    const int32_t y;
+    const int32_t w;
+    const int32_t h;
+};
+
+int32_t _getNumTiles(const int32_t size)
+{
+    return (size + DeltaImage::tileSize - 1) / DeltaImage::tileSize;
+}
+
+/** Copy the rows of a tile from the image to the packed tiles. */
+void _packTile(const Tile& tile, const size_t rowSize, const size_t pixelSize,
+               const uint8_t* image, uint8_t* packed)
+{
+    const size_t packedRowSize = DeltaImage::tileSize * pixelSize;
+    for (int32_t y = 0; y < tile.h; ++y)
+        ::memcpy(packed + y * packedRowSize,
+                 image + (tile.y + y) * rowSize + tile.x * pixelSize,
+                 tile.w * pixelSize);
+}
+
+/** Copy the rows of a packed tile to the image. */
+void _unpackTile(const Tile& tile, const size_t rowSize,
+                 const size_t pixelSize, const uint8_t* packed, uint8_t* image)
+{
+    const size_t packedRowSize = DeltaImage::tileSize * pixelSize;
+    for (int32_t y = 0; y < tile.h; ++y)
+        ::memcpy(image + (tile.y + y) * rowSize + tile.x * pixelSize,
+                 packed + y * packedRowSize, tile.w * pixelSize);
+}
+}
+
+DeltaImage::DeltaImage(const Frame::Buffer buffer)
+    : _buffer(buffer)
+    , _nChanged(0)
+    , _nDeltas(0)
+    , _sequence(0)
+{
+    _packed.setAlphaUsage(true);
+}
+
+DeltaImage::~DeltaImage()
+{
+    flush();
+}
+
+bool DeltaImage::encode(const PixelData& data, const uint32_t interval)
+{
+    LBASSERT(data.pixels);
+    ++_sequence;
+    if (!_matches(data.pvp, data) || ++_nDeltas > interval)
+    {
+        setReference(data);
+        return false;
+    }
+
+    // compare and update the reference tile by tile, rows of tiles in
+    // parallel
+    const PixelViewport& pvp = data.pvp;
+    const int32_t nTilesX = _getNumTiles(pvp.w);
+    const int32_t nTilesY = _getNumTiles(pvp.h);
+    const size_t rowSize = pvp.w * data.pixelSize;
+    const uint8_t* pixels = static_cast<const uint8_t*>(data.pixels);
+    uint8_t* reference = _pixels.data();
+
+    _changed.assign(size_t(nTilesX) * nTilesY, 0);
+    util::ThreadPool::getInstance().parallelFor(
+        0, nTilesY, 1, [&](const int64_t begin, const int64_t end) {
+            for (int32_t ty = int32_t(begin); ty < int32_t(end); ++ty)
+            {
+                for (int32_t tx = 0; tx < nTilesX; ++tx)
+                {
+                    const Tile tile(pvp, tx, ty);
+                    const size_t offset = tile.x * data.pixelSize;
+                    const size_t size = tile.w * data.pixelSize;
+                    for (int32_t y = tile.y; y < tile.y + tile.h; ++y)
+                    {
+                        const size_t row = y * rowSize + offset;
+                        if (::memcmp(pixels + row, reference + row, size) != 0)
+                        {
+                            _changed[ty * nTilesX + tx] = 1;
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+    _tiles.assign(getNumWords(pvp), 0);
+    _nChanged = std::count(_changed.begin(), _changed.end(), 1);
+    if (_nChanged == 0)
+        return true;
+
+    PixelData packed;
+    packed.internalFormat = data.internalFormat;
+    packed.externalFormat = data.externalFormat;
+    packed.pixelSize = data.pixelSize;
+    packed.pvp = getPackedPVP(_nChanged);
+
+    std::vector<uint8_t> packedPixels(packed.pvp.getArea() * data.pixelSize);
+    const size_t tileSize_ = tileSize * tileSize * data.pixelSize;
+    size_t index = 0;
+    for (size_t i = 0; i < _changed.size(); ++i)
+    {
+        if (!_changed[i])
+            continue;
+
+        _tiles[i / 64] |= uint64_t(1) << (i % 64);
+        const Tile tile(pvp, int32_t(i % nTilesX), int32_t(i / nTilesX));
+        uint8_t* packedTile = packedPixels.data() + index * tileSize_;
+        _packTile(tile, rowSize, data.pixelSize, pixels, packedTile);
+        _unpackTile(tile, rowSize, data.pixelSize, packedTile, reference);
+        ++index;
+    }
+
+    packed.pixels = packedPixels.data();
+    _packed.setPixelViewport(packed.pvp);
+    _packed.setPixelData(_buffer, packed);
+    return true;
+}
+
+const PixelData& DeltaImage::compress(const uint32_t name)
+{
+    LBASSERT(_nChanged > 0);
+    _packed.useCompressor(_buffer, name);
+    if (name == EQ_COMPRESSOR_NONE)
+        return _packed.getPixelData(_buffer);
+    return _packed.compressPixelData(_buffer);
+}
+
+bool DeltaImage::decode(const PixelViewport& pvp, const uint64_t* tiles,
+                        const size_t nWords, const PixelData& payload)
+{
+    if (!_matches(pvp, payload) || nWords != getNumWords(pvp))
+        return false;
+
+    const int32_t nTilesX = _getNumTiles(pvp.w);
+    const size_t nTiles = size_t(nTilesX) * _getNumTiles(pvp.h);
+    _nChanged = countTiles(tiles, nWords);
+    if (_nChanged == 0)
+        return true;
+    if (payload.pvp != getPackedPVP(_nChanged))
+        return false;
+
+    const uint8_t* packedPixels = static_cast<const uint8_t*>(payload.pixels);
+    if (payload.compressedData.isCompressed())
+    {
+        _packed.setPixelViewport(payload.pvp);
+        _packed.setPixelData(_buffer, payload);
+        if (!_packed.hasPixelData(_buffer))
+            return false;
+        packedPixels = _packed.getPixelPointer(_buffer);
+    }
+
+    const size_t pixelSize = payload.pixelSize;
+    const size_t rowSize = pvp.w * pixelSize;
+    const size_t tileSize_ = tileSize * tileSize * pixelSize;
+    size_t index = 0;
+    for (size_t i = 0; i < nTiles; ++i)
+    {
+        if (!(tiles[i / 64] & (uint64_t(1) << (i % 64))))
+            continue;
+
+        const Tile tile(pvp, int32_t(i % nTilesX), int32_t(i / nTilesX));
+        _unpackTile(tile, rowSize, pixelSize,
+                    packedPixels + index * tileSize_, _pixels.data());
+        ++index;
+    }
+    return true;
+}
+
+bool DeltaImage::receive(Image& image, const PixelViewport& pvp,
+                         const uint64_t* tiles, const size_t nWords,
+                         const PixelData& data, const uint32_t sequence)
+{
+    if (!tiles)
+    {
+        image.setPixelData(_buffer, data);
+        if (!image.hasPixelData(_buffer))
+        {
+            flush();
+            return false;
+        }
+        setReference(image.getPixelData(_buffer));
+        _sequence = sequence;
+        return true;
+    }
+
+    // a delta only applies to the image it was encoded against
+    if (sequence == _sequence + 1 && decode(pvp, tiles, nWords, data))
+    {
+        image.setPixelData(_buffer, _reference);
+        _sequence = sequence;
+        return true;
+    }
+
+    flush();
+    return false;
+}
+
+void DeltaImage::setReference(const PixelData& data)
+{
+    LBASSERT(data.pixels);
+    _reference.internalFormat = data.internalFormat;
+    _reference.externalFormat = data.externalFormat;
+    _reference.pixelSize = data.pixelSize;
+    _reference.pvp = data.pvp;
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(data.pixels);
+    _pixels.assign(pixels, pixels + data.pvp.getArea() * data.pixelSize);
+    _reference.pixels = _pixels.data();
+    _nDeltas = 0;
+}
+
+void DeltaImage::flush()
+{
+    _reference.reset();
+    _pixels.clear();
+    _packed.flush();
+}
+
+size_t DeltaImage::getNumWords(const PixelViewport& pvp)
+{
+    const size_t nTiles = size_t(_getNumTiles(pvp.w)) * _getNumTiles(pvp.h);
+    return (nTiles + 63) / 64;
+}
+
+PixelViewport DeltaImage::getPackedPVP(const size_t nTiles)
+{
+    return PixelViewport(0, 0, tileSize, int32_t(nTiles) * tileSize);
+}
+
+size_t DeltaImage::countTiles(const uint64_t* tiles, const size_t nWords)
+{
+    size_t nTiles = 0;
+    for (size_t i = 0; i < nWords; ++i)
+        nTiles += std::bitset<64>(tiles[i]).count();
+    return nTiles;
+}
+
+bool DeltaImage::_matches(const PixelViewport& pvp,
+                          const PixelData& format) const
+{
+    return _reference.pixels && _reference.pvp == pvp &&
+           _reference.internalFormat == format.internalFormat &&
+           _reference.externalFormat == format.externalFormat &&
+           _reference.pixelSize == format.pixelSize;
+}
+}
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_DELTAIMAGE_H
+#define EQ_DETAIL_DELTAIMAGE_H
+
+#include <eq/api.h>
+#include <eq/image.h>     // member
+#include <eq/pixelData.h> // member
+
+#include <boost/noncopyable.hpp>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * The last image buffer exchanged between a source and a destination, used
+ * for the temporal delta encoding of transmitted images.
+ *
+ * The image is divided into square tiles. The source compares each image
+ * with the reference, and transmits a bitmask of the changed tiles followed
+ * by their pixels, packed as an image of one tile width. The destination
+ * applies the changed tiles to its copy of the reference. Keyframes replace
+ * the reference on both sides, and are sent when the image layout changes or
+ * after the given number of deltas. Each encoded image carries a sequence
+ * number, and the destination only applies the delta directly following its
+ * reference.
+ */
+class DeltaImage : public boost::noncopyable
+{
+public:
+    /** The edge length of the tiles in pixels. */
+    static const int32_t tileSize = 64;
+
+    EQ_API explicit DeltaImage(Frame::Buffer buffer);
+    EQ_API ~DeltaImage();
+
+    /**
+     * Encode the changed tiles of the given uncompressed pixel data.
+     *
+     * The pixel data becomes the new reference, and the sequence number is
+     * advanced.
+     *
+     * @param data the pixel data to transmit.
+     * @param interval the maximum number of deltas between keyframes.
+     * @return true if the changed tiles are to be sent, false if the pixel
+     *         data has to be sent as a keyframe.
+     */
+    EQ_API bool encode(const PixelData& data, uint32_t interval);
+
+    /**
+     * Apply the tiles of a received delta to the reference.
+     *
+     * @param pvp the pixel viewport of the image.
+     * @param tiles the bitmask of the changed tiles.
+     * @param nWords the number of bitmask words.
+     * @param payload the packed pixels of the changed tiles.
+     * @return true on success, false if the reference does not match.
+     */
+    EQ_API bool decode(const PixelViewport& pvp, const uint64_t* tiles,
+                       size_t nWords, const PixelData& payload);
+
+    /**
+     * Reconstruct a received image buffer.
+     *
+     * Keyframes are set on the image and become the reference, deltas are
+     * applied to the reference which is then set on the image. A delta not
+     * matching the reference or not following it in sequence flushes the
+     * reference, and all deltas are rejected until the next keyframe.
+     *
+     * @param image the received image.
+     * @param pvp the pixel viewport of the image.
+     * @param tiles the bitmask of the changed tiles, 0 for a keyframe.
+     * @param nWords the number of bitmask words.
+     * @param data the keyframe pixels or the packed pixels of the delta.
+     * @param sequence the sequence number of the received image.
+     * @return false if the image could not be reconstructed.
+     */
+    EQ_API bool receive(Image& image, const PixelViewport& pvp,
+                        const uint64_t* tiles, size_t nWords,
+                        const PixelData& data, uint32_t sequence);
+
+    /** Replace the reference by the given uncompressed pixel data. */
+    EQ_API void setReference(const PixelData& data);
+
+    /** @return the reference image, invalid before the first keyframe. */
+    const PixelData& getReference() const { return _reference; }
+    /** @return the sequence number of the last encoded or received image. */
+    uint32_t getSequence() const { return _sequence; }
+    /** @return the bitmask of the tiles changed by the last delta. */
+    const std::vector<uint64_t>& getTiles() const { return _tiles; }
+    /** @return the number of tiles changed by the last delta. */
+    size_t getNumChanged() const { return _nChanged; }
+    /**
+     * @return the packed pixels of the changed tiles, compressed using the
+     *         given compressor.
+     */
+    EQ_API const PixelData& compress(uint32_t name);
+
+    /** Free the reference and all plugin instances. */
+    EQ_API void flush();
+
+    /** @return the number of bitmask words for the given pixel viewport. */
+    EQ_API static size_t getNumWords(const PixelViewport& pvp);
+
+    /** @return the pixel viewport of the given number of packed tiles. */
+    EQ_API static PixelViewport getPackedPVP(size_t nTiles);
+
+    /** @return the number of tiles set in the given bitmask. */
+    EQ_API static size_t countTiles(const uint64_t* tiles, size_t nWords);
+
+private:
+    const Frame::Buffer _buffer;
+    PixelData _reference;
+    std::vector<uint8_t> _pixels; //!< the storage of the reference
+    std::vector<uint64_t> _tiles;
+    std::vector<uint8_t> _changed; //!< per-tile flags of the last delta
+    size_t _nChanged;
+    uint32_t _nDeltas;  //!< since the last keyframe
+    uint32_t _sequence; //!< of the last encoded or received image
+    Image _packed;     //!< (de)compresses the packed tiles
+
+    bool _matches(const PixelViewport& pvp, const PixelData& format) const;
+};
+}
+}
+
+#endif // EQ_DETAIL_DELTAIMAGE_H
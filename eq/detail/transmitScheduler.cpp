@@ -0,0 +1,107 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "transmitScheduler.h"
+
+#include <lunchbox/scopedMutex.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+/** The weight of a new measurement in the throughput average. */
+const float _weight = 0.25f;
+
+/** The throughput assumed before the first measurement, in bytes per ms. */
+const float _defaultThroughput = 131072.f * 1.024f;
+
+/** Smaller transmissions measure the latency, not the throughput. */
+const uint64_t _minSize = 65536;
+
+/** The shortest measurable time, in ms. */
+const float _minTime = 0.001f;
+}
+
+TransmitScheduler::TransmitScheduler()
+    : _nQueued(0)
+    , _throughput(_defaultThroughput)
+{
+}
+
+void TransmitScheduler::push(const co::ObjectVersion& frameData,
+                             const uint32_t frameNumber, const uint64_t size,
+                             const Task& task)
+{
+    lunchbox::ScopedFastWrite mutex(_queue);
+    const float deadline = _clock.getTimef() + float(size) / _throughput;
+    const Key key(frameNumber, deadline, ++_nQueued);
+    _queue->insert(std::make_pair(key, Transmission(frameData, task)));
+}
+
+bool TransmitScheduler::runNext()
+{
+    Task task;
+    {
+        lunchbox::ScopedFastWrite mutex(_queue);
+        if (_queue->empty())
+            return false;
+
+        const Queue::iterator i = _queue->begin();
+        task.swap(i->second.second);
+        _queue->erase(i);
+    }
+    _run(task);
+    return true;
+}
+
+void TransmitScheduler::run(const co::ObjectVersion& frameData)
+{
+    std::vector<Task> tasks;
+    {
+        lunchbox::ScopedFastWrite mutex(_queue);
+        for (Queue::iterator i = _queue->begin(); i != _queue->end();)
+        {
+            if (i->second.first == frameData)
+            {
+                tasks.push_back(i->second.second);
+                i = _queue->erase(i);
+            }
+            else
+                ++i;
+        }
+    }
+    for (const Task& task : tasks)
+        _run(task);
+}
+
+void TransmitScheduler::_run(const Task& task)
+{
+    const float start = _clock.getTimef();
+    const uint64_t size = task();
+    if (size < _minSize)
+        return;
+
+    const float time = std::max(_clock.getTimef() - start, _minTime);
+    lunchbox::ScopedFastWrite mutex(_queue);
+    _throughput += _weight * (float(size) / time - _throughput);
+}
+}
+}
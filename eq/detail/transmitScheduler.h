@@ -0,0 +1,93 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_TRANSMITSCHEDULER_H
+#define EQ_DETAIL_TRANSMITSCHEDULER_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+#include <co/objectVersion.h> // member
+#include <lunchbox/clock.h>    // member
+#include <lunchbox/lockable.h> // member
+#include <lunchbox/spinLock.h> // member
+
+#include <boost/noncopyable.hpp>
+#include <functional>
+#include <map>
+#include <tuple>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Orders the image transmissions of a node by their deadlines.
+ *
+ * The transmitter thread runs one queued transmission for each transmit
+ * command, not necessarily the one queued with the command. Transmissions of
+ * earlier frames go first. Within a frame, the deadline of a transmission is
+ * the time it was queued plus its expected transfer time, estimated from the
+ * throughput of the previous transmissions. Small images, e.g., the tiles of
+ * a 2D compound, thus overtake a large image queued at about the same time,
+ * while the large image is delayed at most by its own transfer time.
+ */
+class TransmitScheduler : public boost::noncopyable
+{
+public:
+    /** A transmission, returning the number of bytes sent. */
+    typedef std::function<uint64_t()> Task;
+
+    EQ_API TransmitScheduler();
+
+    /**
+     * Queue a transmission.
+     *
+     * @param frameData the frame data to transmit.
+     * @param frameNumber the frame number of the transmission.
+     * @param size the expected number of bytes to send.
+     * @param task the transmission.
+     */
+    EQ_API void push(const co::ObjectVersion& frameData,
+                     uint32_t frameNumber, uint64_t size, const Task& task);
+
+    /**
+     * Run the queued transmission with the earliest deadline.
+     *
+     * @return false if no transmission was queued.
+     */
+    EQ_API bool runNext();
+
+    /** Run all queued transmissions of the given frame data. */
+    EQ_API void run(const co::ObjectVersion& frameData);
+
+private:
+    /** frame number, deadline and queue order */
+    typedef std::tuple<uint32_t, float, uint64_t> Key;
+    typedef std::pair<co::ObjectVersion, Task> Transmission;
+    typedef std::map<Key, Transmission> Queue;
+
+    lunchbox::Lockable<Queue, lunchbox::SpinLock> _queue;
+    lunchbox::Clock _clock;
+    uint64_t _nQueued;
+    float _throughput; //!< sent bytes per ms, protected by _queue
+
+    void _run(const Task& task);
+};
+}
+}
+
+#endif // EQ_DETAIL_TRANSMITSCHEDULER_H
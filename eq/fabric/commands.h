@@ -107,6 +107,7 @@ enum NodeCommand
     CMD_NODE_FRAME_TASKS_FINISH,
     CMD_NODE_FRAMEDATA_TRANSMIT,
     CMD_NODE_FRAMEDATA_READY,
+    CMD_NODE_FRAMEDATA_KEYFRAME,
     CMD_NODE_CUSTOM
 };
 
@@ -81,6 +81,8 @@ public:
         IATTR_THREAD_MODEL,
         IATTR_LAUNCH_TIMEOUT, //!< Timeout when auto-launching the node
         IATTR_HINT_AFFINITY,
+        IATTR_HINT_THREAD_POOL,   //!< Number of CPU compositing threads
+        IATTR_HINT_SHARED_MEMORY, //!< Send images to local nodes using shm
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -119,6 +119,18 @@ void Frame::useCompressor(const Buffer buffer, const uint32_t name)
         _impl->frameData->useCompressor(buffer, name);
 }
 
+void Frame::setDeltaInterval(const uint32_t interval)
+{
+    if (_impl->frameData)
+        _impl->frameData->setDeltaInterval(interval);
+}
+
+void Frame::setCropImages(const bool crop)
+{
+    if (_impl->frameData)
+        _impl->frameData->setCropImages(crop);
+}
+
 void Frame::readback(util::ObjectManager& glObjects,
                      const DrawableConfig& config,
                      const PixelViewports& regions,
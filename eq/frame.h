@@ -97,6 +97,20 @@ public:
 
     /** Sets a compressor for compression for following transmissions. */
     EQ_API void useCompressor(const Buffer buffer, const uint32_t name);
+
+    /**
+     * Set the maximum number of delta-encoded images between keyframes.
+     * @sa FrameData::setDeltaInterval()
+     * @version 2.1
+     */
+    EQ_API void setDeltaInterval(const uint32_t interval);
+
+    /**
+     * Enable the cropping of read back images to their regions of interest.
+     * @sa FrameData::setCropImages()
+     * @version 2.1
+     */
+    EQ_API void setCropImages(const bool crop);
     //@}
 
     /** @name Operations */
@@ -21,9 +21,11 @@
 #include "frameData.h"
 
 #include "channelStatistics.h"
+#include "detail/deltaImage.h"
 #include "exception.h"
 #include "image.h"
 #include "log.h"
+#include "node.h"
 #include "nodeStatistics.h"
 #include "pixelData.h"
 #include "roiFinder.h"
@@ -32,9 +34,14 @@
 #include <co/connectionDescription.h>
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
+#include <co/iCommand.h>
+#include <co/objectOCommand.h>
+#include <eq/fabric/commands.h>
 #include <eq/fabric/drawableConfig.h>
 #include <eq/fabric/frameData.h>
 #include <eq/util/objectManager.h>
+#include <eq/util/sharedMemoryRing.h>
+#include <eq/util/threadPool.h>
 #include <lunchbox/monitor.h>
 #include <lunchbox/scopedMutex.h>
 #include <pression/plugins/compressor.h>
@@ -42,6 +49,11 @@
 #include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <tuple>
 
 namespace eq
 {
@@ -60,6 +72,9 @@ public:
         , depthQuality(1.f)
         , colorCompressor(EQ_COMPRESSOR_AUTO)
         , depthCompressor(EQ_COMPRESSOR_AUTO)
+        , deltaInterval(0)
+        , cropImages(false)
+        , deferredReady(0)
     {
     }
 
@@ -67,8 +82,6 @@ public:
     Images imageCache;
     std::mutex imageCacheLock;
 
-    ROIFinder roiFinder;
-
     Images pendingImages;
 
     uint64_t version; //!< The current version
@@ -85,6 +98,63 @@ public:
 
     uint32_t colorCompressor;
     uint32_t depthCompressor;
+
+    /** The last images sent, by destination nodes, slot and buffer. */
+    typedef std::tuple<std::vector<uint128_t>, uint32_t, unsigned> SourceKey;
+    /** The last images received, by slot and buffer. */
+    typedef std::pair<uint32_t, unsigned> TargetKey;
+    /** The last images sent to a node, by node, slot and buffer. */
+    typedef std::tuple<uint128_t, uint32_t, unsigned> ReceivedKey;
+    typedef std::unique_ptr<DeltaImage> DeltaImagePtr;
+    std::map<SourceKey, DeltaImagePtr> deltaSources; //!< transmitter thread
+    std::map<TargetKey, DeltaImagePtr> deltaTargets; //!< command thread
+    std::map<ReceivedKey, DeltaImage*> deltaReceived;
+    std::mutex deltaLock; //!< protects deltaReceived from keyframe requests
+    uint32_t deltaInterval;
+    bool cropImages;
+
+    /** Pending image decompressions per received version. */
+    std::map<uint64_t, size_t> decompressing;
+    uint64_t deferredReady; //!< version to set ready once decompressed
+    std::mutex decompressLock;
+    std::condition_variable decompressed;
+};
+
+/** A received image attachment, decompressed by the thread pool. */
+struct ReceivedPixels
+{
+    ReceivedPixels(const Frame::Buffer buffer_, const PixelData& data_)
+        : buffer(buffer_)
+        , data(data_)
+    {
+        data.pixels = data_.pixels; // not copied by PixelData
+    }
+
+    ReceivedPixels(const ReceivedPixels& rhs)
+        : buffer(rhs.buffer)
+        , data(rhs.data)
+    {
+        data.pixels = rhs.data.pixels;
+    }
+
+    const Frame::Buffer buffer;
+    PixelData data; //!< references the received command data
+};
+
+/** A received image buffer, parsed before the image is allocated. */
+struct ReceivedBuffer
+{
+    ReceivedBuffer()
+        : buffer(Frame::Buffer::none)
+        , header(0)
+        , tiles(0)
+    {
+    }
+
+    Frame::Buffer buffer;
+    const eq::FrameData::ImageHeader* header;
+    const uint64_t* tiles; //!< the changed tiles of a delta, or 0
+    PixelData data;        //!< references the received command data
 };
 }
 
@@ -149,6 +219,64 @@ void FrameData::useCompressor(const Frame::Buffer buffer, const uint32_t name)
     _impl->colorCompressor = name;
 }
 
+void FrameData::setDeltaInterval(const uint32_t interval)
+{
+    _impl->deltaInterval = interval;
+}
+
+uint32_t FrameData::getDeltaInterval() const
+{
+    return _impl->deltaInterval;
+}
+
+void FrameData::setCropImages(const bool crop)
+{
+    _impl->cropImages = crop;
+}
+
+bool FrameData::getCropImages() const
+{
+    return _impl->cropImages;
+}
+
+detail::DeltaImage& FrameData::getDeltaImage(
+    const std::vector<uint128_t>& nodes, const uint32_t slot,
+    const Frame::Buffer buffer)
+{
+    const detail::FrameData::SourceKey key(nodes, slot, unsigned(buffer));
+    detail::FrameData::DeltaImagePtr& image = _impl->deltaSources[key];
+    if (!image)
+        image.reset(new detail::DeltaImage(buffer));
+
+    // A node which received the slot from another set of nodes since the last
+    // image of this set, or which requested a keyframe, needs a keyframe.
+    // Flushing the reference forces it.
+    std::lock_guard<std::mutex> lock(_impl->deltaLock);
+    for (const uint128_t& node : nodes)
+    {
+        const detail::FrameData::ReceivedKey nodeKey(node, slot,
+                                                     unsigned(buffer));
+        detail::DeltaImage*& received = _impl->deltaReceived[nodeKey];
+        if (received != image.get())
+        {
+            image->flush();
+            received = image.get();
+        }
+    }
+    return *image;
+}
+
+void FrameData::requestKeyframe(const uint128_t& node, const uint32_t slot)
+{
+    std::lock_guard<std::mutex> lock(_impl->deltaLock);
+    for (const Frame::Buffer buffer :
+         {Frame::Buffer::color, Frame::Buffer::depth})
+    {
+        _impl->deltaReceived.erase(
+            detail::FrameData::ReceivedKey(node, slot, unsigned(buffer)));
+    }
+}
+
 void FrameData::getInstanceData(co::DataOStream& os)
 {
     LBUNREACHABLE;
@@ -173,6 +301,7 @@ void FrameData::clear()
 
 void FrameData::flush()
 {
+    _waitDecompressed();
     clear();
 
     for (ImagesCIter i = _impl->imageCache.begin();
@@ -196,6 +325,13 @@ void FrameData::deleteGLObjects(util::ObjectManager& om)
 
 void FrameData::resetPlugins()
 {
+    _waitDecompressed();
+    _impl->deltaSources.clear();
+    _impl->deltaTargets.clear();
+    {
+        std::lock_guard<std::mutex> lock(_impl->deltaLock);
+        _impl->deltaReceived.clear();
+    }
     BOOST_FOREACH (Image* image, _impl->images)
         image->resetPlugins();
     BOOST_FOREACH (Image* image, _impl->imageCache)
@@ -309,7 +445,7 @@ Images FrameData::startReadback(const Frame& frame,
     if( buffers & Frame::Buffer::DEPTH && frameZoom == Zoom::NONE )
         regions = _impl->roiFinder->findRegions( buffers, absPVP, frameZoom,
                                                  frame.getAssemblyStage(),
-                                                 frame.getFrameID(), glObjects);
+                                                 context, glObjects);
     else
         regions.push_back( absPVP );
 #endif
@@ -336,6 +472,77 @@ Images FrameData::startReadback(const Frame& frame,
     return images;
 }
 
+void FrameData::cropImage(Image& image, ROIFinder& finder)
+{
+    // the color of blended images is no indication of their foreground
+    if (!_impl->cropImages || _impl->deltaInterval > 0 ||
+        !image.hasPixelData(Frame::Buffer::depth))
+    {
+        return;
+    }
+
+    const PixelViewport pvp = image.getPixelViewport();
+    const Frame::Buffer buffers[] = {Frame::Buffer::color,
+                                     Frame::Buffer::depth};
+    for (const Frame::Buffer buffer : buffers)
+    {
+        if (!image.hasPixelData(buffer))
+            continue;
+
+        const PixelData& data = image.getPixelData(buffer);
+        if (data.compressedData.isCompressed() || data.pvp.w != pvp.w ||
+            data.pvp.h != pvp.h)
+        {
+            return;
+        }
+    }
+
+    PixelViewport roi;
+    const PixelViewports& regions =
+        finder.findRegions(image, 0, image.getContext());
+    for (const PixelViewport& region : regions)
+        roi.merge(region);
+    if (roi == pvp)
+        return;
+    if (!roi.hasArea()) // keep one background pixel, images are not empty
+        roi = PixelViewport(pvp.x, pvp.y, 1, 1);
+
+    LBLOG(LOG_ASSEMBLY) << "Crop image " << pvp << " to " << roi << std::endl;
+
+    // copy the rows of the cropped area of all buffers, then replace them
+    const int32_t dx = roi.x - pvp.x;
+    const int32_t dy = roi.y - pvp.y;
+    std::vector<uint8_t> pixels[2];
+    PixelData cropped[2];
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        if (!image.hasPixelData(buffers[i]))
+            continue;
+
+        const PixelData& data = image.getPixelData(buffers[i]);
+        const size_t rowSize = size_t(roi.w) * data.pixelSize;
+        const size_t stride = size_t(pvp.w) * data.pixelSize;
+        const uint8_t* src = image.getPixelPointer(buffers[i]) +
+                             dy * stride + size_t(dx) * data.pixelSize;
+
+        pixels[i].resize(rowSize * roi.h);
+        for (int32_t y = 0; y < roi.h; ++y)
+            ::memcpy(&pixels[i][y * rowSize], src + y * stride, rowSize);
+
+        cropped[i].internalFormat = data.internalFormat;
+        cropped[i].externalFormat = data.externalFormat;
+        cropped[i].pixelSize = data.pixelSize;
+        cropped[i].pvp =
+            PixelViewport(data.pvp.x + dx, data.pvp.y + dy, roi.w, roi.h);
+        cropped[i].pixels = pixels[i].data();
+    }
+
+    image.setPixelViewport(roi);
+    for (unsigned i = 0; i < 2; ++i)
+        if (cropped[i].pixels)
+            image.setPixelData(buffers[i], cropped[i]);
+}
+
 void FrameData::setVersion(const uint64_t version)
 {
     LBASSERTINFO(_impl->version <= version, _impl->version << " > " << version);
@@ -366,10 +573,20 @@ void FrameData::setReady(const co::ObjectVersion& frameData,
 
     _impl->images.swap(_impl->pendingImages);
     fabric::FrameData::operator=(data);
-    _setReady(frameData.version.low());
 
-    LBLOG(LOG_ASSEMBLY) << this << " applied v" << frameData.version.low()
-                        << std::endl;
+    const uint64_t version = frameData.version.low();
+    std::lock_guard<std::mutex> lock(_impl->decompressLock);
+    if (_impl->decompressing.count(version))
+    {
+        LBASSERT(_impl->deferredReady == 0);
+        _impl->deferredReady = version;
+        LBLOG(LOG_ASSEMBLY) << this << " applied v" << version
+                            << ", waiting for decompression" << std::endl;
+        return;
+    }
+
+    _setReady(version);
+    LBLOG(LOG_ASSEMBLY) << this << " applied v" << version << std::endl;
 }
 
 void FrameData::_setReady(const uint64_t version)
@@ -391,6 +608,51 @@ void FrameData::_setReady(const uint64_t version)
         ++(*listener);
 }
 
+void FrameData::_finishDecompression(const uint64_t version)
+{
+    std::lock_guard<std::mutex> lock(_impl->decompressLock);
+    std::map<uint64_t, size_t>::iterator i =
+        _impl->decompressing.find(version);
+    LBASSERT(i != _impl->decompressing.end());
+    if (--i->second > 0)
+        return;
+
+    _impl->decompressing.erase(i);
+    if (_impl->deferredReady == version)
+    {
+        _impl->deferredReady = 0;
+        _setReady(version);
+    }
+    _impl->decompressed.notify_all();
+}
+
+void FrameData::_waitDecompressed()
+{
+    std::unique_lock<std::mutex> lock(_impl->decompressLock);
+    _impl->decompressed.wait(lock,
+                             [this] { return _impl->decompressing.empty(); });
+}
+
+void FrameData::_dropDeltas(const uint32_t slot, const co::ICommand& command,
+                            Node* node, const uint128_t& senderID)
+{
+    for (const Frame::Buffer buffer :
+         {Frame::Buffer::color, Frame::Buffer::depth})
+    {
+        const detail::FrameData::TargetKey key(slot, unsigned(buffer));
+        auto i = _impl->deltaTargets.find(key);
+        if (i != _impl->deltaTargets.end())
+            i->second->flush();
+    }
+
+    // the sender flushes its reference of the slot for this node
+    co::NodePtr sender = command.getRemoteNode();
+    co::ObjectOCommand os(co::Connections(1, sender->getConnection()),
+                          fabric::CMD_NODE_FRAMEDATA_KEYFRAME,
+                          co::COMMANDTYPE_OBJECT, senderID, CO_INSTANCE_ALL);
+    os << getID() << node->getID() << slot;
+}
+
 void FrameData::addListener(Listener& listener)
 {
     lunchbox::ScopedFastWrite mutex(_impl->listeners);
@@ -413,71 +675,209 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
                          const PixelViewport& pvp, const Zoom& zoom,
                          const RenderContext& context,
                          const Frame::Buffer buffers_, const bool useAlpha,
-                         uint8_t* data)
+                         const co::ICommand& command, uint8_t*& data,
+                         Node* node, const uint128_t& senderID,
+                         const uint32_t frameNumber)
 {
-    LBASSERT(_impl->readyVersion < frameDataVersion.version.low());
-    if (_impl->readyVersion >= frameDataVersion.version.low())
-        return false;
-
-    Image* image = _allocImage(Frame::TYPE_MEMORY, DrawableConfig(),
-                               false /* set quality */);
-
-    image->setPixelViewport(pvp);
-    image->setAlphaUsage(useAlpha);
+    const uint64_t version = frameDataVersion.version.low();
+    LBASSERT(_impl->readyVersion < version);
+
+    // parse the headers of all buffers first, which advances the data even if
+    // the image is dropped and collects the shared memory regions to release
+    detail::ReceivedBuffer parsed[2];
+    unsigned nParsed = 0;
+    std::vector<std::pair<util::SharedMemoryRing*,
+                          util::SharedMemoryRing::Region>>
+        shared;
+    uint32_t plugins[2] = {EQ_COMPRESSOR_NONE, EQ_COMPRESSOR_NONE};
+    uint64_t rawSize = 0;
+    uint64_t dataSize = 0;
+    bool isValid = true;
 
     Frame::Buffer buffers[] = {Frame::Buffer::color, Frame::Buffer::depth};
     for (unsigned i = 0; i < 2; ++i)
     {
         const Frame::Buffer buffer = buffers[i];
+        if (!(buffers_ & buffer))
+            continue;
+
+        detail::ReceivedBuffer& received = parsed[nParsed++];
+        const ImageHeader* header = reinterpret_cast<ImageHeader*>(data);
+        data += sizeof(ImageHeader);
+        received.buffer = buffer;
+        received.header = header;
 
-        if (buffers_ & buffer)
+        PixelData& pixelData = received.data;
+        pixelData.internalFormat = header->internalFormat;
+        pixelData.externalFormat = header->externalFormat;
+        pixelData.pixelSize = header->pixelSize;
+        pixelData.pvp = header->pvp;
+        pixelData.compressorFlags = header->compressorFlags;
+
+        if (header->nTileWords > 0)
+        {
+            received.tiles = reinterpret_cast<const uint64_t*>(data);
+            data += header->nTileWords * sizeof(uint64_t);
+            pixelData.pvp = detail::DeltaImage::getPackedPVP(
+                detail::DeltaImage::countTiles(received.tiles,
+                                               header->nTileWords));
+        }
+
+        const uint64_t pixelSize =
+            pixelData.pvp.getArea() * pixelData.pixelSize;
+        const uint32_t compressor = header->compressorName;
+        if (header->sharedMemory)
         {
-            PixelData pixelData;
-            const ImageHeader* header = reinterpret_cast<ImageHeader*>(data);
-            data += sizeof(ImageHeader);
-
-            pixelData.internalFormat = header->internalFormat;
-            pixelData.externalFormat = header->externalFormat;
-            pixelData.pixelSize = header->pixelSize;
-            pixelData.pvp = header->pvp;
-            pixelData.compressorFlags = header->compressorFlags;
-
-            const uint32_t compressor = header->compressorName;
-            if (compressor > EQ_COMPRESSOR_NONE)
+            const util::SharedMemoryRing::Region& region =
+                *reinterpret_cast<const util::SharedMemoryRing::Region*>(data);
+            data += sizeof(region);
+
+            util::SharedMemoryRing* ring =
+                node->getReceiveRing(command.getRemoteNode()->getNodeID());
+            if (ring)
+            {
+                pixelData.pixels = const_cast<void*>(ring->getData(region));
+                shared.push_back(std::make_pair(ring, region));
+            }
+            if (!pixelData.pixels || region.size != pixelSize)
             {
-                pression::CompressorChunks chunks;
-                const uint32_t nChunks = header->nChunks;
-                chunks.reserve(nChunks);
-
-                for (uint32_t j = 0; j < nChunks; ++j)
-                {
-                    const uint64_t size = *reinterpret_cast<uint64_t*>(data);
-                    data += sizeof(uint64_t);
-
-                    chunks.push_back(pression::CompressorChunk(data, size));
-                    data += size;
-                }
-                pixelData.compressedData =
-                    pression::CompressorResult(compressor, chunks);
+                LBWARN << "Can't map " << pixelSize << " bytes of shared "
+                       << "image pixels of " << pvp << ", region has "
+                       << region.size << " bytes" << std::endl;
+                isValid = false;
             }
-            else
+            dataSize += region.size;
+        }
+        else if (compressor > EQ_COMPRESSOR_NONE)
+        {
+            const Vector2ui* stripes = reinterpret_cast<const Vector2ui*>(data);
+            pixelData.compressedStripes.assign(stripes,
+                                               stripes + header->nStripes);
+            data += header->nStripes * sizeof(Vector2ui);
+
+            pression::CompressorChunks chunks;
+            const uint32_t nChunks = header->nChunks;
+            chunks.reserve(nChunks);
+
+            for (uint32_t j = 0; j < nChunks; ++j)
             {
                 const uint64_t size = *reinterpret_cast<uint64_t*>(data);
                 data += sizeof(uint64_t);
 
-                pixelData.pixels = data;
+                chunks.push_back(pression::CompressorChunk(data, size));
                 data += size;
-                LBASSERT(size == pixelData.pvp.getArea() * pixelData.pixelSize);
+                dataSize += size;
             }
+            pixelData.compressedData =
+                pression::CompressorResult(compressor, chunks);
+            plugins[i] = compressor;
+        }
+        else
+        {
+            const uint64_t size = *reinterpret_cast<uint64_t*>(data);
+            data += sizeof(uint64_t);
 
-            image->setZoom(zoom);
-            image->setContext(context);
-            image->setQuality(buffer, header->quality);
-            image->setPixelData(buffer, pixelData);
+            pixelData.pixels = data;
+            data += size;
+            dataSize += size;
+            if (size != pixelSize)
+            {
+                LBWARN << "Got " << size << " bytes of image pixels of " << pvp
+                       << ", expected " << pixelSize << std::endl;
+                isValid = false;
+            }
+        }
+        rawSize += header->pvp.getArea() * pixelData.pixelSize;
+    }
+
+    if (!isValid || _impl->readyVersion >= version)
+    {
+        for (const auto& region : shared)
+            region.first->release(region.second);
+
+        // the following deltas of the slot refer to this image
+        if (nParsed > 0 && parsed[0].header->deltaSlot > 0)
+            _dropDeltas(parsed[0].header->deltaSlot, command, node, senderID);
+        return false;
+    }
+
+    Image* image = _allocImage(Frame::TYPE_MEMORY, DrawableConfig(),
+                               false /* set quality */);
+
+    image->setPixelViewport(pvp);
+    image->setAlphaUsage(useAlpha);
+    image->setZoom(zoom);
+    image->setContext(context);
+
+    // decompress the pixels in the thread pool
+    std::vector<detail::ReceivedPixels> received;
+    for (unsigned i = 0; i < nParsed; ++i)
+    {
+        const Frame::Buffer buffer = parsed[i].buffer;
+        const ImageHeader* header = parsed[i].header;
+        const PixelData& pixelData = parsed[i].data;
+
+        image->setQuality(buffer, header->quality);
+        if (header->deltaSlot == 0)
+        {
+            received.push_back(detail::ReceivedPixels(buffer, pixelData));
+            continue;
+        }
+
+        // deltas apply to the image last received in the same slot, so they
+        // are reconstructed here in the order of arrival
+        const uint32_t slot = header->deltaSlot;
+        const detail::FrameData::TargetKey key(slot, unsigned(buffer));
+        detail::FrameData::DeltaImagePtr& delta = _impl->deltaTargets[key];
+        if (!delta)
+            delta.reset(new detail::DeltaImage(buffer));
+
+        if (!delta->receive(*image, header->pvp, parsed[i].tiles,
+                            header->nTileWords, pixelData,
+                            header->deltaSequence))
+        {
+            LBWARN << "Can't apply image delta " << header->deltaSequence
+                   << " of " << header->pvp << ", requesting a keyframe"
+                   << std::endl;
+            {
+                std::lock_guard<std::mutex> lock(_impl->imageCacheLock);
+                _impl->imageCache.push_back(image);
+            }
+            for (const auto& region : shared)
+                region.first->release(region.second);
+            _dropDeltas(slot, command, node, senderID);
+            return false;
         }
     }
 
     _impl->pendingImages.push_back(image);
+    {
+        std::lock_guard<std::mutex> lock(_impl->decompressLock);
+        ++_impl->decompressing[version];
+    }
+
+    // The task holds a reference to this frame data and to the command, which
+    // owns the received pixel data, and releases the shared memory pixels.
+    const FrameDataPtr frameData(this);
+    const co::ICommand buffer(command);
+    const float ratio = rawSize > 0 ? float(dataSize) / float(rawSize) : 1.f;
+    util::ThreadPool::getInstance().post([frameData, buffer, image, received,
+                                          shared, node, frameNumber, version,
+                                          plugins, ratio] {
+        {
+            NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, node,
+                                 frameNumber);
+            event.statistic.plugins[0] = plugins[0];
+            event.statistic.plugins[1] = plugins[1];
+            event.statistic.ratio = ratio;
+
+            for (const detail::ReceivedPixels& pixels : received)
+                image->setPixelData(pixels.buffer, pixels.data);
+            for (const auto& region : shared)
+                region.first->release(region.second);
+        }
+        frameData->_finishDecompression(version);
+    });
     return true;
 }
 
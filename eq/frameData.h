@@ -29,8 +29,10 @@
 
 namespace eq
 {
+class ROIFinder;
 namespace detail
 {
+class DeltaImage;
 class FrameData;
 }
 
@@ -65,6 +67,19 @@ public:
         uint32_t compressorFlags;
         uint32_t nChunks;
         float quality;
+        /** Number of compressed stripes, followed by their rows and chunks. */
+        uint32_t nStripes;
+        /** Slot of the image cached for delta encoding, 0 for none. */
+        uint32_t deltaSlot;
+        /** Number of changed-tile bitmask words of a delta, followed by
+            them. 0 for full images. */
+        uint32_t nTileWords;
+        /** Sequence number of the image in its delta slot. A delta applies
+            only to the image directly preceding it. */
+        uint32_t deltaSequence;
+        /** 1 if the pixels are in the shared memory ring of the sender,
+            followed by the region instead of the data. */
+        uint32_t sharedMemory;
     };
 
     /** Construct a new frame data holder. @version 1.0 */
@@ -109,6 +124,42 @@ public:
      * @param name the compressor name.
      */
     void useCompressor(const Frame::Buffer buffer, const uint32_t name);
+
+    /**
+     * Enable the temporal delta encoding of transmitted images.
+     *
+     * Each transmitted image is compared with the image last sent to the same
+     * destination, and only the changed tiles are sent. A full keyframe is
+     * sent after the given number of deltas, and whenever the image size or
+     * format changes. This reduces the bandwidth for mostly static images,
+     * at the cost of keeping a copy of each image per destination. The
+     * default of 0 disables delta encoding.
+     *
+     * @param interval the maximum number of deltas between keyframes.
+     * @version 2.1
+     */
+    EQ_API void setDeltaInterval(uint32_t interval);
+
+    /** @return the maximum number of deltas between keyframes. @version 2.1 */
+    EQ_API uint32_t getDeltaInterval() const;
+
+    /**
+     * Enable the cropping of read back images to their regions of interest.
+     *
+     * Each image read back to main memory is reduced to the bounding box of
+     * its foreground pixels before it is assembled or transmitted. Only images
+     * with a depth buffer are cropped, where the far plane is background,
+     * since color-only images may be blended using pixels with a black color
+     * and a nonzero alpha. Images are not cropped while delta encoding is
+     * enabled, since their size would change each frame. Disabled by default.
+     *
+     * @param crop true to crop read back images.
+     * @version 2.1
+     */
+    EQ_API void setCropImages(bool crop);
+
+    /** @return true if read back images are cropped. @version 2.1 */
+    EQ_API bool getCropImages() const;
     //@}
 
     /** @name Operations */
@@ -157,6 +208,21 @@ public:
                          const PixelViewports& regions,
                          const RenderContext& context);
 
+    /**
+     * @internal
+     * Crop a read back image in main memory to its regions of interest.
+     *
+     * The image is reduced to the bounding box of its foreground pixels, as
+     * found by the CPU ROI finder, if enabled by setCropImages(). Images
+     * without depth buffer, which are zoomed or have no uncompressed pixel
+     * data are left unchanged.
+     *
+     * @param image the image to crop.
+     * @param finder the ROI finder of the channel which read back the image,
+     *               to track its statistics over the frames.
+     */
+    EQ_API void cropImage(Image& image, ROIFinder& finder);
+
     /**
      * Set the frame data ready.
      *
@@ -197,14 +263,48 @@ public:
     void removeListener(Listener& listener);
     //@}
 
-    /** @internal */
+    /**
+     * @internal
+     * Add a received image, decompressed asynchronously by the thread pool.
+     *
+     * The command holding the image data is retained until the decompression
+     * is finished, and the frame data becomes ready only after all its images
+     * have been decompressed. The data pointer is advanced past the image
+     * data, to the next image of a multi-image command, even if the image is
+     * dropped.
+     *
+     * Deltas are reconstructed from the image last received in their slot.
+     * If a delta can't be applied, or an image of a delta slot is dropped,
+     * the whole image is dropped and a keyframe is requested from the
+     * sending node.
+     *
+     * @return false if the image was dropped because its pixel data is
+     *         invalid, its delta does not apply or the frame data is already
+     *         ready. Its shared memory regions are released.
+     */
     bool addImage(const co::ObjectVersion& frameDataVersion,
                   const PixelViewport& pvp, const Zoom& zoom,
                   const RenderContext& context, const Frame::Buffer buffers,
-                  const bool useAlpha, uint8_t* data);
+                  const bool useAlpha, const co::ICommand& command,
+                  uint8_t*& data, Node* node, const uint128_t& senderID,
+                  const uint32_t frameNumber);
     void setReady(const co::ObjectVersion& frameData,
                   const fabric::FrameData& data); //!< @internal
 
+    /**
+     * @internal
+     * @return the image buffer of the given slot last sent to the given nodes.
+     */
+    detail::DeltaImage& getDeltaImage(const std::vector<uint128_t>& nodes,
+                                      const uint32_t slot,
+                                      const Frame::Buffer buffer);
+
+    /**
+     * @internal
+     * Send the next image of the given slot to the given node as a keyframe.
+     */
+    void requestKeyframe(const uint128_t& node, const uint32_t slot);
+
 protected:
     virtual ChangeType getChangeType() const { return INSTANCE; }
     virtual void getInstanceData(co::DataOStream& os);
@@ -223,6 +323,16 @@ private:
     /** Set a specific version ready. */
     void _setReady(const uint64_t version);
 
+    /** Account a finished image decompression of the given version. */
+    void _finishDecompression(const uint64_t version);
+
+    /** Wait for all pending image decompressions. */
+    void _waitDecompressed();
+
+    /** Flush the given received delta slot and request a keyframe for it. */
+    void _dropDeltas(uint32_t slot, const co::ICommand& command, Node* node,
+                     const uint128_t& senderID);
+
     LB_TS_VAR(_commandThread);
 };
 
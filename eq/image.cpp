@@ -30,8 +30,9 @@
 #include <eq/gl.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
+#include <eq/util/pixelArena.h>
+#include <eq/util/threadPool.h>
 
-#include <lunchbox/buffer.h>
 #include <lunchbox/memoryMap.h>
 #include <pression/compressor.h>
 #include <pression/decompressor.h>
@@ -40,6 +41,8 @@
 #include <pression/uploader.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/noncopyable.hpp>
+#include <deque>
 #include <fstream>
 
 #ifdef _WIN32
@@ -59,6 +62,54 @@ namespace eq
 {
 namespace
 {
+/** @internal Pixel storage drawn from the process-wide pixel arena. */
+class PixelBuffer : public boost::noncopyable
+{
+public:
+    PixelBuffer()
+        : _data(0)
+        , _size(0)
+        , _capacity(0)
+    {
+    }
+
+    ~PixelBuffer() { clear(); }
+    uint8_t* getData() { return _data; }
+    bool isEmpty() const { return _size == 0; }
+
+    /** Resize without retaining the content. */
+    void resize(const size_t size)
+    {
+        // keep the block while shrinking moderately, e.g., during load
+        // balancing, but return large blocks to the arena for other images
+        if (size <= _capacity && size >= _capacity / 4)
+        {
+            _size = size;
+            return;
+        }
+
+        clear();
+        if (size == 0)
+            return;
+        _data = static_cast<uint8_t*>(
+            util::PixelArena::getInstance().allocate(size, _capacity));
+        _size = _data ? size : 0;
+    }
+
+    void clear()
+    {
+        util::PixelArena::getInstance().release(_data);
+        _data = 0;
+        _size = 0;
+        _capacity = 0;
+    }
+
+private:
+    uint8_t* _data;
+    size_t _size;
+    size_t _capacity;
+};
+
 /** @internal Raw image data. */
 struct Memory : public PixelData
 {
@@ -72,15 +123,24 @@ public:
     Memory(const Memory& rhs)
         : PixelData(rhs)
         , state(rhs.state)
-        , localBuffer(rhs.localBuffer)
         , hasAlpha(rhs.hasAlpha)
+        , spans(rhs.spans)
     {
-        if (rhs.localBuffer.isEmpty())
+        pixels = 0;
+        if (!rhs.pixels)
+            return;
+
+        const size_t size = rhs.pvp.w * rhs.pvp.h * rhs.pixelSize;
+        localBuffer.resize(size);
+        if (!localBuffer.getData())
         {
-            const size_t size = rhs.pvp.w * rhs.pvp.h * rhs.pixelSize;
-            localBuffer.resize(size);
-            memcpy(localBuffer.getData(), rhs.pixels, size);
+            LBWARN << "Can't allocate " << size << " bytes for image copy"
+                   << std::endl;
+            state = INVALID;
+            return;
         }
+
+        memcpy(localBuffer.getData(), rhs.pixels, size);
         pixels = localBuffer.getData();
     }
 
@@ -90,6 +150,13 @@ public:
         state = INVALID;
         localBuffer.clear();
         hasAlpha = true;
+        spans.clear();
+    }
+
+    void resetCompressedData()
+    {
+        compressedData = pression::CompressorResult();
+        compressedStripes.clear();
     }
 
     void useLocalBuffer()
@@ -115,9 +182,12 @@ public:
     /** During the call of setPixelData or writeImage, we have to
      * manage an internal buffer to copy the data. Otherwise the downloader
      * allocates the memory. */
-    lunchbox::Bufferb localBuffer;
+    PixelBuffer localBuffer;
 
     bool hasAlpha; //!< The uncompressed pixels contain alpha
+
+    /** Begin and end column of the non-background pixels of each depth row. */
+    std::vector<Vector2i> spans;
 };
 
 co::DataOStream& operator<<(co::DataOStream& os, const Memory& mem)
@@ -162,6 +232,10 @@ struct Attachment
     pression::Decompressor decompressor[PLUGIN_ALL];
     pression::Downloader downloader[PLUGIN_ALL];
 
+    /** Additional plugin instances for concurrently processed stripes. */
+    std::deque<pression::Compressor> stripeCompressors;
+    std::deque<pression::Decompressor> stripeDecompressors;
+
     float quality; //!< the minimum quality
 
     /** The texture name for this image component (texture images). */
@@ -213,6 +287,12 @@ struct Attachment
         decompressor[PLUGIN_LOSSY].clear();
         downloader[PLUGIN_FULL].clear();
         downloader[PLUGIN_LOSSY].clear();
+        for (pression::Compressor& stripeCompressor : stripeCompressors)
+            stripeCompressor.clear();
+        for (pression::Decompressor& stripeDecompressor : stripeDecompressors)
+            stripeDecompressor.clear();
+        stripeCompressors.clear();
+        stripeDecompressors.clear();
     }
 };
 
@@ -225,6 +305,185 @@ co::DataIStream& operator>>(co::DataIStream& is, Attachment& at)
 {
     return is >> at.active >> at.memory >> at.quality >> at.zoom;
 }
+
+// number of pixels processed by one thread pool task
+const int64_t _grain = 65536;
+
+/** Set every stride-th value starting at offset to the given value. */
+template <typename T>
+void _fill(T* data, const int64_t nPixels, const size_t stride,
+           const size_t offset, const T value)
+{
+    util::ThreadPool::getInstance().parallelFor(
+        0, nPixels, _grain, [&](const int64_t begin, const int64_t end) {
+            for (int64_t i = begin; i < end; ++i)
+                data[i * stride + offset] = value;
+        });
+}
+
+/** Initialize RGBA pixels to zero color and the given opaque alpha value. */
+template <typename T>
+void _clearRGBA(void* pixels, const ssize_t size, const T alpha)
+{
+    T* data = reinterpret_cast<T*>(pixels);
+    lunchbox::setZero(data, size);
+    _fill(data, size / ssize_t(4 * sizeof(T)), 4, 3, alpha);
+}
+
+// minimum number of pixels of a concurrently compressed stripe
+const int64_t _minStripeArea = 131072;
+
+/** @return the number of stripes to compress the given pvp concurrently. */
+size_t _getNumStripes(const PixelViewport& pvp)
+{
+    const size_t nThreads = util::ThreadPool::getInstance().getNumThreads() + 1;
+    const size_t nStripes =
+        std::min(nThreads, size_t(int64_t(pvp.getArea()) / _minStripeArea));
+    return std::max(size_t(1), std::min(nStripes, size_t(pvp.h)));
+}
+
+/** @return the sub-pvp of the given rows of a pvp in plugin dimensions. */
+void _getStripeDims(const PixelViewport& pvp, const int32_t y,
+                    const int32_t height, uint64_t dims[4])
+{
+    const PixelViewport stripe(pvp.x, pvp.y + y, pvp.w, height);
+    stripe.convertToPlugin(dims);
+}
+
+/**
+ * Compress evenly split horizontal stripes of the memory concurrently, using
+ * the set up compressor of the active plugin for the first stripe.
+ */
+bool _compressStripes(Attachment& attachment, const size_t nStripes)
+{
+    Memory& memory = attachment.memory;
+    pression::Compressor& compressor = attachment.compressor[attachment.active];
+    const uint32_t name = compressor.getInfo().name;
+
+    while (attachment.stripeCompressors.size() + 1 < nStripes)
+        attachment.stripeCompressors.emplace_back();
+    for (size_t i = 1; i < nStripes; ++i)
+    {
+        pression::Compressor& stripeCompressor =
+            attachment.stripeCompressors[i - 1];
+        if (!stripeCompressor.uses(name) && !stripeCompressor.setup(name))
+            return false;
+    }
+
+    const PixelViewport& pvp = memory.pvp;
+    const size_t rowSize = size_t(pvp.w) * memory.pixelSize;
+    uint8_t* pixels = reinterpret_cast<uint8_t*>(memory.pixels);
+    std::vector<pression::CompressorResult> results(nStripes);
+
+    util::ThreadPool::getInstance().parallelFor(
+        0, nStripes, 1, [&](const int64_t begin, const int64_t end) {
+            for (int64_t i = begin; i < end; ++i)
+            {
+                pression::Compressor& stripeCompressor =
+                    i == 0 ? compressor : attachment.stripeCompressors[i - 1];
+                const int32_t y = int32_t(int64_t(pvp.h) * i / nStripes);
+                const int32_t next =
+                    int32_t(int64_t(pvp.h) * (i + 1) / nStripes);
+
+                uint64_t inDims[4];
+                _getStripeDims(pvp, y, next - y, inDims);
+                stripeCompressor.compress(pixels + y * rowSize, inDims,
+                                          memory.compressorFlags);
+                results[i] = stripeCompressor.getResult();
+            }
+        });
+
+    pression::CompressorChunks chunks;
+    memory.compressedStripes.resize(nStripes);
+    for (size_t i = 0; i < nStripes; ++i)
+    {
+        const pression::CompressorChunks& stripe = results[i].chunks;
+        chunks.insert(chunks.end(), stripe.begin(), stripe.end());
+
+        const int32_t y = int32_t(int64_t(pvp.h) * i / nStripes);
+        const int32_t next = int32_t(int64_t(pvp.h) * (i + 1) / nStripes);
+        memory.compressedStripes[i] =
+            Vector2ui(uint32_t(next - y), uint32_t(stripe.size()));
+    }
+    memory.compressedData = pression::CompressorResult(name, chunks);
+    return true;
+}
+
+/** @return true if the stripes of the pixel data match its pvp and chunks. */
+bool _hasValidStripes(const PixelData& pixels)
+{
+    if (pixels.compressedStripes.size() < 2)
+        return false;
+
+    uint32_t nRows = 0;
+    size_t nChunks = 0;
+    for (const Vector2ui& stripe : pixels.compressedStripes)
+    {
+        nRows += stripe.x();
+        nChunks += stripe.y();
+    }
+    return nRows == uint32_t(pixels.pvp.h) &&
+           nChunks == pixels.compressedData.chunks.size();
+}
+
+/**
+ * Decompress the stripes of the pixel data concurrently into the memory, using
+ * the set up decompressor for the first stripe.
+ */
+bool _decompressStripes(Attachment& attachment, const PixelData& pixels)
+{
+    const std::vector<Vector2ui>& stripes = pixels.compressedStripes;
+    const size_t nStripes = stripes.size();
+    const uint32_t name = pixels.compressedData.compressor;
+
+    while (attachment.stripeDecompressors.size() + 1 < nStripes)
+        attachment.stripeDecompressors.emplace_back();
+    for (size_t i = 1; i < nStripes; ++i)
+    {
+        pression::Decompressor& stripeDecompressor =
+            attachment.stripeDecompressors[i - 1];
+        if ((!stripeDecompressor.isGood() ||
+             stripeDecompressor.getInfo().name != name) &&
+            !stripeDecompressor.setup(name))
+        {
+            return false;
+        }
+    }
+
+    // first row and chunk of each stripe
+    std::vector<Vector2ui> offsets(nStripes, Vector2ui(0u, 0u));
+    for (size_t i = 1; i < nStripes; ++i)
+        offsets[i] = offsets[i - 1] + stripes[i - 1];
+
+    Memory& memory = attachment.memory;
+    const PixelViewport& pvp = memory.pvp;
+    const size_t rowSize = size_t(pvp.w) * memory.pixelSize;
+    uint8_t* data = reinterpret_cast<uint8_t*>(memory.pixels);
+    const pression::CompressorChunks& chunks = pixels.compressedData.chunks;
+
+    util::ThreadPool::getInstance().parallelFor(
+        0, nStripes, 1, [&](const int64_t begin, const int64_t end) {
+            for (int64_t i = begin; i < end; ++i)
+            {
+                pression::Decompressor& stripeDecompressor =
+                    i == 0 ? attachment.decompressor[PLUGIN_FULL]
+                           : attachment.stripeDecompressors[i - 1];
+                const uint32_t y = offsets[i].x();
+                const pression::CompressorChunks::const_iterator first =
+                    chunks.begin() + offsets[i].y();
+                const pression::CompressorResult stripe(
+                    name, pression::CompressorChunks(
+                              first, first + stripes[i].y()));
+
+                uint64_t outDims[4];
+                _getStripeDims(pvp, int32_t(y), int32_t(stripes[i].x()),
+                               outDims);
+                stripeDecompressor.decompress(stripe, data + y * rowSize,
+                                              outDims, pixels.compressorFlags);
+            }
+        });
+    return true;
+}
 }
 
 namespace detail
@@ -308,6 +567,48 @@ public:
         return getAttachment(buffer).memory;
     }
 
+    /**
+     * Index the non-background pixels of each row of the depth buffer.
+     *
+     * Called once new depth pixels are available, the CPU compositor uses the
+     * spans to skip the background of sparse sort-last images.
+     */
+    void updateSpans(const eq::Frame::Buffer buffer)
+    {
+        if (buffer != eq::Frame::Buffer::depth)
+            return;
+
+        Memory& memory = depth.memory;
+        memory.spans.clear();
+        if (memory.state != Memory::VALID || !memory.pixels ||
+            memory.externalFormat != EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT)
+        {
+            return;
+        }
+
+        const int32_t width = memory.pvp.w;
+        const int32_t height = memory.pvp.h;
+        const uint32_t* pixels =
+            reinterpret_cast<const uint32_t*>(memory.pixels);
+        memory.spans.resize(height);
+
+        util::ThreadPool::getInstance().parallelFor(
+            0, height, LB_MAX(_grain / LB_MAX(width, 1), int64_t(1)),
+            [&](const int64_t first, const int64_t last) {
+                for (int64_t y = first; y < last; ++y)
+                {
+                    const uint32_t* row = pixels + size_t(y) * width;
+                    int32_t begin = 0;
+                    while (begin < width && row[begin] == 0xFFFFFFFFu)
+                        ++begin;
+                    int32_t end = width;
+                    while (end > begin && row[end - 1] == 0xFFFFFFFFu)
+                        --end;
+                    memory.spans[y] = Vector2i(begin, end);
+                }
+            });
+    }
+
     EqCompressorInfos findTransferers(const eq::Frame::Buffer buffer,
                                       const GLEWContext* gl) const
     {
@@ -512,8 +813,8 @@ void Image::setAlphaUsage(const bool enabled)
         return;
 
     _impl->ignoreAlpha = !enabled;
-    _impl->color.memory.compressedData = pression::CompressorResult();
-    _impl->depth.memory.compressedData = pression::CompressorResult();
+    _impl->color.memory.resetCompressedData();
+    _impl->depth.memory.resetCompressedData();
 }
 
 void Image::setQuality(const Frame::Buffer buffer, const float quality)
@@ -558,7 +859,9 @@ const uint8_t* Image::getPixelPointer(const Frame::Buffer buffer) const
 uint8_t* Image::getPixelPointer(const Frame::Buffer buffer)
 {
     LBASSERT(hasPixelData(buffer));
-    return reinterpret_cast<uint8_t*>(_impl->getMemory(buffer).pixels);
+    Memory& memory = _impl->getMemory(buffer);
+    memory.spans.clear(); // pixels may be modified by the caller
+    return reinterpret_cast<uint8_t*>(memory.pixels);
 }
 
 const PixelData& Image::getPixelData(const Frame::Buffer buffer) const
@@ -567,6 +870,18 @@ const PixelData& Image::getPixelData(const Frame::Buffer buffer) const
     return _impl->getMemory(buffer);
 }
 
+const std::vector<Vector2i>& Image::getDepthSpans() const
+{
+    static const std::vector<Vector2i> none;
+    const Memory& memory = _impl->depth.memory;
+    if (memory.state != Memory::VALID || memory.pvp.w != _impl->pvp.w ||
+        memory.spans.size() != size_t(_impl->pvp.h))
+    {
+        return none;
+    }
+    return memory.spans;
+}
+
 bool Image::upload(const Frame::Buffer buffer, util::Texture* texture,
                    const Vector2i& position, util::ObjectManager& om) const
 {
@@ -640,7 +955,7 @@ bool Image::_startReadback(const Frame::Buffer buffer, const Zoom& zoom,
                            util::ObjectManager& glObjects)
 {
     Attachment& attachment = _impl->getAttachment(buffer);
-    attachment.memory.compressedData = pression::CompressorResult();
+    attachment.memory.resetCompressedData();
 
     if (_impl->type == Frame::TYPE_TEXTURE)
     {
@@ -717,6 +1032,7 @@ bool Image::startReadback(const Frame::Buffer buffer,
 
     memory.pvp.convertFromPlugin(outDims);
     attachment.memory.state = Memory::VALID;
+    _impl->updateSpans(buffer);
     return false;
 }
 
@@ -786,6 +1102,7 @@ void Image::_finishReadback(const Frame::Buffer buffer,
     downloader.finish(&memory.pixels, inDims, flags, outDims, context);
     memory.pvp.convertFromPlugin(outDims);
     memory.state = Memory::VALID;
+    _impl->updateSpans(buffer);
 }
 
 bool Image::_readbackZoom(const Frame::Buffer buffer, util::ObjectManager& om)
@@ -888,8 +1205,8 @@ void Image::setPixelViewport(const PixelViewport& pvp)
     _impl->pvp = pvp;
     _impl->color.memory.state = Memory::INVALID;
     _impl->depth.memory.state = Memory::INVALID;
-    _impl->color.memory.compressedData = pression::CompressorResult();
-    _impl->depth.memory.compressedData = pression::CompressorResult();
+    _impl->color.memory.resetCompressedData();
+    _impl->depth.memory.resetCompressedData();
 }
 
 void Image::clearPixelData(const Frame::Buffer buffer)
@@ -917,12 +1234,30 @@ void Image::clearPixelData(const Frame::Buffer buffer)
         memset_pattern4(data, &pixel, size);
 #else
         lunchbox::setZero(data, size);
-#pragma omp parallel for
-        for (ssize_t i = 3; i < size; i += 4)
-            data[i] = 255;
+        _fill(data, size / 4, 4, 3, uint8_t(255));
 #endif
         break;
     }
+
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+    {
+        // two alpha bits in GL_UNSIGNED_INT_10_10_10_2
+        _fill(reinterpret_cast<uint32_t*>(memory.pixels), size / 4, 1, 0,
+              0x3u);
+        break;
+    }
+
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+        _clearRGBA<uint16_t>(memory.pixels, size, 0x3C00u); // half 1.0
+        break;
+
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+        _clearRGBA<float>(memory.pixels, size, 1.f);
+        break;
+
     default:
         LBWARN << "Unknown external format " << memory.externalFormat
                << ", initializing to 0" << std::endl;
@@ -936,7 +1271,8 @@ void Image::validatePixelData(const Frame::Buffer buffer)
     Memory& memory = _impl->getAttachment(buffer).memory;
     memory.useLocalBuffer();
     memory.state = Memory::VALID;
-    memory.compressedData = pression::CompressorResult();
+    memory.resetCompressedData();
+    memory.spans.clear();
 }
 
 void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
@@ -947,7 +1283,7 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
     memory.pixelSize = pixels.pixelSize;
     memory.pvp = pixels.pvp;
     memory.state = Memory::INVALID;
-    memory.compressedData = pression::CompressorResult();
+    memory.resetCompressedData();
     memory.hasAlpha = false;
 
     const EqCompressorInfos& transferrers =
@@ -957,13 +1293,13 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
     else
     {
         memory.hasAlpha =
-            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
+            !(transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA);
 #ifndef NDEBUG
         for (EqCompressorInfosCIter i = transferrers.begin();
              i != transferrers.end(); ++i)
         {
             LBASSERTINFO(memory.hasAlpha ==
-                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
+                             !(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
                          "Uploaders don't agree on alpha state of external "
                              << "format: " << transferrers.front()
                              << " != " << *i);
@@ -989,6 +1325,7 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
             // no data in pixels, clear image buffer
             clearPixelData(buffer);
 
+        _impl->updateSpans(buffer);
         return;
     }
 
@@ -1016,11 +1353,23 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
     }
     validatePixelData(buffer); // alloc memory for pixels
 
-    uint64_t outDims[4];
-    memory.pvp.convertToPlugin(outDims);
+    if (pixels.compressedStripes.empty())
+    {
+        uint64_t outDims[4];
+        memory.pvp.convertToPlugin(outDims);
 
-    attachment.decompressor->decompress(pixels.compressedData, memory.pixels,
-                                        outDims, pixels.compressorFlags);
+        attachment.decompressor->decompress(pixels.compressedData,
+                                            memory.pixels, outDims,
+                                            pixels.compressorFlags);
+    }
+    else if (!_hasValidStripes(pixels) ||
+             !_decompressStripes(attachment, pixels))
+    {
+        LBWARN << "Can't decompress " << pixels.compressedStripes.size()
+               << " stripes of " << pixels.pvp << std::endl;
+        clearPixelData(buffer);
+    }
+    _impl->updateSpans(buffer);
 }
 
 /** Find and activate a compression engine */
@@ -1030,7 +1379,7 @@ bool Image::allocCompressor(const Frame::Buffer buffer, const uint32_t name)
     pression::Compressor& compressor = attachment.compressor[attachment.active];
     if (name <= EQ_COMPRESSOR_NONE)
     {
-        attachment.memory.compressedData = pression::CompressorResult();
+        attachment.memory.resetCompressedData();
         compressor.clear();
         return true;
     }
@@ -1038,7 +1387,7 @@ bool Image::allocCompressor(const Frame::Buffer buffer, const uint32_t name)
     if (compressor.uses(name))
         return true;
 
-    attachment.memory.compressedData = pression::CompressorResult();
+    attachment.memory.resetCompressedData();
     compressor.setup(name);
     LBLOG(LOG_PLUGIN) << "Instantiated compressor of type 0x" << std::hex
                       << name << std::dec << std::endl;
@@ -1087,7 +1436,13 @@ uint32_t Image::getDownloaderName(const Frame::Buffer buffer) const
 
 void Image::useCompressor(const Frame::Buffer buffer, const uint32_t name)
 {
-    _impl->getMemory(buffer).compressorName = name;
+    Memory& memory = _impl->getMemory(buffer);
+    memory.compressorName = name;
+    if (name != EQ_COMPRESSOR_AUTO && memory.compressedData.isCompressed() &&
+        memory.compressedData.compressor != name)
+    {
+        memory.resetCompressedData();
+    }
 }
 
 const PixelData& Image::compressPixelData(const Frame::Buffer buffer)
@@ -1142,10 +1497,15 @@ const PixelData& Image::compressPixelData(const Frame::Buffer buffer)
         memory.compressorFlags |= EQ_COMPRESSOR_IGNORE_ALPHA;
     }
 
+    const size_t nStripes = _getNumStripes(memory.pvp);
+    if (nStripes > 1 && _compressStripes(attachment, nStripes))
+        return memory;
+
     uint64_t inDims[4];
     memory.pvp.convertToPlugin(inDims);
     compressor.compress(memory.pixels, inDims, memory.compressorFlags);
     memory.compressedData = compressor.getResult();
+    memory.compressedStripes.clear();
     return memory;
 }
 
@@ -1801,6 +2161,7 @@ co::DataIStream& operator>>(co::DataIStream& is, Image& image)
     is >> image._impl->color >> image._impl->context >> image._impl->depth >>
         image._impl->hasPremultipliedAlpha >> image._impl->ignoreAlpha >>
         image._impl->pvp >> image._impl->type >> image._impl->zoom;
+    image._impl->updateSpans(Frame::Buffer::depth);
     return is;
 }
 }
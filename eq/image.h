@@ -148,6 +148,7 @@ public:
      *
      * The default compressor is EQ_COMPRESSOR_AUTO which selects the most
      * suitable compressor based on the current image and buffer parameters.
+     * Compressed pixel data produced by another compressor is discarded.
      *
      * @param buffer the frame buffer attachment.
      * @param name the compressor name
@@ -199,6 +200,19 @@ public:
     /** @return the pixel data. @version 1.0 */
     EQ_API const PixelData& getPixelData(const Frame::Buffer) const;
 
+    /**
+     * Get the columns of each depth row which are not background.
+     *
+     * The spans are computed when the depth pixel data is read back, set or
+     * decompressed. Each row of the depth buffer has one entry with the first
+     * and one past the last column not at the maximum depth. Accessing the
+     * non-const depth pixel pointer invalidates the spans.
+     *
+     * @return the per-row spans, or an empty vector if they are unknown.
+     * @version 2.1
+     */
+    EQ_API const std::vector<Vector2i>& getDepthSpans() const;
+
     /** @return the pixel data, compressing it if needed. @version 1.0 */
     EQ_API const PixelData& compressPixelData(const Frame::Buffer);
 
@@ -223,9 +237,10 @@ public:
     /**
      * Clear and validate an image buffer.
      *
-     * RGBA and BGRA buffers are initialized with (0,0,0,255).
-     * DEPTH_UNSIGNED_INT buffers are initialized with 255. All other buffers
-     * are zero-initialized. Validates the buffer.
+     * RGBA and BGRA buffers are initialized with (0,0,0,255), RGB10_A2,
+     * RGBA16F and RGBA32F buffers and their BGR(A) variants with a black,
+     * opaque color. DEPTH_UNSIGNED_INT buffers are initialized with 255. All
+     * other buffers are zero-initialized. Validates the buffer.
      *
      * @param buffer the image buffer to clear.
      * @version 1.0
@@ -21,6 +21,7 @@
 
 #include "client.h"
 #include "config.h"
+#include "detail/transmitScheduler.h"
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
@@ -37,13 +38,23 @@
 #include <eq/fabric/elementVisitor.h>
 #include <eq/fabric/frameData.h>
 #include <eq/fabric/task.h>
+#include <eq/util/sharedMemoryRing.h>
+#include <eq/util/threadPool.h>
 
 #include <co/barrier.h>
 #include <co/connection.h>
+#include <co/connectionDescription.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
 #include <lunchbox/scopedMutex.h>
 
+#include <memory>
+#include <sstream>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace eq
 {
 namespace
@@ -52,6 +63,51 @@ typedef std::unordered_map<uint128_t, co::Barrier*> BarrierHash;
 typedef std::unordered_map<uint128_t, FrameDataPtr> FrameDataHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
+typedef std::unique_ptr<util::SharedMemoryRing> SharedMemoryRingPtr;
+typedef std::map<co::NodeID, SharedMemoryRingPtr> SharedMemoryRings;
+
+/** The size of the shared memory ring to each local receiver. */
+const size_t _sharedMemorySize = 128 * 1024 * 1024;
+
+/** @return the name of the shared memory ring between two nodes. */
+std::string _getSegmentName(const co::NodeID& sender,
+                            const co::NodeID& receiver)
+{
+    std::ostringstream name;
+    name << "/eq." << std::hex << sender.high() << sender.low() << '.'
+         << receiver.high() << receiver.low();
+    return name.str();
+}
+
+/**
+ * @return the name of the segment announcing a node to the senders on its
+ *         host, which can map their rings only if they can open it.
+ */
+std::string _getHostSegmentName(const co::NodeID& node)
+{
+    std::ostringstream name;
+    name << "/eq." << std::hex << node.high() << node.low();
+    return name.str();
+}
+
+/** The size of the segment announcing a node, which holds no data. */
+const size_t _hostSegmentSize = 64;
+
+/** @return true if the given connection hostname is the local host. */
+bool _isLocalHost(const std::string& hostname)
+{
+    if (hostname == "localhost" || hostname == "127.0.0.1" ||
+        hostname == "::1")
+    {
+        return true;
+    }
+#ifndef _WIN32
+    char localName[256] = {0};
+    if (::gethostname(localName, sizeof(localName) - 1) == 0)
+        return hostname == localName;
+#endif
+    return false;
+}
 
 enum State
 {
@@ -115,6 +171,18 @@ public:
     lunchbox::Lockable<FrameDataHash> frameDatas;
 
     TransmitThread transmitter;
+
+    /** The order of the image transmissions of all channels. */
+    TransmitScheduler transmitScheduler;
+
+    /** Rings to local receivers, 0 for remote ones. Transmitter thread. */
+    SharedMemoryRings sendRings;
+
+    /** Rings of local senders, 0 if they can't be opened. Command thread. */
+    SharedMemoryRings receiveRings;
+
+    /** Announces this node to senders on the same host. Node thread. */
+    SharedMemoryRingPtr hostSegment;
 };
 }
 
@@ -165,6 +233,8 @@ void Node::attach(const uint128_t& id, const uint32_t instanceID)
                     NodeFunc(this, &Node::_cmdFrameDataTransmit), commandQ);
     registerCommand(fabric::CMD_NODE_FRAMEDATA_READY,
                     NodeFunc(this, &Node::_cmdFrameDataReady), commandQ);
+    registerCommand(fabric::CMD_NODE_FRAMEDATA_KEYFRAME,
+                    NodeFunc(this, &Node::_cmdFrameDataKeyframe), commandQ);
 }
 
 void Node::setDirty(const uint64_t bits)
@@ -203,6 +273,68 @@ co::CommandQueue* Node::getTransmitterQueue()
     return &_impl->transmitter.getQueue();
 }
 
+detail::TransmitScheduler& Node::getTransmitScheduler()
+{
+    return _impl->transmitScheduler;
+}
+
+util::SharedMemoryRing* Node::getSendRing(co::NodePtr receiver)
+{
+    const co::NodeID& receiverID = receiver->getNodeID();
+    SharedMemoryRings::const_iterator i = _impl->sendRings.find(receiverID);
+    if (i != _impl->sendRings.end())
+        return i->second.get();
+
+    SharedMemoryRingPtr& ring = _impl->sendRings[receiverID];
+    const int32_t hint = getIAttribute(IATTR_HINT_SHARED_MEMORY);
+    const std::string& hostname =
+        receiver->getConnection()->getDescription()->hostname;
+    if (hint != ON && (hint != AUTO || !_isLocalHost(hostname)))
+        return 0;
+
+    // only receivers sharing the shared memory of this host can map the ring,
+    // all others get the pixels inline
+    const util::SharedMemoryRing host(_getHostSegmentName(receiverID));
+    if (!host.isValid())
+    {
+        LBINFO << "Node " << receiverID << " can't map shared memory of this "
+               << "host, sending images inline" << std::endl;
+        return 0;
+    }
+
+    const std::string& name =
+        _getSegmentName(getLocalNode()->getNodeID(), receiverID);
+    ring.reset(new util::SharedMemoryRing(name, _sharedMemorySize));
+    if (!ring->isValid())
+    {
+        ring.reset();
+        return 0;
+    }
+
+    LBINFO << "Sending images to " << receiverID << " using shared memory "
+           << name << std::endl;
+    return ring.get();
+}
+
+util::SharedMemoryRing* Node::getReceiveRing(const co::NodeID& sender)
+{
+    SharedMemoryRings::const_iterator i = _impl->receiveRings.find(sender);
+    if (i != _impl->receiveRings.end())
+        return i->second.get();
+
+    // failed opens are cached, the sender creates its ring only once
+    SharedMemoryRingPtr& ring = _impl->receiveRings[sender];
+    ring.reset(new util::SharedMemoryRing(
+        _getSegmentName(sender, getLocalNode()->getNodeID())));
+    if (!ring->isValid())
+    {
+        LBWARN << "Can't receive images from " << sender
+               << " using shared memory" << std::endl;
+        ring.reset();
+    }
+    return ring.get();
+}
+
 uint32_t Node::getCurrentFrame() const
 {
     return _impl->currentFrame.get();
@@ -316,6 +448,23 @@ void Node::_setAffinity()
     }
 }
 
+void Node::_setupThreadPool()
+{
+    const int32_t size = getIAttribute(IATTR_HINT_THREAD_POOL);
+    const int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
+    const size_t nThreads =
+        size >= 0 ? size_t(size) : util::ThreadPool::getDefaultNumThreads();
+
+    // The pool threads share the socket of the node threads. A single core
+    // would serialize the pool, leave the threads unbound in this case.
+    const bool socket =
+        affinity >= fabric::SOCKET && affinity <= fabric::SOCKET_MAX;
+
+    // Keeps the process-wide pool unless a later config changes its setup,
+    // which waits for the loops of other nodes in this process.
+    util::ThreadPool::getInstance().setup(nThreads, socket ? affinity : OFF);
+}
+
 void Node::waitFrameStarted(const uint32_t frameNumber) const
 {
     _impl->currentFrame.waitGE(frameNumber);
@@ -606,6 +755,9 @@ bool Node::_cmdConfigInit(co::ICommand& cmd)
     _impl->unlockedFrame = frameNumber;
     _impl->finishedFrame = frameNumber;
     _setAffinity();
+    _setupThreadPool();
+    _impl->hostSegment.reset(new util::SharedMemoryRing(
+        _getHostSegmentName(getLocalNode()->getNodeID()), _hostSegmentSize));
 
     _impl->transmitter.start();
     const uint64_t result = configInit(initID);
@@ -637,6 +789,7 @@ bool Node::_cmdConfigExit(co::ICommand& cmd)
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
     _impl->transmitter.join();
+    _impl->hostSegment.reset();
     _flushObjects();
 
     getConfig()->send(getLocalNode(), fabric::CMD_CONFIG_DESTROY_NODE)
@@ -729,31 +882,56 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
 
     const co::ObjectVersion& frameDataVersion =
         command.read<co::ObjectVersion>();
-    const PixelViewport& pvp = command.read<PixelViewport>();
-    const Zoom& zoom = command.read<Zoom>();
-    const RenderContext& context = command.read<RenderContext>();
-    const Frame::Buffer buffers = command.read<Frame::Buffer>();
+    const uint128_t& senderID = command.read<uint128_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
-    const bool useAlpha = command.read<bool>();
-    const uint8_t* data = reinterpret_cast<const uint8_t*>(
-        command.getRemainingBuffer(command.getRemainingBufferSize()));
+    const uint32_t nImages = command.read<uint32_t>();
 
-    LBLOG(LOG_ASSEMBLY) << "received image data for " << frameDataVersion
-                        << ", buffers " << buffers << " pvp " << pvp
-                        << std::endl;
+    struct ImageInfo
+    {
+        PixelViewport pvp;
+        Zoom zoom;
+        RenderContext context;
+        Frame::Buffer buffers;
+        bool useAlpha;
+    };
+    std::vector<ImageInfo> infos(nImages);
+    for (ImageInfo& info : infos)
+    {
+        info.pvp = command.read<PixelViewport>();
+        info.zoom = command.read<Zoom>();
+        info.context = command.read<RenderContext>();
+        info.buffers = command.read<Frame::Buffer>();
+        info.useAlpha = command.read<bool>();
+    }
 
-    LBASSERT(pvp.isValid());
+    // Note on the const_cast: since the PixelData structure stores non-const
+    // pointers, we have to go non-const at some point, even though we do not
+    // modify the data.
+    uint8_t* data = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(
+        command.getRemainingBuffer(command.getRemainingBufferSize())));
 
     FrameDataPtr frameData = getFrameData(frameDataVersion);
     LBASSERT(!frameData->isReady());
 
-    NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this, frameNumber);
-
-    // Note on the const_cast: since the PixelData structure stores non-const
-    // pointers, we have to go non-const at some point, even though we do not
-    // modify the data.
-    LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
-                                useAlpha, const_cast<uint8_t*>(data)));
+    for (const ImageInfo& info : infos)
+    {
+        LBLOG(LOG_ASSEMBLY) << "received image data for " << frameDataVersion
+                            << ", buffers " << info.buffers << " pvp "
+                            << info.pvp << std::endl;
+        LBASSERT(info.pvp.isValid());
+
+        // dropped images release their shared memory, continue with the
+        // next image to release the regions of the remaining ones as well
+        if (!frameData->addImage(frameDataVersion, info.pvp, info.zoom,
+                                 info.context, info.buffers, info.useAlpha,
+                                 command, data, this, senderID,
+                                 frameNumber))
+        {
+            LBWARN << "Dropped image data for " << frameDataVersion
+                   << ", buffers " << info.buffers << " pvp " << info.pvp
+                   << std::endl;
+        }
+    }
     return true;
 }
 
@@ -776,6 +954,29 @@ bool Node::_cmdFrameDataReady(co::ICommand& cmd)
     return true;
 }
 
+bool Node::_cmdFrameDataKeyframe(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+
+    const uint128_t& frameDataID = command.read<uint128_t>();
+    const uint128_t& nodeID = command.read<uint128_t>();
+    const uint32_t slot = command.read<uint32_t>();
+
+    LBLOG(LOG_ASSEMBLY) << "keyframe request for slot " << slot << " of "
+                        << frameDataID << " from " << nodeID << std::endl;
+
+    FrameDataPtr frameData;
+    {
+        lunchbox::ScopedWrite mutex(_impl->frameDatas);
+        FrameDataHashCIter i = _impl->frameDatas->find(frameDataID);
+        if (i == _impl->frameDatas->end())
+            return true; // released since, the next one starts with keyframes
+        frameData = i->second;
+    }
+    frameData->requestKeyframe(nodeID, slot);
+    return true;
+}
+
 bool Node::_cmdSetAffinity(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
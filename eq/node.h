@@ -32,6 +32,7 @@ namespace eq
 namespace detail
 {
 class Node;
+class TransmitScheduler;
 }
 
 /**
@@ -64,9 +65,24 @@ public:
     /** @return the parent server node. @version 1.0 */
     EQ_API ServerPtr getServer();
 
-    EQ_API co::CommandQueue* getMainThreadQueue();    //!< @internal
-    EQ_API co::CommandQueue* getCommandThreadQueue(); //!< @internal
-    co::CommandQueue* getTransmitterQueue();          //!< @internal
+    EQ_API co::CommandQueue* getMainThreadQueue();     //!< @internal
+    EQ_API co::CommandQueue* getCommandThreadQueue();  //!< @internal
+    co::CommandQueue* getTransmitterQueue();           //!< @internal
+    detail::TransmitScheduler& getTransmitScheduler(); //!< @internal
+
+    /**
+     * @internal
+     * @return the shared memory ring to a receiver which can map the shared
+     *         memory of this host, or 0. Transmitter thread only.
+     */
+    util::SharedMemoryRing* getSendRing(co::NodePtr receiver);
+
+    /**
+     * @internal
+     * @return the shared memory ring of the given sender, or 0. Command
+     *         thread only.
+     */
+    util::SharedMemoryRing* getReceiveRing(const co::NodeID& sender);
 
     /** @internal node thread only. */
     uint32_t getCurrentFrame() const;
@@ -270,6 +286,7 @@ private:
     detail::Node* const _impl;
 
     void _setAffinity();
+    void _setupThreadPool();
 
     void _finishFrame(const uint32_t frameNumber) const;
     void _frameFinish(const uint128_t& frameID, const uint32_t frameNumber);
@@ -287,6 +304,7 @@ private:
     bool _cmdFrameTasksFinish(co::ICommand& command);
     bool _cmdFrameDataTransmit(co::ICommand& command);
     bool _cmdFrameDataReady(co::ICommand& command);
+    bool _cmdFrameDataKeyframe(co::ICommand& command);
     bool _cmdSetAffinity(co::ICommand& command);
 
     LB_TS_VAR(_nodeThread);
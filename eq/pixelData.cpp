@@ -34,6 +34,7 @@ PixelData::PixelData(const PixelData& rhs)
     , pixelSize(rhs.pixelSize)
     , pvp(rhs.pvp)
     , compressedData(rhs.compressedData)
+    , compressedStripes(rhs.compressedStripes)
     , compressorName(rhs.compressorName)
     , compressorFlags(rhs.compressorFlags)
 {
@@ -51,6 +52,7 @@ void PixelData::reset()
     pixelSize = 0;
     pixels = 0;
     compressedData = pression::CompressorResult();
+    compressedStripes.clear();
     compressorName = EQ_COMPRESSOR_INVALID;
     compressorFlags = 0;
 }
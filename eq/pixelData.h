@@ -90,6 +90,16 @@ struct PixelData
     /** The compressed pixel data blocks. @version 1.9.1 */
     pression::CompressorResult compressedData;
 
+    /**
+     * The independently compressed horizontal stripes of compressedData.
+     *
+     * Each entry holds the number of rows and the number of chunks of one
+     * stripe, from the bottom of the pvp. Empty if the pvp was compressed at
+     * once.
+     * @version 2.1
+     */
+    std::vector<Vector2ui> compressedStripes;
+
     /** The compressor used to produce compressedData. @version 1.0 */
     uint32_t compressorName;
 
@@ -17,6 +17,7 @@
  */
 
 #define EQ_ROI_USE_TRACKER // disable ROI in case it can't help
+#define EQ_ROI_PREDICT_INTERVAL 8 // analyse every nth frame, 0 to disable
 //#define EQ_ROI_USE_DEPTH_TEXTURE  // use depth texture instead of color
 
 #include "roiFinder.h"
@@ -27,15 +28,20 @@
 #include "roiFragmentShaderRGB_glsl.h"
 #endif
 
+#include "detail/compositorKernels.h"
 #include "gl.h"
 #include "log.h"
 
+#include <eq/fabric/renderContext.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 #include <eq/util/shader.h>
+#include <eq/util/threadPool.h>
 #include <lunchbox/os.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+
 namespace eq
 {
 #define glewGetContext glObjects.glewGetContext
@@ -46,6 +52,67 @@ static const char* shaderRBInfo = &seeds;
 
 #define GRID_SIZE 16 // will be replaced later by variable
 
+namespace
+{
+/**
+ * Sets the mask of the bits compared against the background, which excludes
+ * alpha channels and the sign of floating point color channels.
+ *
+ * @return false if the pixel format is not supported by the CPU ROI finder.
+ */
+bool _getForegroundMask(const uint32_t format, uint32_t mask[4])
+{
+    switch (format)
+    {
+    case EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT:
+        std::fill(mask, mask + 4, 0xFFFFFFFFu);
+        return true;
+    case EQ_COMPRESSOR_DATATYPE_RGBA:
+    case EQ_COMPRESSOR_DATATYPE_BGRA:
+    case EQ_COMPRESSOR_DATATYPE_RGBA_UINT_8_8_8_8_REV:
+    case EQ_COMPRESSOR_DATATYPE_BGRA_UINT_8_8_8_8_REV:
+        std::fill(mask, mask + 4, 0x00FFFFFFu);
+        return true;
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+        std::fill(mask, mask + 4, 0xFFFFFFFCu);
+        return true;
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+        mask[0] = mask[2] = 0x7FFF7FFFu;
+        mask[1] = mask[3] = 0x00007FFFu;
+        return true;
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+        std::fill(mask, mask + 3, 0x7FFFFFFFu);
+        mask[3] = 0;
+        return true;
+    case EQ_COMPRESSOR_DATATYPE_RGB32F:
+    case EQ_COMPRESSOR_DATATYPE_BGR32F:
+        std::fill(mask, mask + 4, 0x7FFFFFFFu);
+        return true;
+    default: // pixels not made of 32 bit values
+        return false;
+    }
+}
+
+/** @return the transformation from world to window coordinates. */
+Matrix4f _getWindowTransform(const RenderContext& context)
+{
+    const PixelViewport& pvp = context.pvp;
+    Matrix4f viewport;
+    viewport(0, 0) = .5f * float(pvp.w);
+    viewport(0, 3) = float(pvp.x) + .5f * float(pvp.w);
+    viewport(1, 1) = .5f * float(pvp.h);
+    viewport(1, 3) = float(pvp.y) + .5f * float(pvp.h);
+    viewport(2, 2) = .5f;
+    viewport(2, 3) = .5f;
+
+    return viewport * context.frustum.computePerspectiveMatrix() *
+           context.headTransform;
+}
+}
+
 ROIFinder::ROIFinder()
     : _dim()
     , _w(0)
@@ -620,6 +687,59 @@ void ROIFinder::_readbackInfo(util::ObjectManager& glObjects)
     texture->download(&_perBlockInfo[0]);
 }
 
+void ROIFinder::_computeInfo(const Image& image, const Frame::Buffer buffer,
+                             const uint32_t* mask)
+{
+    LBASSERT(static_cast<int32_t>(_perBlockInfo.size()) >= _w * _h * 4);
+
+    const uint32_t background =
+        buffer == Frame::Buffer::depth ? 0xFFFFFFFFu : 0u;
+    const detail::compositor::OccupiedRow occupiedRow =
+        detail::compositor::getOccupiedRow();
+
+    const size_t nValues = image.getPixelSize(buffer) / sizeof(uint32_t);
+    const size_t rowSize = size_t(_pvpOriginal.w) * nValues;
+    const uint32_t* pixels =
+        reinterpret_cast<const uint32_t*>(image.getPixelPointer(buffer));
+
+    // same statistic as the GPU: 0 for occupied, 1 for empty blocks
+    util::ThreadPool::getInstance().parallelFor(
+        0, _h, 1, [&](const int64_t begin, const int64_t end) {
+            for (int32_t by = int32_t(begin); by < int32_t(end); ++by)
+            {
+                const int32_t y0 =
+                    LB_MAX((_pvp.y + by) * GRID_SIZE, _pvpOriginal.y);
+                const int32_t y1 =
+                    LB_MIN((_pvp.y + by + 1) * GRID_SIZE,
+                           _pvpOriginal.y + _pvpOriginal.h);
+                float* info = &_perBlockInfo[by * _w * 4];
+
+                for (int32_t bx = 0; bx < _w; ++bx)
+                {
+                    const int32_t x0 =
+                        LB_MAX((_pvp.x + bx) * GRID_SIZE, _pvpOriginal.x);
+                    const int32_t x1 =
+                        LB_MIN((_pvp.x + bx + 1) * GRID_SIZE,
+                               _pvpOriginal.x + _pvpOriginal.w);
+                    const size_t offset = (x0 - _pvpOriginal.x) * nValues;
+                    const size_t size = (x1 - x0) * nValues;
+
+                    info[bx * 4] = 1.f;
+                    for (int32_t y = y0; y < y1; ++y)
+                    {
+                        const size_t row = (y - _pvpOriginal.y) * rowSize;
+                        if (occupiedRow(pixels + row + offset, size, mask,
+                                        background))
+                        {
+                            info[bx * 4] = 0.f;
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+}
+
 static PixelViewport _getBoundingPVP(const PixelViewport& pvp)
 {
     PixelViewport pvp_;
@@ -636,34 +756,82 @@ static PixelViewport _getBoundingPVP(const PixelViewport& pvp)
 PixelViewports ROIFinder::findRegions(const uint32_t buffers,
                                       const PixelViewport& pvp,
                                       const Zoom& zoom, const uint32_t stage,
-                                      const uint128_t& frameID,
+                                      const RenderContext& context,
                                       util::ObjectManager& glObjects)
 {
-    PixelViewports result;
-    result.push_back(pvp);
-
     LBLOG(LOG_ASSEMBLY) << "ROIFinder::getObjects " << pvp << ", buffers "
                         << buffers << std::endl;
 
     if (zoom != Zoom::NONE)
     {
         LBWARN << "R-B optimization impossible when zoom is used" << std::endl;
-        return result;
+        return PixelViewports(1, pvp);
+    }
+
+    // go through depth buffer and check min/max/BG values
+    // render to and read-back usefull info from FBO
+    // the prediction only selects the areas to read back
+    const uint32_t interval =
+        context.pvp.hasArea() ? EQ_ROI_PREDICT_INTERVAL : 0;
+    return _findRegions(pvp, stage, context, interval, [&] {
+        _readbackInfo(glObjects);
+        glObjects.clear();
+    });
+}
+
+PixelViewports ROIFinder::findRegions(const Image& image, const uint32_t stage,
+                                      const RenderContext& context)
+{
+    const PixelViewport& pvp = image.getPixelViewport();
+    const Frame::Buffer buffer = image.hasPixelData(Frame::Buffer::depth)
+                                     ? Frame::Buffer::depth
+                                     : Frame::Buffer::color;
+    uint32_t mask[4];
+    if (!image.hasPixelData(buffer) ||
+        !_getForegroundMask(image.getExternalFormat(buffer), mask))
+    {
+        return PixelViewports(1, pvp);
+    }
+
+    // always analysed, predicted regions would drop pixels of moving objects
+    const PixelViewports regions = _findRegions(pvp, stage, context, 0, [&] {
+        _computeInfo(image, buffer, mask);
+    });
+
+    // regions are aligned to the grid, clip them to the image
+    PixelViewports result;
+    for (PixelViewport region : regions)
+    {
+        region.intersect(pvp);
+        if (region.hasArea())
+            result.push_back(region);
     }
+    return result;
+}
+
+PixelViewports ROIFinder::_findRegions(const PixelViewport& pvp,
+                                       const uint32_t stage,
+                                       const RenderContext& context,
+                                       const uint32_t interval,
+                                       const std::function<void()>& getInfo)
+{
+    PixelViewports result;
+    result.push_back(pvp);
 
 #ifdef EQ_ROI_USE_TRACKER
     uint8_t* ticket;
-    if (!_roiTracker.useROIFinder(pvp, stage, frameID, ticket))
+    if (!_roiTracker.useROIFinder(pvp, stage, context.frameID,
+                                  _getWindowTransform(context), interval,
+                                  ticket, result))
+    {
         return result;
+    }
 #endif
 
     _pvpOriginal = pvp;
     _resize(_getBoundingPVP(pvp));
 
-    // go through depth buffer and check min/max/BG values
-    // render to and read-back usefull info from FBO
-    _readbackInfo(glObjects);
-    glObjects.clear();
+    getInfo();
 
     // Analyze readed back data and find regions of interest
     _init();
@@ -25,6 +25,8 @@
 #include "image.h"                 // member
 #include <eq/util/objectManager.h> // member
 
+#include <functional>
+
 namespace eq
 {
 /**
@@ -34,7 +36,7 @@ namespace eq
 class ROIFinder
 {
 public:
-    ROIFinder();
+    EQ_API ROIFinder();
     virtual ~ROIFinder() {}
     /**
      * Processes current rendering target and selects areas for read back.
@@ -43,16 +45,37 @@ public:
      * @param pvp       viewport to analyse.
      * @param zoom      current zoom
      * @param stage     compositing stage (to track separate statistics).
-     * @param frameID   ID of current frame (to track separate statistics).
+     * @param context   render context of the current frame (to track
+     *                  separate statistics and predict the regions).
      * @param glObjects object manager.
      *
      * @return Areas for readback
      */
     PixelViewports findRegions(const uint32_t buffers, const PixelViewport& pvp,
                                const Zoom& zoom, const uint32_t stage,
-                               const uint128_t& frameID,
+                               const RenderContext& context,
                                util::ObjectManager& glObjects);
 
+    /**
+     * Processes an image in main memory and selects its occupied areas.
+     *
+     * Uses the depth buffer of the image if available, where the far plane is
+     * background, and the color buffer otherwise, where black is background.
+     * Images without uncompressed pixel data are not analysed. The regions
+     * are never predicted, since the pixels are already read back.
+     *
+     * @param image   image to analyse.
+     * @param stage   compositing stage (to track separate statistics).
+     * @param context render context of the current frame (to track separate
+     *                statistics).
+     *
+     * @return Areas of the image pixel viewport containing all foreground
+     *         pixels.
+     */
+    EQ_API PixelViewports findRegions(const Image& image,
+                                      const uint32_t stage,
+                                      const RenderContext& context);
+
 private:
     ROIFinder(const ROIFinder&) = delete;
     ROIFinder& operator=(const ROIFinder&) = delete;
@@ -65,8 +88,24 @@ private:
         actuall read-back */
     void _readbackInfo(util::ObjectManager& glObjects);
 
+    /** Calculates the per-block statistic of _readbackInfo on the CPU from
+        the given buffer of an image in main memory, comparing the bits
+        selected by the mask against the background */
+    void _computeInfo(const Image& image, const Frame::Buffer buffer,
+                      const uint32_t* mask);
+
+    /** Finds regions of interest using the per-block statistic calculated
+        by the given function, or predicts them from the last frames for up
+        to interval frames */
+    PixelViewports _findRegions(const PixelViewport& pvp,
+                                const uint32_t stage,
+                                const RenderContext& context,
+                                uint32_t interval,
+                                const std::function<void()>& getInfo);
+
     /** Clears masks, filles per-block occupancy _mask from _perBlockInfo,
-        that was previously read-back from GPU in _readbackInfo */
+        that was previously read-back from GPU in _readbackInfo or
+        calculated in _computeInfo */
     void _init();
 
     /** Updates dimensions and resizes arrays */
@@ -138,7 +177,7 @@ private:
 
     Vectorub _mask; //!< mask of occupied blocks (main data)
 
-    std::vector<float> _perBlockInfo; //!< buffer for data from GPU
+    std::vector<float> _perBlockInfo; //!< buffer for data from GPU or CPU
 
     uint8_t _histX[256]; //!< histogram to find BB along X axis
     uint8_t _histY[256]; //!< histogram to find BB along Y axis
@@ -16,13 +16,55 @@
 
 #include "roiTracker.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace eq
 {
+namespace
+{
+/**
+ * @return the largest distance in pixels the corners of the regions move
+ *         between the two world to window transformations, or a negative
+ *         value if the motion can't be estimated.
+ */
+float _getMotion(const PixelViewports& regions, const Matrix4f& from,
+                 const Matrix4f& to)
+{
+    if (from == to)
+        return 0.f;
+
+    // corners on the near and far plane bound the motion of the geometry
+    // between them
+    const Matrix4f motion = to * from.inverse();
+    float distance = 0.f;
+    for (const PixelViewport& region : regions)
+    {
+        for (int32_t i = 0; i < 8; ++i)
+        {
+            const float x = float(i & 1 ? region.x + region.w : region.x);
+            const float y = float(i & 2 ? region.y + region.h : region.y);
+            const Vector4f corner =
+                motion * Vector4f(x, y, i & 4 ? 1.f : 0.f, 1.f);
+            if (!(corner.w() > 0.f)) // moved behind the viewer
+                return -1.f;
+
+            const float dx = corner.x() / corner.w() - x;
+            const float dy = corner.y() / corner.w() - y;
+            distance = std::max(distance, std::max(std::abs(dx), std::abs(dy)));
+        }
+    }
+    return std::isfinite(distance) ? distance : -1.f;
+}
+}
+
 ROITracker::Area::Area(const PixelViewport& pvp_, uint32_t lastSkip_,
                        uint32_t skip_)
     : pvp(pvp_)
     , lastSkip(lastSkip_)
     , skip(skip_)
+    , age(0)
+    , hasRegions(false)
 {
 }
 
@@ -50,11 +92,55 @@ bool ROITracker::_returnPositive(uint8_t*& ticket)
     return true;
 }
 
+bool ROITracker::_predict(const Area& match, const PixelViewport& pvp,
+                          const Matrix4f& transform,
+                          PixelViewports& regions) const
+{
+    const float motion = _getMotion(match.regions, match.transform, transform);
+    if (motion < 0.f)
+        return false;
+
+    const int32_t border = int32_t(std::ceil(motion));
+    uint32_t totalArea = 0;
+    PixelViewports predicted;
+    for (PixelViewport region : match.regions)
+    {
+        region.x -= border;
+        region.y -= border;
+        region.w += 2 * border;
+        region.h += 2 * border;
+        region.intersect(pvp);
+        if (!region.hasArea())
+            continue;
+
+        totalArea += region.getArea();
+        predicted.push_back(region);
+    }
+
+    // same threshold as updateDelay, overlapping regions count twice
+    if (totalArea >= pvp.getArea() * 4 / 5)
+        return false;
+
+    regions.swap(predicted);
+    return true;
+}
+
 bool ROITracker::useROIFinder(const PixelViewport& pvp, const uint32_t stage,
                               const uint128_t& frameID, uint8_t*& ticket)
+{
+    PixelViewports regions;
+    return useROIFinder(pvp, stage, frameID, Matrix4f(), 0, ticket, regions);
+}
+
+bool ROITracker::useROIFinder(const PixelViewport& pvp, const uint32_t stage,
+                              const uint128_t& frameID,
+                              const Matrix4f& transform,
+                              const uint32_t interval, uint8_t*& ticket,
+                              PixelViewports& regions)
 {
     LBASSERT(!_needsUpdate);
     ticket = 0;
+    regions = PixelViewports(1, pvp);
 
     const uint32_t pvpArea = pvp.getArea();
     if (pvpArea < 100)
@@ -77,6 +163,7 @@ bool ROITracker::useROIFinder(const PixelViewport& pvp, const uint32_t stage,
     if (_prvFrame->find(stage) == _prvFrame->end()) // new stage
     {
         curStage.areas.push_back(Area(pvp));
+        curStage.areas.back().transform = transform;
         return _returnPositive(ticket);
     }
     // else existing stage, try to find matching area
@@ -101,13 +188,28 @@ bool ROITracker::useROIFinder(const PixelViewport& pvp, const uint32_t stage,
     if (bestArea < pvpArea * 2 / 3) // no proper match found, new area
     {
         curStage.areas.push_back(Area(pvp));
+        curStage.areas.back().transform = transform;
         return _returnPositive(ticket);
     }
     // else good match
 
     if (match->skip == 0) // don't skip frame
     {
+        // reuse the regions of the last analysis if they are still valid
+        if (match->hasRegions && match->age + 1 < interval &&
+            _predict(*match, pvp, transform, regions))
+        {
+            curStage.areas.push_back(Area(pvp, match->lastSkip));
+            Area& area = curStage.areas.back();
+            area.regions = regions;
+            area.transform = transform;
+            area.age = match->age + 1;
+            area.hasRegions = true;
+            return false;
+        }
+
         curStage.areas.push_back(Area(pvp, match->lastSkip));
+        curStage.areas.back().transform = transform;
         return _returnPositive(ticket);
     }
     // else skip frame
@@ -132,6 +234,8 @@ void ROITracker::updateDelay(const PixelViewports& pvps, const uint8_t* ticket)
         totalAreaFound += pvps[i].getArea();
 
     Area& area = (*_curFrame)[_lastStage].areas.back();
+    area.regions = pvps;
+    area.hasRegions = true;
     if (totalAreaFound < area.pvp.getArea() * 4 / 5)
     {
         // ROI cutted enough, reset failure statistics
@@ -18,6 +18,7 @@
 #ifndef EQ_ROI_TRACKER_H
 #define EQ_ROI_TRACKER_H
 
+#include <eq/api.h>
 #include <eq/fabric/pixelViewport.h> // member
 #include <eq/types.h>
 
@@ -33,8 +34,8 @@ namespace eq
 class ROITracker
 {
 public:
-    ROITracker();
-    virtual ~ROITracker();
+    EQ_API ROITracker();
+    EQ_API virtual ~ROITracker();
 
     /**
      * Has to be called once before any ROI calculation. Tells wether ROIFinder
@@ -55,8 +56,36 @@ public:
      *
      * @return true if ROIFinder should be called for given region.
      */
-    bool useROIFinder(const PixelViewport& pvp, const uint32_t stage,
-                      const uint128_t& frameID, uint8_t*& ticket);
+    EQ_API bool useROIFinder(const PixelViewport& pvp, const uint32_t stage,
+                             const uint128_t& frameID, uint8_t*& ticket);
+
+    /**
+     * Same as above, but predicts the regions of interest from the last
+     * analysis of the matching area instead of requesting a new analysis.
+     *
+     * The regions found for an area are reused during the given number of
+     * frames, dilated by the largest screen-space motion of their corners
+     * caused by the change of the given transformation. The analysis is
+     * requested if no regions are known, after the interval, or if the
+     * prediction overflows, i.e., the dilated regions would not cut enough of
+     * the pvp.
+     *
+     * @param  pvp       same viewport that will be specifyed for FOIFinder
+     * @param  stage     current assembling stage
+     * @param  frameID   should be different for different frames
+     * @param  transform world to window transformation of the current frame
+     * @param  interval  maximum number of frames between two analyses, 0
+     *                   disables prediction
+     * @param  ticket    should be stored by caller and given to updateDelay
+     * @param  regions   set to the regions to use if false is returned
+     *
+     * @return true if ROIFinder should be called for given region.
+     */
+    EQ_API bool useROIFinder(const PixelViewport& pvp, const uint32_t stage,
+                             const uint128_t& frameID,
+                             const Matrix4f& transform,
+                             const uint32_t interval, uint8_t*& ticket,
+                             PixelViewports& regions);
 
     /**
      * Has to be called once after every positive result from useROIFinder.
@@ -65,12 +94,14 @@ public:
      * It checks how much space ROIFinder was able to discard and if it is not
      * enough it will disable usage of ROIFinder for several next frames. If
      * ROIFinder was able to cut-off enought it will reset failure statistics
-     * for that region.
+     * for that region. The regions are kept for the prediction of the next
+     * frames.
      *
      * @param  pvps    result from ROIFinder
      * @param  ticket  value from useROIFinder
      */
-    void updateDelay(const PixelViewports& pvps, const uint8_t* ticket);
+    EQ_API void updateDelay(const PixelViewports& pvps,
+                            const uint8_t* ticket);
 
 private:
     ROITracker(const ROITracker&) = delete;
@@ -85,6 +116,11 @@ private:
         PixelViewport pvp;
         uint32_t lastSkip; //!< Previousely skiped number of frames
         uint32_t skip;     //!< Number of frames to skip ROIFinder
+
+        PixelViewports regions; //!< Found or predicted regions of interest
+        Matrix4f transform;     //!< World to window transformation
+        uint32_t age;           //!< Number of frames since the analysis
+        bool hasRegions;        //!< regions are known
     };
     /** Set of readback areas per compositiong stage */
     struct Stage
@@ -105,6 +141,8 @@ private:
     uint32_t _lastStage;    //!< used in updateDelay to find last added area
 
     bool _returnPositive(uint8_t*& ticket);
+    bool _predict(const Area& match, const PixelViewport& pvp,
+                  const Matrix4f& transform, PixelViewports& regions) const;
 };
 }
 
@@ -180,6 +180,8 @@ protected:
     virtual void attach(const uint128_t& id, const uint32_t instanceID);
 
 private:
+    friend class Simulator; // delivers simulated load data
+
     //-------------------- Members --------------------
     /** Number of activations for this channel. */
     uint32_t _active;
@@ -309,6 +309,7 @@ public:
     {
         return _inherit.pvp;
     }
+    const Viewport& getInheritViewport() const { return _inherit.vp; }
     const Range& getInheritRange() const { return _inherit.range; }
     const Pixel& getInheritPixel() const { return _inherit.pixel; }
     const SubPixel& getInheritSubPixel() const { return _inherit.subPixel; }
@@ -27,6 +27,7 @@
 #include "../layout.h"
 #include "../node.h"
 #include "../pipe.h"
+#include "../radixK.h"
 #include "../segment.h"
 #include "../window.h"
 
@@ -205,6 +206,9 @@ void _disposeHwsdModules()
 
 static lunchbox::a_int32_t _frameCounter;
 
+// group size of the DBRadixK layout, between binary-swap and direct send
+static const uint32_t _radix = 4;
+
 bool Resources::discover(ServerPtr server, Config* config,
                          const std::string& session,
                          const fabric::ConfigParams& params)
@@ -562,6 +566,10 @@ Compound* Resources::_addMonoCompound(Compound* root, const Channels& channels,
     }
     else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_DS)
         compound = _addDSCompound(root, activeDBChannels);
+    else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_BS)
+        compound = _addRadixKCompound(root, activeDBChannels, 2);
+    else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_RADIX_K)
+        compound = _addRadixKCompound(root, activeDBChannels, _radix);
     else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_2D)
     {
         LBASSERT(!multiProcess);
@@ -694,6 +702,12 @@ Compound* Resources::_addDBCompound(Compound* root, const Channels& channels,
         compound->addEqualizer(new LoadEqualizer(params.getEqualizer()));
     }
 
+    _fillDBCompound(compound, channels);
+    return compound;
+}
+
+void Resources::_fillDBCompound(Compound* compound, const Channels& channels)
+{
     const Compounds& children = _addSources(compound, channels);
     const size_t step = size_t(100000.0f / float(children.size()));
     size_t start = 0;
@@ -707,8 +721,6 @@ Compound* Resources::_addDBCompound(Compound* root, const Channels& channels,
                 Range(float(start) / 100000.f, float(start + step) / 100000.f));
         start += step;
     }
-
-    return compound;
 }
 
 Compound* Resources::_addDSCompound(Compound* root, const Channels& channels)
@@ -798,6 +810,24 @@ Compound* Resources::_addDSCompound(Compound* root, const Channels& channels)
     return compound;
 }
 
+Compound* Resources::_addRadixKCompound(Compound* root,
+                                        const Channels& channels,
+                                        const uint32_t radix)
+{
+    const Channel* channel = root->getChannel();
+    const Layout* layout = channel->getLayout();
+    const std::string& name = layout->getName();
+
+    Compound* compound = new Compound(root);
+    compound->setName(name);
+    compound->setBuffers(Frame::Buffer::color | Frame::Buffer::depth);
+
+    _fillDBCompound(compound, channels);
+    if (compound->getChildren().size() > 1)
+        RadixK::configure(compound, radix);
+    return compound;
+}
+
 static Channels _filterLocalChannels(const Channels& input,
                                      const Compound& filter)
 {
@@ -0,0 +1,184 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "costMap.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+/** The number of bisection steps, enough for float precision. */
+const size_t _nSplitSteps = 32;
+
+/** @return the length of the overlap of [a0, a1] and [b0, b1]. */
+float _overlap(const float a0, const float a1, const float b0, const float b1)
+{
+    return std::max(0.f, std::min(a1, b1) - std::max(a0, b0));
+}
+}
+
+CostMap::CostMap(const size_t resolution, const float weight)
+    : _resolution(resolution)
+    , _weight(weight)
+    , _dirty(false)
+{
+    LBASSERT(resolution > 0);
+    clear();
+}
+
+void CostMap::clear()
+{
+    _density.assign(_resolution * _resolution, -1.f);
+    _table.assign((_resolution + 1) * (_resolution + 1), 0.);
+    _dirty = false;
+    _valid = false;
+}
+
+void CostMap::update(const Viewport& vp, const Viewport& roi, const float time)
+{
+    if (!vp.hasArea() || time < 0.f)
+        return;
+
+    Viewport area = roi;
+    area.intersect(vp);
+    if (!area.isValid() || !area.hasArea()) // nothing rendered, spread time
+        area = vp;
+    const float density = time / area.getArea();
+
+    const float size = 1.f / float(_resolution);
+    const size_t xBegin = std::min(size_t(std::max(vp.x, 0.f) / size),
+                                   _resolution - 1);
+    const size_t yBegin = std::min(size_t(std::max(vp.y, 0.f) / size),
+                                   _resolution - 1);
+    for (size_t y = yBegin; y < _resolution && y * size < vp.getYEnd(); ++y)
+    {
+        const float y0 = y * size;
+        const float y1 = y0 + size;
+        const float vpH = _overlap(y0, y1, vp.y, vp.getYEnd());
+        const float areaH = _overlap(y0, y1, area.y, area.getYEnd());
+
+        for (size_t x = xBegin; x < _resolution && x * size < vp.getXEnd();
+             ++x)
+        {
+            const float x0 = x * size;
+            const float x1 = x0 + size;
+            const float covered =
+                vpH * _overlap(x0, x1, vp.x, vp.getXEnd()) / (size * size);
+            if (covered <= 0.f)
+                continue;
+
+            // the density of the measurement within the covered part
+            const float rendered =
+                areaH * _overlap(x0, x1, area.x, area.getXEnd()) /
+                (size * size);
+            const float sample = density * rendered / covered;
+
+            float& value = _density[y * _resolution + x];
+            if (value < 0.f) // first measurement
+                value = sample;
+            else
+                value += _weight * covered * (sample - value);
+        }
+    }
+    _dirty = true;
+    _valid = true;
+}
+
+float CostMap::getCost(const Viewport& vp) const
+{
+    if (_dirty)
+        _updateTable();
+
+    const float xEnd = vp.getXEnd();
+    const float yEnd = vp.getYEnd();
+    return float(_getIntegral(xEnd, yEnd) - _getIntegral(vp.x, yEnd) -
+                 _getIntegral(xEnd, vp.y) + _getIntegral(vp.x, vp.y));
+}
+
+float CostMap::findSplit(const Viewport& vp, const bool vertical,
+                         const float fraction) const
+{
+    const float start = vertical ? vp.x : vp.y;
+    const float end = vertical ? vp.getXEnd() : vp.getYEnd();
+    const float total = getCost(vp);
+    if (total <= 0.f)
+        return start + fraction * (end - start);
+
+    // the cost of the part before the split grows monotonically
+    const float target = fraction * total;
+    float low = start;
+    float high = end;
+    for (size_t i = 0; i < _nSplitSteps; ++i)
+    {
+        const float split = .5f * (low + high);
+        Viewport part = vp;
+        if (vertical)
+            part.w = split - vp.x;
+        else
+            part.h = split - vp.y;
+
+        if (getCost(part) < target)
+            low = split;
+        else
+            high = split;
+    }
+    return .5f * (low + high);
+}
+
+double CostMap::_getIntegral(float x, float y) const
+{
+    // The cost density is constant within a tile, which makes the integral
+    // bilinear between the table entries of the tile corners.
+    const size_t n = _resolution;
+    x = std::min(std::max(x, 0.f), 1.f) * float(n);
+    y = std::min(std::max(y, 0.f), 1.f) * float(n);
+    const size_t i = std::min(size_t(x), n - 1);
+    const size_t j = std::min(size_t(y), n - 1);
+    const double tx = x - float(i);
+    const double ty = y - float(j);
+
+    const double* row0 = &_table[j * (n + 1) + i];
+    const double* row1 = row0 + n + 1;
+    return (1. - ty) * ((1. - tx) * row0[0] + tx * row0[1]) +
+           ty * ((1. - tx) * row1[0] + tx * row1[1]);
+}
+
+void CostMap::_updateTable() const
+{
+    const size_t n = _resolution;
+    const double tileArea = 1. / double(n * n);
+    for (size_t y = 0; y < n; ++y)
+    {
+        double row = 0.;
+        for (size_t x = 0; x < n; ++x)
+        {
+            row += std::max(_density[y * n + x], 0.f) * tileArea;
+            _table[(y + 1) * (n + 1) + x + 1] =
+                _table[y * (n + 1) + x + 1] + row;
+        }
+    }
+    _dirty = false;
+}
+}
+}
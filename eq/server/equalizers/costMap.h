@@ -0,0 +1,99 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQS_COSTMAP_H
+#define EQS_COSTMAP_H
+
+#include "../types.h"
+#include <eq/server/api.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * A screen-space map of the rendering cost, used by the load equalizer.
+ *
+ * The normalized viewport is divided into a grid of tiles, each storing a
+ * cost density. Every reported render time is spread uniformly over the
+ * region it was measured for, and blended into the covered tiles using an
+ * exponential moving average. Over several frames, the varying leaf regions
+ * refine the map to the actual distribution of the cost. A summed-area table
+ * over the tiles gives the cost of any viewport in constant time.
+ */
+class CostMap
+{
+public:
+    /**
+     * Construct a new cost map.
+     *
+     * @param resolution the number of tiles in each dimension.
+     * @param weight the weight of a new measurement in the moving average.
+     */
+    EQSERVER_API explicit CostMap(size_t resolution = 64, float weight = 0.25f);
+
+    /**
+     * Add the render time measured for a viewport.
+     *
+     * @param vp the viewport assigned to the measured channel.
+     * @param roi the part of vp containing all rendered pixels.
+     * @param time the time used to render the viewport.
+     */
+    EQSERVER_API void update(const Viewport& vp, const Viewport& roi,
+                             float time);
+
+    /** @return true if the map has at least one measurement. */
+    bool isValid() const { return _valid; }
+
+    /** Remove all measurements. */
+    EQSERVER_API void clear();
+
+    /** @return the cost of the given viewport. */
+    EQSERVER_API float getCost(const Viewport& vp) const;
+
+    /**
+     * Find the split position dividing the cost of a viewport.
+     *
+     * Viewports without cost are split by area.
+     *
+     * @param vp the viewport to split.
+     * @param vertical true to split along x, false to split along y.
+     * @param fraction the fraction of the cost left of, respectively below,
+     *                 the split.
+     * @return the split position in normalized coordinates.
+     */
+    EQSERVER_API float findSplit(const Viewport& vp, bool vertical,
+                                 float fraction) const;
+
+private:
+    const size_t _resolution;
+    const float _weight;
+    std::vector<float> _density; //!< per-tile cost per area, < 0 if unknown
+    mutable std::vector<double> _table; //!< summed-area table of the tiles
+    mutable bool _dirty;                //!< _table needs an update
+    bool _valid;
+
+    /** @return the cost of [0..x] x [0..y]. */
+    double _getIntegral(float x, float y) const;
+    void _updateTable() const;
+};
+}
+}
+
+#endif // EQS_COSTMAP_H
@@ -25,6 +25,8 @@
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
 
+#include <algorithm>
+
 namespace eq
 {
 namespace server
@@ -37,6 +39,7 @@ std::ostream& operator<<(std::ostream& os, const LoadEqualizer::Node*);
 
 LoadEqualizer::LoadEqualizer()
     : _tree(0)
+    , _view(0)
 {
     LBVERB << "New LoadEqualizer @" << (void*)this << std::endl;
 }
@@ -44,24 +47,52 @@ LoadEqualizer::LoadEqualizer()
 LoadEqualizer::LoadEqualizer(const fabric::Equalizer& from)
     : Equalizer(from)
     , _tree(0)
+    , _view(0)
 {
 }
 
 LoadEqualizer::~LoadEqualizer()
 {
+    attach(0);
+}
+
+void LoadEqualizer::attach(Compound* compound)
+{
+    // the tree and the load data belong to the children of the old compound
     _clearTree(_tree);
     delete _tree;
     _tree = 0;
+    _clearHistory();
 
-    _history.clear();
+    Equalizer::attach(compound);
 }
 
 void LoadEqualizer::notifyUpdatePre(Compound* compound,
                                     const uint32_t frameNumber)
 {
+    // frame numbers restart when the config is initialized again
+    if (!_history.empty() && frameNumber <= _history.back().frameNumber)
+        _clearHistory();
+
     _checkHistory(); // execute to not leak memory
-    if (isFrozen() || !compound->isActive() || !isActive())
+    if (!compound->isActive()) // e.g., layout switched away
+    {
+        _costMap.clear();
         return;
+    }
+    if (isFrozen() || !isActive())
+        return;
+
+    // the cost distribution is only valid for the measured destination
+    const Channel* channel = compound->getInheritChannel();
+    const View* view = channel ? channel->getView() : 0;
+    const PixelViewport& pvp = compound->getInheritPixelViewport();
+    if (view != _view || pvp != _pvp)
+    {
+        _costMap.clear();
+        _view = view;
+        _pvp = pvp;
+    }
 
     if (!_tree)
     {
@@ -88,7 +119,7 @@ void LoadEqualizer::notifyUpdatePre(Compound* compound,
     if (getDamping() < 1.f)
     {
         _history.push_back(LBFrameData());
-        _history.back().first = frameNumber;
+        _history.back().frameNumber = frameNumber;
     }
 
     _update(_tree, Viewport(), Range());
@@ -152,85 +183,102 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
 {
     LBLOG(LOG_LB2) << statistics.size() << " samples from "
                    << channel->getName() << " @ " << frameNumber << std::endl;
-    for (std::deque<LBFrameData>::iterator i = _history.begin();
-         i != _history.end(); ++i)
+
+    // Note: if the same channel is used twice as a child, the load-compound
+    // association does not work: only its first item is indexed.
+    LBFrameData* frameData = 0;
+    Data* item = _findData(channel, frameNumber, frameData);
+    if (!item)
+        return;
+
+    // Found corresponding historical data item
+    Data& data = *item;
+    const uint32_t taskID = data.taskID;
+    LBASSERTINFO(taskID > 0, channel->getName());
+
+    // gather relevant load data
+    int64_t startTime = std::numeric_limits<int64_t>::max();
+    int64_t endTime = 0;
+    bool loadSet = false;
+    int64_t transmitTime = 0;
+    for (size_t k = 0; k < statistics.size(); ++k)
     {
-        LBFrameData& frameData = *i;
-        if (frameData.first != frameNumber)
+        const Statistic& stat = statistics[k];
+        if (stat.task == data.destTaskID)
+            _updateAssembleTime(data, stat);
+
+        // from different compound
+        if (stat.task != taskID || loadSet)
             continue;
 
-        // Found corresponding historical data set
-        LBDatas& items = frameData.second;
-        for (LBDatas::iterator j = items.begin(); j != items.end(); ++j)
+        switch (stat.type)
         {
-            Data& data = *j;
-            if (data.channel != channel)
-                continue;
-
-            // Found corresponding historical data item
-            const uint32_t taskID = data.taskID;
-            LBASSERTINFO(taskID > 0, channel->getName());
-
-            // gather relevant load data
-            int64_t startTime = std::numeric_limits<int64_t>::max();
-            int64_t endTime = 0;
-            bool loadSet = false;
-            int64_t transmitTime = 0;
-            for (size_t k = 0; k < statistics.size(); ++k)
-            {
-                const Statistic& stat = statistics[k];
-                if (stat.task == data.destTaskID)
-                    _updateAssembleTime(data, stat);
+        case Statistic::CHANNEL_CLEAR:
+        case Statistic::CHANNEL_DRAW:
+        case Statistic::CHANNEL_READBACK:
+            startTime = LB_MIN(startTime, stat.startTime);
+            endTime = LB_MAX(endTime, stat.endTime);
+            break;
 
-                // from different compound
-                if (stat.task != taskID || loadSet)
-                    continue;
+        case Statistic::CHANNEL_ASYNC_READBACK:
+        case Statistic::CHANNEL_FRAME_TRANSMIT:
+            transmitTime += stat.endTime - stat.startTime;
+            break;
+        case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
+            transmitTime -= stat.endTime - stat.startTime;
+            break;
 
-                switch (stat.type)
-                {
-                case Statistic::CHANNEL_CLEAR:
-                case Statistic::CHANNEL_DRAW:
-                case Statistic::CHANNEL_READBACK:
-                    startTime = LB_MIN(startTime, stat.startTime);
-                    endTime = LB_MAX(endTime, stat.endTime);
-                    break;
+        // assemble blocks on input frames, stop using subsequent data
+        case Statistic::CHANNEL_ASSEMBLE:
+            loadSet = true;
+            break;
 
-                case Statistic::CHANNEL_ASYNC_READBACK:
-                case Statistic::CHANNEL_FRAME_TRANSMIT:
-                    transmitTime += stat.endTime - stat.startTime;
-                    break;
-                case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
-                    transmitTime -= stat.endTime - stat.startTime;
-                    break;
+        default:
+            break;
+        }
+    }
 
-                // assemble blocks on input frames, stop using subsequent data
-                case Statistic::CHANNEL_ASSEMBLE:
-                    loadSet = true;
-                    break;
+    if (startTime == std::numeric_limits<int64_t>::max())
+        return;
 
-                default:
-                    break;
-                }
-            }
+    if (data.time < 0)
+    {
+        LBASSERT(frameData->nPending > 0);
+        --frameData->nPending;
+    }
 
-            if (startTime == std::numeric_limits<int64_t>::max())
-                return;
-
-            data.vp.apply(region); // Update ROI
-            data.time = endTime - startTime;
-            data.time = LB_MAX(data.time, 1);
-            data.time = LB_MAX(data.time, transmitTime);
-            data.assembleTime = LB_MAX(data.assembleTime, 0);
-            LBLOG(LOG_LB2) << "Added time " << data.time << " (+"
-                           << data.assembleTime << ") for "
-                           << channel->getName() << " " << data.vp << ", "
-                           << data.range << " @ " << frameNumber << std::endl;
-            return;
+    const Viewport assigned = data.vp;
+    data.vp.apply(region); // Update ROI
+    data.time = endTime - startTime;
+    data.time = LB_MAX(data.time, 1);
+    data.time = LB_MAX(data.time, transmitTime);
+    data.assembleTime = LB_MAX(data.assembleTime, 0);
+    if (getMode() != MODE_DB)
+        _costMap.update(assigned, data.vp, float(data.time));
+    LBLOG(LOG_LB2) << "Added time " << data.time << " (+" << data.assembleTime
+                   << ") for " << channel->getName() << " " << data.vp << ", "
+                   << data.range << " @ " << frameNumber << std::endl;
+}
 
-            // Note: if the same channel is used twice as a child, the
-            // load-compound association does not work.
-        }
-    }
+LoadEqualizer::Data* LoadEqualizer::_findData(const Channel* channel,
+                                              const uint32_t frameNumber,
+                                              LBFrameData*& frameData)
+{
+    const auto i = _index.find(LBDataKey(frameNumber, channel));
+    if (i == _index.end())
+        return 0;
+
+    // frames are added in increasing order
+    const auto j = std::lower_bound(_history.begin(), _history.end(),
+                                    frameNumber,
+                                    [](const LBFrameData& data,
+                                       const uint32_t number) {
+                                        return data.frameNumber < number;
+                                    });
+    LBASSERT(j != _history.end() && j->frameNumber == frameNumber);
+    LBASSERT(i->second < j->items.size());
+    frameData = &*j;
+    return &frameData->items[i->second];
 }
 
 void LoadEqualizer::_updateAssembleTime(Data& data, const Statistic& stat)
@@ -250,42 +298,46 @@ void LoadEqualizer::_updateAssembleTime(Data& data, const Statistic& stat)
     }
 }
 
+void LoadEqualizer::_clearHistory()
+{
+    _history.clear();
+    _index.clear();
+    _costMap.clear();
+    _view = 0;
+    _pvp = PixelViewport();
+}
+
 void LoadEqualizer::_checkHistory()
 {
     // 1. Find youngest complete load data set
     uint32_t useFrame = 0;
     for (std::deque<LBFrameData>::reverse_iterator i = _history.rbegin();
-         i != _history.rend() && useFrame == 0; ++i)
+         i != _history.rend(); ++i)
     {
-        const LBFrameData& frameData = *i;
-        const LBDatas& items = frameData.second;
-        bool isComplete = true;
-
-        for (LBDatas::const_iterator j = items.begin();
-             j != items.end() && isComplete; ++j)
+        if (i->nPending == 0)
         {
-            const Data& data = *j;
-
-            if (data.time < 0)
-                isComplete = false;
+            useFrame = i->frameNumber;
+            break;
         }
-
-        if (isComplete)
-            useFrame = frameData.first;
     }
 
     // 2. delete old, unneeded data sets
-    while (!_history.empty() && _history.front().first < useFrame)
+    while (!_history.empty() && _history.front().frameNumber < useFrame)
+    {
+        const LBFrameData& frameData = _history.front();
+        for (const Data& data : frameData.items)
+            _index.erase(LBDataKey(frameData.frameNumber, data.channel));
         _history.pop_front();
+    }
 
     if (_history.empty()) // insert fake set
     {
         _history.resize(1);
 
         LBFrameData& frameData = _history.front();
-        LBDatas& items = frameData.second;
+        LBDatas& items = frameData.items;
 
-        frameData.first = 0; // frameNumber
+        frameData.frameNumber = 0;
         items.resize(1);
 
         Data& data = items.front();
@@ -487,7 +539,7 @@ void LoadEqualizer::_updateNode(Node* node, const Viewport& vp,
 int64_t LoadEqualizer::_getTotalTime()
 {
     const LBFrameData& frameData = _history.front();
-    LBDatas items = frameData.second;
+    LBDatas items = frameData.items;
     _removeEmpty(items);
 
     int64_t totalTime = 0;
@@ -505,7 +557,7 @@ int64_t LoadEqualizer::_getAssembleTime()
         return 0;
 
     const LBFrameData& frameData = _history.front();
-    const LBDatas& items = frameData.second;
+    const LBDatas& items = frameData.items;
 
     int64_t assembleTime = 0;
     for (LBDatas::const_iterator i = items.begin(); i != items.end(); ++i)
@@ -524,12 +576,12 @@ void LoadEqualizer::_computeSplit()
     const LBFrameData& frameData = _history.front();
     const Compound* compound = getCompound();
     LBLOG(LOG_LB2) << "----- balance " << compound->getChannel()->getName()
-                   << " using frame " << frameData.first << " tree "
+                   << " using frame " << frameData.frameNumber << " tree "
                    << std::endl
                    << _tree;
 
     // sort load items for each of the split directions
-    LBDatas items(frameData.second);
+    LBDatas items(frameData.items);
     _removeEmpty(items);
 
     LBDatas sortedData[3] = {items, items, items};
@@ -602,6 +654,8 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
                                ? time * node->left->resources / node->resources
                                : 0.f;
     float timeLeft = LB_MIN(leftTime, time); // correct for fp rounding error
+    const float leftShare =
+        node->resources > 0 ? node->left->resources / node->resources : 0.f;
 
     switch (node->mode)
     {
@@ -612,6 +666,12 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
         float splitPos = vp.x;
         const float end = vp.getXEnd();
 
+        if (_costMap.isValid()) // balance the measured cost distribution
+        {
+            splitPos = _costMap.findSplit(vp, true, leftShare);
+            timeLeft = 0.f;
+        }
+
         while (timeLeft > std::numeric_limits<float>::epsilon() &&
                splitPos < end)
         {
@@ -777,6 +837,12 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
         float splitPos = vp.y;
         const float end = vp.getYEnd();
 
+        if (_costMap.isValid()) // balance the measured cost distribution
+        {
+            splitPos = _costMap.findSplit(vp, false, leftShare);
+            timeLeft = 0.f;
+        }
+
         while (timeLeft > std::numeric_limits<float>::epsilon() &&
                splitPos < end)
         {
@@ -1079,8 +1145,12 @@ void LoadEqualizer::_assign(Compound* compound, const Viewport& vp,
         data.time = 0;
 
     LBFrameData& frameData = _history.back();
-    LBDatas& items = frameData.second;
+    LBDatas& items = frameData.items;
 
+    if (data.time < 0)
+        ++frameData.nPending;
+    _index.emplace(LBDataKey(frameData.frameNumber, data.channel),
+                   items.size());
     items.push_back(data);
 }
 
@@ -20,12 +20,16 @@
 #define EQS_LOADEQUALIZER_H
 
 #include "../channelListener.h" // base class
+#include "costMap.h"            // member
 #include "equalizer.h"          // base class
 
-#include <eq/fabric/range.h>    // member
-#include <eq/fabric/viewport.h> // member
+#include <eq/fabric/pixelViewport.h> // member
+#include <eq/fabric/range.h>         // member
+#include <eq/fabric/viewport.h>      // member
 
 #include <deque>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace eq
@@ -42,6 +46,9 @@ public:
     explicit LoadEqualizer(const fabric::Equalizer& from);
     virtual ~LoadEqualizer();
     void toStream(std::ostream& os) const final { os << this; }
+    /** @sa Equalizer::attach */
+    void attach(Compound* compound) final;
+
     /** @sa CompoundListener::notifyUpdatePre */
     void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
 
@@ -111,10 +118,39 @@ private:
     };
 
     typedef std::vector<Data> LBDatas;
-    typedef std::pair<uint32_t, LBDatas> LBFrameData;
+
+    struct LBFrameData
+    {
+        LBFrameData()
+            : frameNumber(0)
+            , nPending(0)
+        {
+        }
+        uint32_t frameNumber;
+        LBDatas items;
+        size_t nPending; //!< items still waiting for their load data
+    };
 
     std::deque<LBFrameData> _history;
 
+    /** Identifies the item of a channel in the history. */
+    typedef std::pair<uint32_t, const Channel*> LBDataKey;
+    struct LBDataKeyHash
+    {
+        size_t operator()(const LBDataKey& key) const
+        {
+            return std::hash<const Channel*>()(key.second) ^
+                   (size_t(key.first) * 0x9E3779B9u);
+        }
+    };
+    /** The position of each (frame, channel) item in its frame's items. */
+    std::unordered_map<LBDataKey, size_t, LBDataKeyHash> _index;
+
+    /** Smoothed screen-space cost of all measured frames, 2D modes only. */
+    CostMap _costMap;
+    PixelViewport _pvp; //!< The destination measured by the cost map
+    const View* _view;  //!< The view measured by the cost map
+
     //-------------------- Methods --------------------
     /** @return true if we have a valid LB tree */
     Node* _buildTree(const Compounds& children);
@@ -132,9 +168,16 @@ private:
         the destination Channel. */
     int64_t _getAssembleTime();
 
+    /** Drop all load data, e.g., when the measured destination changed. */
+    void _clearHistory();
+
     /** Obsolete _history so that front-most item is youngest available. */
     void _checkHistory();
 
+    /** @return the item of the channel in the given frame, or 0. */
+    Data* _findData(const Channel* channel, uint32_t frameNumber,
+                    LBFrameData*& frameData);
+
     /** Update all node fields influencing the split */
     void _update(Node* node, const Viewport& vp, const Range& range);
     void _updateLeaf(Node* node);
@@ -37,6 +37,7 @@
 #include "node.h"
 #include "observer.h"
 #include "pipe.h"
+#include "radixK.h"
 #include "segment.h"
 #include "server.h"
 #include "view.h"
@@ -47,6 +48,7 @@
 #include <lunchbox/file.h>
 
 #include <locale.h>
+#include <map>
 #include <string>
 
 #pragma warning(disable: 4065)
@@ -81,6 +83,7 @@
         static eq::fabric::Wall         wall;
         static eq::fabric::Projection   projection;
         static fabric::Frame::Buffer buffers = fabric::Frame::Buffer::none;
+        static std::map< eq::server::Compound*, uint32_t > radixCompounds;
     }
     }
 
@@ -118,6 +121,8 @@
 %token EQTOKEN_NODE_CATTR_LAUNCH_COMMAND_QUOTE
 %token EQTOKEN_NODE_IATTR_THREAD_MODEL
 %token EQTOKEN_NODE_IATTR_HINT_AFFINITY
+%token EQTOKEN_NODE_IATTR_HINT_THREAD_POOL
+%token EQTOKEN_NODE_IATTR_HINT_SHARED_MEMORY
 %token EQTOKEN_NODE_IATTR_HINT_STATISTICS
 %token EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT
 %token EQTOKEN_PIPE_IATTR_HINT_THREAD
@@ -164,6 +169,8 @@
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
 %token EQTOKEN_HINT_AFFINITY
+%token EQTOKEN_HINT_THREAD_POOL
+%token EQTOKEN_HINT_SHARED_MEMORY
 %token EQTOKEN_HINT_SCREENSAVER
 %token EQTOKEN_HINT_GRAB_POINTER
 %token EQTOKEN_PLANES_COLOR
@@ -254,6 +261,7 @@
 %token EQTOKEN_PHASE
 %token EQTOKEN_PIXEL
 %token EQTOKEN_SUBPIXEL
+%token EQTOKEN_RADIX_K
 %token EQTOKEN_BANDWIDTH
 %token EQTOKEN_DEVICE
 %token EQTOKEN_WALL
@@ -395,6 +403,16 @@ global:
          eq::server::Global::instance()->setNodeIAttribute(
              eq::server::Node::IATTR_HINT_AFFINITY, $2 );
      }
+     | EQTOKEN_NODE_IATTR_HINT_THREAD_POOL IATTR
+     {
+         eq::server::Global::instance()->setNodeIAttribute(
+             eq::server::Node::IATTR_HINT_THREAD_POOL, $2 );
+     }
+     | EQTOKEN_NODE_IATTR_HINT_SHARED_MEMORY IATTR
+     {
+         eq::server::Global::instance()->setNodeIAttribute(
+             eq::server::Node::IATTR_HINT_SHARED_MEMORY, $2 );
+     }
      | EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT UNSIGNED
      {
          eq::server::Global::instance()->setNodeIAttribute(
@@ -667,6 +685,12 @@ nodeAttribute:
         }
     | EQTOKEN_HINT_AFFINITY IATTR
         { node->setIAttribute( eq::server::Node::IATTR_HINT_AFFINITY, $2 ); }
+    | EQTOKEN_HINT_THREAD_POOL IATTR
+        { node->setIAttribute( eq::server::Node::IATTR_HINT_THREAD_POOL,
+                               $2 ); }
+    | EQTOKEN_HINT_SHARED_MEMORY IATTR
+        { node->setIAttribute( eq::server::Node::IATTR_HINT_SHARED_MEMORY,
+                               $2 ); }
 
 
 pipe: EQTOKEN_PIPE '{'
@@ -954,7 +978,21 @@ compound: EQTOKEN_COMPOUND '{'
                       eqCompound = new eq::server::Compound( config );
               }
           compoundFields
-          '}' { eqCompound = eqCompound->getParent(); }
+          '}'
+          {
+              const auto i = radixCompounds.find( eqCompound );
+              if( i != radixCompounds.end( ))
+              {
+                  const uint32_t radix = i->second;
+                  radixCompounds.erase( i );
+                  if( !eq::server::RadixK::configure( eqCompound, radix ))
+                  {
+                      yyerror( "Can't set up radix-k compositing" );
+                      YYERROR;
+                  }
+              }
+              eqCompound = eqCompound->getParent();
+          }
 
 compoundFields: /*null*/ | compoundFields compoundField
 compoundField:
@@ -1015,6 +1053,7 @@ compoundField:
         { eqCompound->setPixel( eq::fabric::Pixel( $3, $4, $5, $6 )); }
     | EQTOKEN_SUBPIXEL '[' UNSIGNED UNSIGNED ']'
         { eqCompound->setSubPixel( eq::fabric::SubPixel( $3, $4 )); }
+    | EQTOKEN_RADIX_K UNSIGNED { radixCompounds[ eqCompound ] = $2; }
     | wall { eqCompound->setWall( wall ); }
     | projection { eqCompound->setProjection( projection ); }
     | equalizer
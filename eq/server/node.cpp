@@ -757,7 +757,11 @@ void Node::output(std::ostream& os) const
                          ? "thread_model         "
                          : i == Node::IATTR_HINT_AFFINITY
                                ? "hint_affinity        "
-                               : "ERROR")
+                               : i == Node::IATTR_HINT_THREAD_POOL
+                                     ? "hint_thread_pool     "
+                                     : i == Node::IATTR_HINT_SHARED_MEMORY
+                                           ? "hint_shared_memory   "
+                                           : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
 
@@ -0,0 +1,213 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "radixK.h"
+
+#include "compound.h"
+#include "frame.h"
+#include "log.h"
+
+#include <eq/fabric/task.h>
+#include <lunchbox/atomic.h>
+
+#include <sstream>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// resolution of the destination viewport used to compute the regions
+const int32_t _units = 100000;
+
+static lunchbox::a_int32_t _counter;
+
+/** @return the given part of a region split into size parts. */
+PixelViewport _split(const PixelViewport& region, const size_t round,
+                     const uint32_t part, const uint32_t size)
+{
+    // alternate between horizontal and vertical splits for square regions
+    PixelViewport result = region;
+    if (round % 2 == 0)
+    {
+        result.y = region.y + int32_t(int64_t(region.h) * part / size);
+        result.h = region.y + int32_t(int64_t(region.h) * (part + 1) / size) -
+                   result.y;
+    }
+    else
+    {
+        result.x = region.x + int32_t(int64_t(region.w) * part / size);
+        result.w = region.x + int32_t(int64_t(region.w) * (part + 1) / size) -
+                   result.x;
+    }
+    return result;
+}
+
+Viewport _getViewport(const PixelViewport& pvp)
+{
+    return Viewport(float(pvp.x) / float(_units), float(pvp.y) / float(_units),
+                    float(pvp.w) / float(_units), float(pvp.h) / float(_units));
+}
+
+std::string _getFrameName(const int32_t id, const size_t round,
+                          const size_t to, const size_t from)
+{
+    std::ostringstream name;
+    name << "radix" << id << ".round" << round << ".tile" << to << ".channel"
+         << from;
+    return name.str();
+}
+}
+
+RadixK::RadixK(const size_t nSources, const uint32_t radix)
+    : _nSources(nSources)
+{
+    const uint32_t maxSize = LB_MAX(radix, 2u);
+    size_t stride = 1;
+    size_t left = nSources;
+
+    while (left > 1)
+    {
+        // largest group size up to the radix, or the smallest factor above it
+        uint32_t size = uint32_t(LB_MIN(size_t(maxSize), left));
+        while (size > 1 && left % size != 0)
+            --size;
+        if (size < 2)
+            for (size = maxSize + 1; left % size != 0; ++size)
+                /* nop */;
+
+        _groupSizes.push_back(size);
+        _strides.push_back(stride);
+        stride *= size;
+        left /= size;
+    }
+}
+
+uint32_t RadixK::getKeptPart(const size_t source, const size_t round) const
+{
+    return uint32_t((source / _strides[round]) % _groupSizes[round]);
+}
+
+size_t RadixK::getPartner(const size_t source, const size_t round,
+                          const uint32_t part) const
+{
+    const size_t stride = _strides[round];
+    return source - getKeptPart(source, round) * stride + part * stride;
+}
+
+PixelViewport RadixK::getRegion(const size_t source, const size_t round,
+                                const PixelViewport& area) const
+{
+    PixelViewport region = area;
+    for (size_t i = 0; i < round; ++i)
+        region = _split(region, i, getKeptPart(source, i), _groupSizes[i]);
+    return region;
+}
+
+PixelViewport RadixK::getPart(const size_t source, const size_t round,
+                              const uint32_t part,
+                              const PixelViewport& area) const
+{
+    return _split(getRegion(source, round, area), round, part,
+                  _groupSizes[round]);
+}
+
+Viewport RadixK::getRegion(const size_t source, const size_t round) const
+{
+    return _getViewport(
+        getRegion(source, round, PixelViewport(0, 0, _units, _units)));
+}
+
+Viewport RadixK::getPart(const size_t source, const size_t round,
+                         const uint32_t part) const
+{
+    return _getViewport(
+        getPart(source, round, part, PixelViewport(0, 0, _units, _units)));
+}
+
+bool RadixK::configure(Compound* compound, const uint32_t radix)
+{
+    const Compounds children = compound->getChildren();
+    if (children.size() < 2)
+    {
+        LBWARN << "Radix-k compositing needs at least two source compounds"
+               << std::endl;
+        return false;
+    }
+    for (const Compound* child : children)
+    {
+        if (!child->isLeaf())
+        {
+            LBWARN << "Radix-k compositing needs leaf source compounds"
+                   << std::endl;
+            return false;
+        }
+    }
+
+    const RadixK schedule(children.size(), radix);
+    const size_t nRounds = schedule.getNumRounds();
+    const int32_t id = ++_counter;
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        // One compound per round on the source channel. The first one draws,
+        // the following ones composite the parts received in the previous
+        // round and send the parts of the next round. The source compound
+        // itself composites the parts of the last round.
+        std::vector<Compound*> levels(nRounds + 1, children[i]);
+        for (size_t round = 0; round < nRounds; ++round)
+        {
+            levels[round] = new Compound(children[i]);
+            if (round > 0)
+                levels[round]->setTasks(fabric::TASK_ASSEMBLE |
+                                        fabric::TASK_READBACK);
+        }
+
+        for (size_t round = 0; round < nRounds; ++round)
+        {
+            const uint32_t kept = schedule.getKeptPart(i, round);
+            for (uint32_t part = 0; part < schedule.getGroupSize(round); ++part)
+            {
+                if (part == kept)
+                    continue;
+
+                const size_t partner = schedule.getPartner(i, round, part);
+                Frame* outputFrame = new Frame;
+                outputFrame->setName(_getFrameName(id, round, partner, i));
+                outputFrame->setViewport(schedule.getPart(i, round, part));
+                outputFrame->setBuffers(Frame::Buffer::color |
+                                        Frame::Buffer::depth);
+                levels[round]->addOutputFrame(outputFrame);
+
+                Frame* inputFrame = new Frame;
+                inputFrame->setName(_getFrameName(id, round, i, partner));
+                levels[round + 1]->addInputFrame(inputFrame);
+            }
+        }
+
+        // The final regions are disjoint, gather only their color
+        const Viewport& region = schedule.getRegion(i, nRounds);
+        for (Frame* frame : children[i]->getOutputFrames())
+        {
+            frame->setViewport(region);
+            frame->setBuffers(Frame::Buffer::color);
+        }
+    }
+    return true;
+}
+}
+}
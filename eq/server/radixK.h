@@ -0,0 +1,108 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_RADIXK_H
+#define EQSERVER_RADIXK_H
+
+#include "types.h"
+#include <eq/server/api.h>
+
+#include <eq/fabric/pixelViewport.h> // return value
+#include <eq/fabric/viewport.h>      // return value
+
+namespace eq
+{
+namespace server
+{
+/**
+ * The schedule of a radix-k parallel sort-last compositing.
+ *
+ * The sources of a DB compound composite the final image in several rounds.
+ * In each round, the sources are divided into groups of k sources which own
+ * the same region of the image. Each group member keeps one of k parts of the
+ * region and sends the other parts to the group members keeping them. After
+ * the last round, each source owns the fully composited image of 1/N of the
+ * destination, which is then gathered on the destination channel.
+ *
+ * The number of sources is factored into group sizes no larger than the radix
+ * where possible. Binary-swap is radix-k with a radix of two. A radix equal to
+ * the number of sources is direct-send compositing.
+ */
+class RadixK
+{
+public:
+    /** Create the schedule for the given number of sources and radix. */
+    EQSERVER_API RadixK(size_t nSources, uint32_t radix);
+
+    /** @return the number of sources. */
+    size_t getNumSources() const { return _nSources; }
+
+    /** @return the number of exchange rounds. */
+    size_t getNumRounds() const { return _groupSizes.size(); }
+
+    /** @return the number of sources in a group of the given round. */
+    uint32_t getGroupSize(const size_t round) const
+    {
+        return _groupSizes[round];
+    }
+
+    /** @return the part of its region kept by the source in the round. */
+    EQSERVER_API uint32_t getKeptPart(size_t source, size_t round) const;
+
+    /** @return the group member keeping the given part in the round. */
+    EQSERVER_API size_t getPartner(size_t source, size_t round,
+                                   uint32_t part) const;
+
+    /**
+     * @return the region of the given area owned by the source before the
+     *         given round. The region before round getNumRounds() is the final
+     *         region of the source.
+     */
+    EQSERVER_API PixelViewport getRegion(size_t source, size_t round,
+                                         const PixelViewport& area) const;
+
+    /** @return the given part of the source's region in the round. */
+    EQSERVER_API PixelViewport getPart(size_t source, size_t round,
+                                       uint32_t part,
+                                       const PixelViewport& area) const;
+
+    /** @return the region as a fraction of the destination viewport. */
+    EQSERVER_API Viewport getRegion(size_t source, size_t round) const;
+
+    /** @return the part as a fraction of the destination viewport. */
+    EQSERVER_API Viewport getPart(size_t source, size_t round,
+                                  uint32_t part) const;
+
+    /**
+     * Set up radix-k compositing on a sort-last compound.
+     *
+     * Each child of the compound is one source. One compound per exchange
+     * round is added to each child, and the output frames of the child are
+     * restricted to the color of its final region.
+     *
+     * @return false if the compound has less than two children, or children
+     *         which are not leaf compounds.
+     */
+    EQSERVER_API static bool configure(Compound* compound, uint32_t radix);
+
+private:
+    size_t _nSources;
+    std::vector<uint32_t> _groupSizes;
+    std::vector<size_t> _strides;
+};
+}
+}
+#endif // EQSERVER_RADIXK_H
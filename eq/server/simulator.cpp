@@ -0,0 +1,340 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "simulator.h"
+
+#include "canvas.h"
+#include "channel.h"
+#include "compound.h"
+#include "compoundUpdateActivateVisitor.h"
+#include "compoundUpdateDataVisitor.h"
+#include "config.h"
+#include "configVisitor.h"
+#include "layout.h"
+#include "node.h"
+#include "observer.h"
+#include "pipe.h"
+#include "view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+/** Sets the state of all channels of a config. */
+class ChannelStateVisitor : public ConfigVisitor
+{
+public:
+    explicit ChannelStateVisitor(const State state)
+        : _state(state)
+    {
+    }
+
+    VisitorResult visit(Channel* channel) override
+    {
+        channel->setState(_state);
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    const State _state;
+};
+
+/** Collects the active compounds drawing in the current frame. */
+class DrawCompoundVisitor : public CompoundVisitor
+{
+public:
+    VisitorResult visit(Compound* compound) override
+    {
+        if (compound->testInheritTask(fabric::TASK_DRAW) &&
+            compound->isActive())
+        {
+            _compounds.push_back(compound);
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+    const Compounds& getResult() const { return _compounds; }
+
+private:
+    Compounds _compounds;
+};
+
+/** @return the nearest parent compound receiving input frames, or 0. */
+Compound* _findAssembler(const Compound* compound)
+{
+    for (Compound* parent = compound->getParent(); parent;
+         parent = parent->getParent())
+    {
+        if (!parent->getInputFrames().empty())
+            return parent;
+    }
+    return 0;
+}
+
+float _getNumEyes(const Compound* compound)
+{
+    size_t nEyes = 0;
+    for (size_t i = 0; i < NUM_EYES; ++i)
+        if (compound->isInheritActive(Eye(1 << i)))
+            ++nEyes;
+    return float(nEyes);
+}
+
+/** Append a task to the statistics of a channel, starting at clock. */
+void _addStatistic(Statistics& statistics, const Statistic::Type type,
+                   const Channel* channel, const uint32_t frameNumber,
+                   const uint32_t taskID, const float clock,
+                   const float time)
+{
+    Statistic statistic = Statistic();
+    statistic.type = type;
+    statistic.frameNumber = frameNumber;
+    statistic.task = taskID;
+    statistic.startTime = std::llround(clock);
+    statistic.endTime = std::llround(clock + time);
+    strncpy(statistic.resourceName, channel->getName().c_str(), 31);
+    statistics.push_back(statistic);
+}
+}
+
+Simulator::Simulator(Config* config, const PixelViewport& pvp)
+    : _config(config)
+    , _transmitCost(0.f)
+    , _assembleCost(0.f)
+    , _frameNumber(0)
+{
+    // The pipe resolution is normally queried by the started node
+    for (Node* node : config->getNodes())
+        for (Pipe* pipe : node->getPipes())
+            if (!pipe->getPixelViewport().hasArea())
+                pipe->setPixelViewport(pvp);
+
+    ChannelStateVisitor runner(STATE_RUNNING);
+    config->accept(runner);
+
+    // Same as Config::_init, without registering and starting the resources
+    for (Compound* compound : config->getCompounds())
+        compound->init();
+    for (Observer* observer : config->getObservers())
+        observer->init();
+    for (Canvas* canvas : config->getCanvases())
+        canvas->init();
+    for (Layout* layout : config->getLayouts())
+        for (View* view : layout->getViews())
+            view->init();
+
+    _update(0); // set up active state for first equalizer update
+}
+
+Simulator::~Simulator()
+{
+    for (Canvas* canvas : _config->getCanvases())
+        canvas->exit();
+    for (Compound* compound : _config->getCompounds())
+        compound->exit();
+
+    ChannelStateVisitor stopper(STATE_STOPPED);
+    _config->accept(stopper);
+}
+
+void Simulator::setRegions(const Regions& regions)
+{
+    _regions = regions;
+}
+
+void Simulator::setSpeed(const std::string& channel, const float speed)
+{
+    LBASSERT(speed > 0.f);
+    _speeds[channel] = speed;
+}
+
+void Simulator::setDelay(const std::string& channel, const uint32_t frames)
+{
+    _delays[channel] = frames;
+}
+
+const Simulator::Result& Simulator::simulate()
+{
+    const uint32_t frameNumber = ++_frameNumber;
+    _deliver(frameNumber);
+    _update(frameNumber);
+
+    DrawCompoundVisitor visitor;
+    for (Compound* compound : _config->getCompounds())
+        compound->accept(visitor);
+
+    _result = Result();
+    _result.frameNumber = frameNumber;
+
+    Loads loads;
+    std::map<Channel*, float> clocks; // end of the last task, per channel
+    std::map<Compound*, float> assembleTimes;
+    std::map<Compound*, float> inputTimes; // arrival of the last input
+
+    for (Compound* compound : visitor.getResult())
+    {
+        const Viewport& vp = compound->getInheritViewport();
+        const Range& range = compound->getInheritRange();
+        if (!vp.hasArea() || !range.hasData()) // will not render
+            continue;
+
+        Channel* channel = compound->getChannel();
+        const float nEyes = _getNumEyes(compound);
+        Task task;
+        task.channel = channel->getName();
+        task.destination = compound->getInheritChannel()->getName();
+        task.vp = vp;
+        task.range = range;
+        task.drawTime = nEyes * _getCost(compound) / _getSpeed(channel);
+        task.transmitTime = 0.f;
+
+        Statistics& statistics = loads[channel];
+        float& clock = clocks[channel];
+        _addStatistic(statistics, Statistic::CHANNEL_DRAW, channel,
+                      frameNumber, compound->getTaskID(), clock,
+                      task.drawTime);
+        clock += task.drawTime;
+
+        Compound* assembler = _findAssembler(compound);
+        if (assembler && assembler->getChannel() != channel)
+        {
+            const Pixel& pixel = compound->getInheritPixel();
+            const float size = nEyes * vp.getArea() / float(pixel.w * pixel.h);
+            task.transmitTime = size * _transmitCost;
+            _addStatistic(statistics, Statistic::CHANNEL_FRAME_TRANSMIT,
+                          channel, frameNumber, compound->getTaskID(), clock,
+                          task.transmitTime);
+
+            float& inputTime = inputTimes[assembler];
+            inputTime = std::max(inputTime, clock + task.transmitTime);
+            assembleTimes[assembler] += size * _assembleCost;
+        }
+        _result.tasks.push_back(task);
+    }
+
+    if (!clocks.empty())
+    {
+        float fastest = clocks.begin()->second;
+        for (const auto& i : clocks)
+        {
+            fastest = std::min(fastest, i.second);
+            _result.time = std::max(_result.time, i.second);
+        }
+        if (_result.time > 0.f)
+            _result.imbalance = (_result.time - fastest) / _result.time;
+    }
+
+    for (const auto& i : assembleTimes)
+    {
+        Compound* assembler = i.first;
+        Channel* channel = assembler->getChannel();
+        float& clock = clocks[channel];
+        clock = std::max(clock, inputTimes[assembler]);
+        _addStatistic(loads[channel], Statistic::CHANNEL_ASSEMBLE, channel,
+                      frameNumber, assembler->getTaskID(), clock, i.second);
+        clock += i.second;
+        _result.time = std::max(_result.time, clock);
+    }
+
+    const uint32_t due = frameNumber + _config->getLatency() + 1;
+    for (auto& load : loads)
+    {
+        Channel* channel = load.first;
+        const auto i = _delays.find(channel->getName());
+        Pending pending;
+        pending.frameNumber = frameNumber;
+        pending.due = due + (i == _delays.end() ? 0 : i->second);
+        pending.channel = channel;
+        pending.statistics.swap(load.second);
+        _pending.push_back(pending);
+    }
+    return _result;
+}
+
+void Simulator::_update(const uint32_t frameNumber)
+{
+    // Same as Compound::update, without the frame and barrier setup which
+    // needs running nodes
+    for (Compound* compound : _config->getCompounds())
+    {
+        CompoundUpdateActivateVisitor updateActivateVisitor(frameNumber);
+        compound->accept(updateActivateVisitor);
+
+        CompoundUpdateDataVisitor updateDataVisitor(frameNumber);
+        compound->accept(updateDataVisitor);
+    }
+}
+
+void Simulator::_deliver(const uint32_t frameNumber)
+{
+    // oldest first, like the in-order delivery of each channel
+    for (auto i = _pending.begin(); i != _pending.end();)
+    {
+        if (i->due > frameNumber)
+        {
+            ++i;
+            continue;
+        }
+        i->channel->_fireLoadData(i->frameNumber, i->statistics,
+                                  Viewport::FULL);
+        i = _pending.erase(i);
+    }
+}
+
+float Simulator::_getCost(const Compound* compound) const
+{
+    const Viewport& vp = compound->getInheritViewport();
+    const Range& range = compound->getInheritRange();
+    const std::string& destination = compound->getInheritChannel()->getName();
+
+    float cost = 0.f;
+    for (const Region& region : _regions)
+    {
+        if (!region.destination.empty() && region.destination != destination)
+            continue;
+        if (!region.vp.hasArea() || !region.range.hasData())
+            continue;
+
+        Viewport overlap(vp);
+        overlap.intersect(region.vp);
+        const float start = std::max(range.start, region.range.start);
+        const float end = std::min(range.end, region.range.end);
+        if (!overlap.hasArea() || end <= start)
+            continue;
+
+        cost += region.cost * overlap.getArea() / region.vp.getArea() *
+                (end - start) / region.range.getSize();
+    }
+
+    // pixel compounds render every nth pixel
+    const Pixel& pixel = compound->getInheritPixel();
+    return cost / float(pixel.w * pixel.h);
+}
+
+float Simulator::_getSpeed(const Channel* channel) const
+{
+    const auto i = _speeds.find(channel->getName());
+    return i == _speeds.end() ? 1.f : i->second;
+}
+}
+}
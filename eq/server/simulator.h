@@ -0,0 +1,184 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQSERVER_SIMULATOR_H
+#define EQSERVER_SIMULATOR_H
+
+#include "types.h"
+#include <eq/server/api.h>
+
+#include <eq/fabric/pixelViewport.h> // member
+#include <eq/fabric/range.h>         // member
+#include <eq/fabric/statistic.h>     // member
+#include <eq/fabric/viewport.h>      // member
+
+#include <boost/noncopyable.hpp>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Simulates the load balancing of a configuration without starting its nodes.
+ *
+ * The simulator activates the compounds of a loaded configuration, marks their
+ * channels as running and updates the compound trees frame by frame, which
+ * runs the equalizers as during rendering. The time of each rendering task is
+ * computed from a cost model of the scene, and delivered as channel statistics
+ * to the equalizers, delayed by the latency of the configuration and the delay
+ * of each channel.
+ *
+ * The scene is described by cost regions. Each region spreads its cost, the
+ * time to render it on a channel of speed one, evenly over its viewport and
+ * range. Viewports are relative to the destination channel. Source channels
+ * transmit their output asynchronously to the nearest parent compound with
+ * input frames, which assembles it after drawing. The predicted frame time is
+ * the time of the slowest channel, including the wait for its input frames.
+ */
+class Simulator : public boost::noncopyable
+{
+public:
+    /** A part of the scene and its rendering cost. */
+    struct Region
+    {
+        Region()
+            : cost(0.f)
+        {
+        }
+        Region(const Viewport& vp_, const Range& range_, const float cost_)
+            : vp(vp_)
+            , range(range_)
+            , cost(cost_)
+        {
+        }
+
+        Viewport vp;
+        Range range;
+        float cost;              //!< ms on a channel of speed one
+        std::string destination; //!< the destination channel, all if empty
+    };
+    typedef std::vector<Region> Regions;
+
+    /** The simulated rendering of one compound. */
+    struct Task
+    {
+        std::string channel;
+        std::string destination;
+        Viewport vp;
+        Range range;
+        float drawTime;     //!< ms
+        float transmitTime; //!< ms
+    };
+    typedef std::vector<Task> Tasks;
+
+    /** The outcome of one simulated frame. */
+    struct Result
+    {
+        Result()
+            : frameNumber(0)
+            , time(0.f)
+            , imbalance(0.f)
+        {
+        }
+
+        uint32_t frameNumber;
+        Tasks tasks;
+        float time;      //!< predicted frame time in ms
+        float imbalance; //!< (slowest - fastest) / slowest draw time
+    };
+
+    /**
+     * Activate the compounds of the given config for simulation.
+     *
+     * The config has to be loaded and converted, but not initialized.
+     *
+     * @param config the config to simulate.
+     * @param pvp the pixel viewport of pipes which have none configured.
+     */
+    EQSERVER_API Simulator(Config* config, const PixelViewport& pvp);
+
+    /** Deactivate the compounds of the config. */
+    EQSERVER_API ~Simulator();
+
+    /** Set the scene of the following frames. */
+    EQSERVER_API void setRegions(const Regions& regions);
+
+    /** Set the relative rendering speed of a channel, default 1. */
+    EQSERVER_API void setSpeed(const std::string& channel, float speed);
+
+    /**
+     * Set the number of frames the load data of a channel arrives late.
+     *
+     * Applies to the following frames. Different delays deliver the load data
+     * out of frame order, as slow network links do.
+     */
+    EQSERVER_API void setDelay(const std::string& channel, uint32_t frames);
+
+    /** Set the time in ms to transmit a frame of the destination size. */
+    void setTransmitCost(const float cost) { _transmitCost = cost; }
+    /** Set the time in ms to assemble a frame of the destination size. */
+    void setAssembleCost(const float cost) { _assembleCost = cost; }
+    /**
+     * Simulate the next frame.
+     *
+     * Delivers the load data of finished frames, updates the compounds,
+     * which runs the equalizers, and computes the time of all tasks.
+     *
+     * @return the outcome of the frame.
+     */
+    EQSERVER_API const Result& simulate();
+
+    /** @return the outcome of the last simulated frame. */
+    const Result& getResult() const { return _result; }
+
+private:
+    /** The load data of one frame, per channel. */
+    typedef std::map<Channel*, Statistics> Loads;
+
+    /** The load data of one channel waiting for its delivery. */
+    struct Pending
+    {
+        uint32_t frameNumber;
+        uint32_t due; //!< the frame number to deliver it with
+        Channel* channel;
+        Statistics statistics;
+    };
+
+    Config* const _config;
+    Channels _channels;
+    Regions _regions;
+    std::map<std::string, float> _speeds;
+    std::map<std::string, uint32_t> _delays;
+    float _transmitCost;
+    float _assembleCost;
+    uint32_t _frameNumber;
+    Result _result;
+    std::list<Pending> _pending;
+
+    void _update(uint32_t frameNumber);
+    void _deliver(uint32_t frameNumber);
+    float _getCost(const Compound* compound) const;
+    float _getSpeed(const Channel* channel) const;
+};
+}
+}
+
+#endif // EQSERVER_SIMULATOR_H
@@ -51,6 +51,7 @@ class Observer;
 class Pipe;
 class Segment;
 class Server;
+class Simulator;
 class TileEqualizer;
 class TileQueue;
 class TreeEqualizer;
@@ -32,6 +32,9 @@
 #include <eq/util/bitmapFont.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
+#include <eq/util/pixelArena.h>
 #include <eq/util/shader.h>
+#include <eq/util/sharedMemoryRing.h>
+#include <eq/util/threadPool.h>
 
 #endif // EQUTIL_H
@@ -0,0 +1,297 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pixelArena.h"
+
+#include <eq/log.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace eq
+{
+namespace util
+{
+namespace
+{
+const size_t _minBucketSize = 4096;
+const size_t _hugePageSize = 2 * 1024 * 1024;
+
+/** Book-keeping for one block, allocated or cached. */
+struct Block
+{
+    size_t capacity;
+    uint32_t node;
+    bool mapped; //!< allocated using mmap instead of malloc
+};
+
+/** @return the NUMA node of the calling thread. */
+uint32_t _getNUMANode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, 0) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+void* _allocate(Block& block, const uint32_t flags)
+{
+#ifdef __linux__
+    if ((flags & PixelArena::HUGE_PAGES) && block.capacity >= _hugePageSize)
+    {
+        void* data = ::mmap(0, block.capacity, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data != MAP_FAILED)
+        {
+#ifdef MADV_HUGEPAGE
+            ::madvise(data, block.capacity, MADV_HUGEPAGE);
+#endif
+            block.mapped = true;
+            return data;
+        }
+    }
+#else
+    (void)flags;
+#endif
+    block.mapped = false;
+    return ::malloc(block.capacity);
+}
+
+void _free(void* data, const Block& block)
+{
+#ifdef __linux__
+    if (block.mapped)
+    {
+        ::munmap(data, block.capacity);
+        return;
+    }
+#endif
+    ::free(data);
+}
+}
+
+namespace detail
+{
+class PixelArena
+{
+public:
+    PixelArena(const size_t maxCached_, const uint32_t flags_)
+        : maxCached(maxCached_)
+        , flags(flags_)
+    {
+        stats = util::PixelArena::Stats();
+    }
+
+    /** Return cached blocks to the system until the limit is met. */
+    void trim(const size_t limit)
+    {
+        std::vector<std::pair<void*, Block>> freed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& bucket : freeBlocks)
+            {
+                std::vector<void*>& list = bucket.second;
+                while (!list.empty() && stats.cached > limit)
+                {
+                    void* data = list.back();
+                    list.pop_back();
+
+                    auto i = blocks.find(data);
+                    freed.push_back(*i);
+                    stats.cached -= i->second.capacity;
+                    ++stats.nReleased;
+                    blocks.erase(i);
+                }
+            }
+        }
+
+        for (const auto& block : freed)
+            _free(block.first, block.second);
+    }
+
+    typedef std::pair<uint32_t, size_t> Key; // NUMA node, capacity
+
+    mutable std::mutex mutex;
+    std::unordered_map<void*, Block> blocks;      //!< all blocks
+    std::map<Key, std::vector<void*>> freeBlocks; //!< cached blocks
+    util::PixelArena::Stats stats;
+    size_t maxCached;
+    uint32_t flags;
+};
+}
+
+PixelArena::PixelArena(const size_t maxCached, const uint32_t flags)
+    : _impl(new detail::PixelArena(maxCached, flags))
+{
+}
+
+PixelArena::~PixelArena()
+{
+    LBASSERTINFO(_impl->stats.inUse == 0,
+                 _impl->stats.inUse << " bytes still in use");
+    clear();
+    delete _impl;
+}
+
+void PixelArena::setup(const size_t maxCached, const uint32_t flags)
+{
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->maxCached = maxCached;
+        _impl->flags = flags;
+    }
+    _impl->trim(maxCached);
+}
+
+void* PixelArena::allocate(const size_t size, size_t& capacity)
+{
+    LBASSERT(size > 0);
+    capacity = getBucketSize(size);
+
+    Block block;
+    block.capacity = capacity;
+    uint32_t flags = 0;
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        flags = _impl->flags;
+        block.node = (flags & NUMA_LOCAL) ? _getNUMANode() : 0;
+
+        Stats& stats = _impl->stats;
+        ++stats.nRequests;
+        stats.inUse += capacity;
+        stats.highWater = std::max(stats.highWater, stats.inUse);
+
+        auto i = _impl->freeBlocks.find(std::make_pair(block.node, capacity));
+        if (i != _impl->freeBlocks.end() && !i->second.empty())
+        {
+            void* data = i->second.back();
+            i->second.pop_back();
+            stats.cached -= capacity;
+            ++stats.nHits;
+            return data;
+        }
+        ++stats.nAllocated;
+    }
+
+    // allocate outside of the lock, the system may need to fault in pages
+    void* data = _allocate(block, flags);
+    if (!data)
+    {
+        LBERROR << "Allocation of " << capacity << " bytes failed" << std::endl;
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->stats.inUse -= capacity;
+        --_impl->stats.nAllocated;
+        capacity = 0;
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->blocks[data] = block;
+    return data;
+}
+
+void PixelArena::release(void* data)
+{
+    if (!data)
+        return;
+
+    Block block;
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        auto i = _impl->blocks.find(data);
+        LBASSERTINFO(i != _impl->blocks.end(), "Unknown block " << data);
+        if (i == _impl->blocks.end())
+            return;
+
+        block = i->second;
+        Stats& stats = _impl->stats;
+        stats.inUse -= block.capacity;
+        if (stats.cached + block.capacity <= _impl->maxCached)
+        {
+            const detail::PixelArena::Key key(block.node, block.capacity);
+            _impl->freeBlocks[key].push_back(data);
+            stats.cached += block.capacity;
+            return;
+        }
+
+        ++stats.nReleased;
+        _impl->blocks.erase(i);
+    }
+    _free(data, block);
+}
+
+void PixelArena::clear()
+{
+    _impl->trim(0);
+}
+
+PixelArena::Stats PixelArena::getStats() const
+{
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->stats;
+}
+
+void PixelArena::resetHighWater()
+{
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->stats.highWater = _impl->stats.inUse;
+}
+
+size_t PixelArena::getBucketSize(const size_t size)
+{
+    if (size <= _minBucketSize)
+        return _minBucketSize;
+
+    // round up to a quarter of the largest power of two below size
+    size_t base = _minBucketSize;
+    while (base * 2 < size)
+        base *= 2;
+    const size_t step = base / 4;
+    return base + (size - base + step - 1) / step * step;
+}
+
+size_t PixelArena::getDefaultMaxCached()
+{
+    return 512 * 1024 * 1024;
+}
+
+uint32_t PixelArena::getDefaultFlags()
+{
+    return HUGE_PAGES | NUMA_LOCAL;
+}
+
+PixelArena& PixelArena::getInstance()
+{
+    // not destroyed: images in static or thread-local storage may release
+    // their pixels after the destruction of function-local statics
+    static PixelArena* arena = new PixelArena;
+    return *arena;
+}
+}
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_PIXELARENA_H
+#define EQUTIL_PIXELARENA_H
+
+#include <eq/util/types.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace eq
+{
+namespace util
+{
+namespace detail
+{
+class PixelArena;
+}
+
+/**
+ * A thread-safe cache of pixel buffers, bucketed by size.
+ *
+ * Memory images draw their pixel storage from the process-wide arena returned
+ * by getInstance(), and return it on destruction or when a resize needs a
+ * different bucket. Released blocks are kept for reuse until the cache limit
+ * is reached, which avoids the allocation churn and page faults of images
+ * changing their size every frame, e.g., under a 2D load equalizer.
+ *
+ * The bucket sizes are a quarter of a power of two apart, wasting at most 25%
+ * of a block. Optionally, large blocks are allocated using transparent huge
+ * pages, and free blocks are only reused on the NUMA node they were allocated
+ * on.
+ */
+class PixelArena : public boost::noncopyable
+{
+public:
+    /** Allocation options. @version 2.1 */
+    enum Flags
+    {
+        HUGE_PAGES = 0x1, //!< Use huge pages for large blocks, if available
+        NUMA_LOCAL = 0x2  //!< Reuse blocks only on their NUMA node
+    };
+
+    /** Memory usage statistics, in bytes unless noted otherwise. */
+    struct Stats
+    {
+        size_t inUse;      //!< Allocated blocks handed out
+        size_t cached;     //!< Free blocks kept for reuse
+        size_t highWater;  //!< The maximum of inUse since the last reset
+        size_t nRequests;  //!< Number of allocate() calls
+        size_t nHits;      //!< Number of requests served from the cache
+        size_t nAllocated; //!< Number of blocks allocated from the system
+        size_t nReleased;  //!< Number of blocks returned to the system
+    };
+
+    /**
+     * Construct a new, empty pixel arena.
+     *
+     * @param maxCached the maximum size of the free blocks kept for reuse.
+     * @param flags the allocation options.
+     * @version 2.1
+     */
+    EQ_API explicit PixelArena(size_t maxCached = getDefaultMaxCached(),
+                               uint32_t flags = getDefaultFlags());
+
+    /** Destruct the arena and free all cached blocks. @version 2.1 */
+    EQ_API ~PixelArena();
+
+    /**
+     * Change the cache limit and allocation options.
+     *
+     * Free blocks exceeding the new limit are returned to the system.
+     * @version 2.1
+     */
+    EQ_API void setup(size_t maxCached, uint32_t flags);
+
+    /**
+     * Allocate a block of at least the given size.
+     *
+     * @param size the requested size in bytes, greater than zero.
+     * @param capacity returns the usable size of the block.
+     * @return the block, to be returned using release().
+     * @version 2.1
+     */
+    EQ_API void* allocate(size_t size, size_t& capacity);
+
+    /** Return a block obtained from allocate(). @version 2.1 */
+    EQ_API void release(void* block);
+
+    /** Return all cached free blocks to the system. @version 2.1 */
+    EQ_API void clear();
+
+    /** @return the current memory usage statistics. @version 2.1 */
+    EQ_API Stats getStats() const;
+
+    /** Reset the high-water mark to the current usage. @version 2.1 */
+    EQ_API void resetHighWater();
+
+    /** @return the block size used for the given request. @version 2.1 */
+    EQ_API static size_t getBucketSize(size_t size);
+
+    /** @return the default cache limit. @version 2.1 */
+    EQ_API static size_t getDefaultMaxCached();
+
+    /** @return the default allocation options. @version 2.1 */
+    EQ_API static uint32_t getDefaultFlags();
+
+    /** @return the process-wide pixel arena. @version 2.1 */
+    EQ_API static PixelArena& getInstance();
+
+private:
+    detail::PixelArena* const _impl;
+};
+}
+}
+
+#endif // EQUTIL_PIXELARENA_H
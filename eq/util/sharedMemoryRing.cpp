@@ -0,0 +1,286 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "sharedMemoryRing.h"
+
+#include <eq/log.h>
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace eq
+{
+namespace util
+{
+namespace
+{
+const uint64_t _magic = 0x45715368526e6731ull; // 'EqShRng1'
+
+/** The header at the start of the segment, followed by the ring. */
+struct Header
+{
+    uint64_t magic;
+    uint64_t capacity;
+    std::atomic<uint64_t> tail; //!< The end of the released regions
+};
+
+/** The offset of the ring in the segment, one cache line per header. */
+const size_t _dataOffset = 64;
+static_assert(sizeof(Header) <= _dataOffset, "Header exceeds its cache line");
+}
+
+namespace detail
+{
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing(const std::string& name_, const bool writer_)
+        : name(name_)
+        , writer(writer_)
+        , header(0)
+        , data(0)
+        , capacity(0)
+        , head(0)
+        , tail(0)
+    {
+    }
+
+    ~SharedMemoryRing()
+    {
+#ifndef _WIN32
+        if (header)
+            ::munmap(header, _dataOffset + capacity);
+        if (writer && header)
+            ::shm_unlink(name.c_str());
+#endif
+    }
+
+    bool map(const int fd, const size_t size)
+    {
+#ifndef _WIN32
+        void* segment =
+            ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (segment == MAP_FAILED)
+        {
+            LBWARN << "Can't map shared memory segment " << name << ": "
+                   << ::strerror(errno) << std::endl;
+            return false;
+        }
+        header = static_cast<Header*>(segment);
+        data = static_cast<uint8_t*>(segment) + _dataOffset;
+        return true;
+#else
+        (void)fd;
+        (void)size;
+        return false;
+#endif
+    }
+
+    const std::string name;
+    const bool writer;
+    Header* header;
+    uint8_t* data;
+    size_t capacity;
+
+    uint64_t head; //!< writer: the end of the allocated regions
+
+    std::mutex mutex; //!< reader: protects the members below
+    uint64_t tail;    //!< reader: the end of the released regions
+    std::map<uint64_t, uint64_t> ranges; //!< reader: released out of order
+};
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name,
+                                   const size_t capacity)
+    : _impl(new detail::SharedMemoryRing(name, true))
+{
+#ifndef _WIN32
+    ::shm_unlink(name.c_str()); // remove stale segments of crashed writers
+    const int fd =
+        ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LBWARN << "Can't create shared memory segment " << name << ": "
+               << ::strerror(errno) << std::endl;
+        return;
+    }
+
+    const size_t size = _dataOffset + capacity;
+    if (::ftruncate(fd, off_t(size)) != 0)
+    {
+        LBWARN << "Can't resize shared memory segment " << name << " to "
+               << size << " bytes: " << ::strerror(errno) << std::endl;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return;
+    }
+
+    if (!_impl->map(fd, size))
+    {
+        ::shm_unlink(name.c_str());
+        return;
+    }
+
+    _impl->capacity = capacity;
+    Header* header = _impl->header;
+    header->magic = _magic;
+    header->capacity = capacity;
+    new (&header->tail) std::atomic<uint64_t>(0);
+#else
+    (void)capacity;
+#endif
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name)
+    : _impl(new detail::SharedMemoryRing(name, false))
+{
+#ifndef _WIN32
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        LBWARN << "Can't open shared memory segment " << name << ": "
+               << ::strerror(errno) << std::endl;
+        return;
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || size_t(status.st_size) <= _dataOffset)
+    {
+        LBWARN << "Invalid shared memory segment " << name << std::endl;
+        ::close(fd);
+        return;
+    }
+
+    const size_t size = size_t(status.st_size);
+    if (!_impl->map(fd, size))
+        return;
+
+    Header* header = _impl->header;
+    if (header->magic != _magic || header->capacity + _dataOffset != size)
+    {
+        LBWARN << "Invalid shared memory segment " << name << std::endl;
+        ::munmap(header, size);
+        _impl->header = 0;
+        _impl->data = 0;
+        return;
+    }
+    _impl->capacity = header->capacity;
+    _impl->tail = header->tail.load();
+#endif
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    delete _impl;
+}
+
+bool SharedMemoryRing::isValid() const
+{
+    return _impl->header != 0;
+}
+
+const std::string& SharedMemoryRing::getName() const
+{
+    return _impl->name;
+}
+
+size_t SharedMemoryRing::getCapacity() const
+{
+    return _impl->capacity;
+}
+
+size_t SharedMemoryRing::getUsed() const
+{
+    LBASSERT(_impl->writer);
+    if (!_impl->header)
+        return 0;
+    return size_t(_impl->head - _impl->header->tail.load());
+}
+
+void* SharedMemoryRing::allocate(const size_t size, Region& region)
+{
+    LBASSERT(_impl->writer);
+    LBASSERT(size > 0);
+    const uint64_t capacity = _impl->capacity;
+    if (!_impl->header || size == 0 || size > capacity)
+        return 0;
+
+    // regions do not wrap around, the rest of the ring is skipped instead
+    const uint64_t position = _impl->head % capacity;
+    const uint64_t padding =
+        position + size > capacity ? capacity - position : 0;
+    const uint64_t end = _impl->head + padding + size;
+    if (end - _impl->header->tail.load(std::memory_order_acquire) > capacity)
+        return 0;
+
+    region.begin = _impl->head;
+    region.offset = (position + padding) % capacity;
+    region.size = size;
+    _impl->head = end;
+    return _impl->data + region.offset;
+}
+
+const void* SharedMemoryRing::getData(const Region& region) const
+{
+    const uint64_t capacity = _impl->capacity;
+    if (!_impl->header || region.size == 0 || region.offset >= capacity ||
+        region.size > capacity - region.offset)
+    {
+        return 0;
+    }
+    return _impl->data + region.offset;
+}
+
+void SharedMemoryRing::release(const Region& region)
+{
+    LBASSERT(!_impl->writer);
+    if (!getData(region))
+        return;
+
+    const uint64_t capacity = _impl->capacity;
+    const uint64_t padding =
+        (region.offset + capacity - region.begin % capacity) % capacity;
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->ranges[region.begin] = region.begin + padding + region.size;
+
+    // advance the tail over all regions released in allocation order
+    uint64_t tail = _impl->tail;
+    for (auto i = _impl->ranges.begin();
+         i != _impl->ranges.end() && i->first == tail;
+         i = _impl->ranges.erase(i))
+    {
+        tail = i->second;
+    }
+
+    if (tail != _impl->tail)
+    {
+        _impl->tail = tail;
+        _impl->header->tail.store(tail, std::memory_order_release);
+    }
+}
+}
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_SHAREDMEMORYRING_H
+#define EQUTIL_SHAREDMEMORYRING_H
+
+#include <eq/util/types.h>
+
+#include <boost/noncopyable.hpp>
+#include <string>
+
+namespace eq
+{
+namespace util
+{
+namespace detail
+{
+class SharedMemoryRing;
+}
+
+/**
+ * A ring buffer in a named shared memory segment, written by one process and
+ * read by another process on the same host.
+ *
+ * The writer allocates contiguous regions, fills them and passes their
+ * descriptors to the reader, e.g., in a network command. The reader accesses
+ * the data of a region in place and releases it afterwards, which makes the
+ * space available to the writer again. Regions may be released in any order,
+ * the space is reused in allocation order.
+ *
+ * Shared memory segments are only supported on POSIX systems. On other
+ * systems, and if the segment can't be created or opened, the ring is not
+ * valid.
+ */
+class SharedMemoryRing : public boost::noncopyable
+{
+public:
+    /** A region of the ring, passed from the writer to the reader. */
+    struct Region
+    {
+        uint64_t begin;  //!< The ring position, including any padding
+        uint64_t offset; //!< The offset of the data in the ring
+        uint64_t size;   //!< The size of the data in bytes
+    };
+
+    /**
+     * Create a new segment for writing.
+     *
+     * An existing segment of the same name is replaced. The segment is removed
+     * when the writer is destroyed.
+     *
+     * @param name the name of the segment.
+     * @param capacity the size of the ring in bytes.
+     * @version 2.1
+     */
+    EQ_API SharedMemoryRing(const std::string& name, size_t capacity);
+
+    /**
+     * Open an existing segment for reading.
+     *
+     * @param name the name of the segment.
+     * @version 2.1
+     */
+    EQ_API explicit SharedMemoryRing(const std::string& name);
+
+    /** Unmap, and for the writer remove, the segment. @version 2.1 */
+    EQ_API ~SharedMemoryRing();
+
+    /** @return true if the segment is mapped. @version 2.1 */
+    EQ_API bool isValid() const;
+
+    /** @return the name of the segment. @version 2.1 */
+    EQ_API const std::string& getName() const;
+
+    /** @return the size of the ring in bytes. @version 2.1 */
+    EQ_API size_t getCapacity() const;
+
+    /**
+     * @return the bytes allocated and not yet released, including padding.
+     *         Writer only.
+     * @version 2.1
+     */
+    EQ_API size_t getUsed() const;
+
+    /**
+     * Allocate a contiguous region. Writer only.
+     *
+     * @param size the size of the region in bytes, greater than zero.
+     * @param region returns the descriptor of the region.
+     * @return the data of the region, or 0 if the ring is full.
+     * @version 2.1
+     */
+    EQ_API void* allocate(size_t size, Region& region);
+
+    /**
+     * Access the data of a region. Reader only.
+     *
+     * @return the data of the region, or 0 if the region is not valid.
+     * @version 2.1
+     */
+    EQ_API const void* getData(const Region& region) const;
+
+    /**
+     * Release a region after its use. Reader only, thread-safe.
+     * @version 2.1
+     */
+    EQ_API void release(const Region& region);
+
+private:
+    detail::SharedMemoryRing* const _impl;
+};
+}
+}
+
+#endif // EQUTIL_SHAREDMEMORYRING_H
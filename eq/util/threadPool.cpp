@@ -0,0 +1,356 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "threadPool.h"
+
+#include <eq/log.h>
+
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace eq
+{
+namespace util
+{
+namespace
+{
+/** The remaining items of one loop participant. */
+struct Slot
+{
+    Slot()
+        : begin(0)
+        , end(0)
+    {
+    }
+
+    std::mutex mutex;
+    int64_t begin;
+    int64_t end;
+    char padding[64]; // avoid false sharing between participants
+};
+
+/** One parallel loop, shared by the calling thread and helping workers. */
+class Job
+{
+public:
+    Job(const int64_t begin, const int64_t end, const int64_t grain,
+        const size_t nSlots, const ThreadPool::Task& task)
+        : nextSlot(1)
+        , nUsers(0)
+        , _task(task)
+        , _grain(grain)
+        , _slots(new Slot[nSlots])
+        , _nSlots(nSlots)
+    {
+        // all items start at the caller, the workers steal from it
+        _slots[0].begin = begin;
+        _slots[0].end = end;
+    }
+
+    size_t getNumSlots() const { return _nSlots; }
+
+    /** Process items of the given slot until no items are left to steal. */
+    void work(const size_t index)
+    {
+        Slot& own = _slots[index];
+        while (true)
+        {
+            int64_t begin = 0;
+            int64_t end = 0;
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                begin = own.begin;
+                end = std::min(begin + _grain, own.end);
+                own.begin = std::max(begin, end);
+            }
+
+            if (begin < end)
+                _task(begin, end);
+            else if (!_steal(own, index))
+                return;
+        }
+    }
+
+    size_t nextSlot; //!< protected by the pool mutex
+    size_t nUsers;   //!< workers in work(), protected by the pool mutex
+
+private:
+    const ThreadPool::Task& _task;
+    const int64_t _grain;
+    std::unique_ptr<Slot[]> _slots;
+    const size_t _nSlots;
+
+    /** Move the upper half of the items of another participant to own. */
+    bool _steal(Slot& own, const size_t index)
+    {
+        for (size_t i = 1; i < _nSlots; ++i)
+        {
+            Slot& victim = _slots[(index + i) % _nSlots];
+            int64_t begin = 0;
+            int64_t end = 0;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                const int64_t left = victim.end - victim.begin;
+                if (left <= _grain)
+                    continue;
+
+                end = victim.end;
+                begin = end - left / 2;
+                victim.end = begin;
+            }
+
+            // own is empty, so no other thread modifies it concurrently
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin;
+            own.end = end;
+            return true;
+        }
+        return false;
+    }
+};
+}
+
+namespace detail
+{
+class ThreadPool
+{
+public:
+    ThreadPool()
+        : nThreads(0)
+        , nLoops(0)
+        , restarting(false)
+        , running(false)
+        , affinity(lunchbox::Thread::NONE)
+    {
+    }
+
+    void start(const size_t nThreads_, const int32_t affinity_)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        LBASSERT(threads.empty());
+        running = true;
+        nThreads = nThreads_;
+        affinity = affinity_;
+        for (size_t i = 0; i < nThreads; ++i)
+            threads.emplace_back([this, i] { run(i); });
+    }
+
+    /** Wait for all loops and posted tasks, and join all worker threads. */
+    void stop()
+    {
+        std::vector<std::thread> stopped;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return nLoops == 0; });
+            running = false;
+            stopped.swap(threads);
+        }
+        wake.notify_all();
+        for (std::thread& thread : stopped)
+            thread.join();
+    }
+
+    void run(const size_t index)
+    {
+        std::ostringstream name;
+        name << "Pool" << index;
+        lunchbox::Thread::setName(name.str());
+        if (affinity != lunchbox::Thread::NONE)
+            lunchbox::Thread::setAffinity(affinity);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            Job* job = 0;
+            wake.wait(lock, [this, &job] {
+                job = _findJob();
+                return job || !tasks.empty() || !running;
+            });
+
+            if (job)
+            {
+                const size_t slot = job->nextSlot++;
+                ++job->nUsers;
+                lock.unlock();
+
+                job->work(slot);
+
+                lock.lock();
+                if (--job->nUsers == 0)
+                    done.notify_all();
+                continue;
+            }
+
+            if (tasks.empty()) // stopped, all posted tasks are done
+                return;
+
+            const std::function<void()> task = tasks.front();
+            tasks.pop_front();
+            lock.unlock();
+
+            task();
+
+            lock.lock();
+        }
+    }
+
+    /** @return false if the loop has to be executed by the caller. */
+    bool execute(const int64_t begin, const int64_t end, const int64_t grain,
+                 const int64_t nBlocks, const util::ThreadPool::Task& task)
+    {
+        size_t nSlots = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            nSlots = std::min(size_t(nBlocks), nThreads + 1);
+            if (restarting || nSlots < 2)
+                return false;
+            ++nLoops; // keeps the workers alive until the loop is done
+        }
+
+        Job job(begin, end, grain, nSlots, task);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(&job);
+        }
+        wake.notify_all();
+
+        job.work(0);
+
+        // no new workers may join, wait for the ones still working
+        std::unique_lock<std::mutex> lock(mutex);
+        jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+        done.wait(lock, [&job] { return job.nUsers == 0; });
+        if (--nLoops == 0)
+            done.notify_all();
+        return true;
+    }
+
+    std::mutex setupMutex; //!< serializes setup()
+    std::mutex mutex;
+    std::condition_variable wake; //!< signals new work to the workers
+    std::condition_variable done; //!< signals finished loops and workers
+    std::deque<Job*> jobs;        //!< loops accepting more workers
+    std::deque<std::function<void()>> tasks; //!< posted, not yet started
+    std::vector<std::thread> threads;
+    size_t nThreads; //!< worker threads after the current setup
+    size_t nLoops;   //!< loops executed with the workers
+    bool restarting; //!< loops are executed on the caller during setup()
+    bool running;
+    int32_t affinity;
+
+private:
+    Job* _findJob() const
+    {
+        for (Job* job : jobs)
+            if (job->nextSlot < job->getNumSlots())
+                return job;
+        return 0;
+    }
+};
+}
+
+ThreadPool::ThreadPool(const size_t nThreads, const int32_t affinity)
+    : _impl(new detail::ThreadPool)
+{
+    _impl->start(nThreads, affinity);
+}
+
+ThreadPool::~ThreadPool()
+{
+    _impl->stop();
+    delete _impl;
+}
+
+void ThreadPool::setup(const size_t nThreads, const int32_t affinity)
+{
+    std::lock_guard<std::mutex> setupLock(_impl->setupMutex);
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        if (nThreads == _impl->nThreads && affinity == _impl->affinity)
+            return;
+
+        // new loops run on their caller and new tasks are queued for the new
+        // workers, or executed by the caller if there will be none
+        _impl->restarting = true;
+        _impl->nThreads = nThreads;
+    }
+
+    LBVERB << "Using " << nThreads << " pool threads, affinity " << affinity
+           << std::endl;
+    _impl->stop();
+    _impl->start(nThreads, affinity);
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->restarting = false;
+}
+
+size_t ThreadPool::getNumThreads() const
+{
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->nThreads;
+}
+
+size_t ThreadPool::getDefaultNumThreads()
+{
+    // the calling thread participates in each loop
+    const size_t nCores = std::thread::hardware_concurrency();
+    return nCores > 1 ? nCores - 1 : 0;
+}
+
+void ThreadPool::parallelFor(const int64_t begin, const int64_t end,
+                             const int64_t grain, const Task& task)
+{
+    if (begin >= end)
+        return;
+
+    const int64_t blockSize = std::max(grain, int64_t(1));
+    const int64_t nBlocks = (end - begin + blockSize - 1) / blockSize;
+    if (nBlocks > 1 && _impl->execute(begin, end, blockSize, nBlocks, task))
+        return;
+
+    for (int64_t i = begin; i < end; i += blockSize)
+        task(i, std::min(i + blockSize, end));
+}
+
+void ThreadPool::post(const std::function<void()>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        if (_impl->nThreads > 0)
+        {
+            _impl->tasks.push_back(task);
+            _impl->wake.notify_one();
+            return;
+        }
+    }
+    task();
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool pool(getDefaultNumThreads());
+    return pool;
+}
+}
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_THREADPOOL_H
+#define EQUTIL_THREADPOOL_H
+
+#include <eq/util/types.h>
+
+#include <boost/noncopyable.hpp>
+#include <functional>
+
+namespace eq
+{
+namespace util
+{
+namespace detail
+{
+class ThreadPool;
+}
+
+/**
+ * A persistent pool of worker threads executing parallel loops.
+ *
+ * The CPU compositing and image processing kernels split their work into
+ * blocks of rows which are executed by the pool, and received images are
+ * decompressed by posted tasks. The thread calling
+ * parallelFor() participates in the loop, and idle participants steal half of
+ * the remaining items of a busy participant. Unlike OpenMP parallel regions,
+ * the worker threads are created once and bound to the CPU affinity of the
+ * node, and small loops are executed directly on the calling thread.
+ *
+ * The process-wide pool returned by getInstance() is set up by each node
+ * during initialization from Node::IATTR_HINT_THREAD_POOL.
+ */
+class ThreadPool : public boost::noncopyable
+{
+public:
+    /** A task processing the items [begin, end) of a parallel loop. */
+    typedef std::function<void(int64_t begin, int64_t end)> Task;
+
+    /**
+     * Construct a new thread pool.
+     *
+     * @param nThreads the number of worker threads.
+     * @param affinity the lunchbox::Thread affinity of the worker threads.
+     * @version 2.1
+     */
+    EQ_API explicit ThreadPool(size_t nThreads, int32_t affinity = 0);
+
+    /** Destruct the thread pool and join all worker threads. @version 2.1 */
+    EQ_API ~ThreadPool();
+
+    /**
+     * Restart the pool with the given number of worker threads and affinity.
+     *
+     * Does nothing if the pool already uses the given setup. Otherwise waits
+     * for the running parallel loops and posted tasks to finish. Loops started
+     * meanwhile are executed on their calling thread. Must not be called from
+     * a pool task.
+     * @version 2.1
+     */
+    EQ_API void setup(size_t nThreads, int32_t affinity);
+
+    /** @return the number of worker threads. @version 2.1 */
+    EQ_API size_t getNumThreads() const;
+
+    /** @return the number of threads used for AUTO pool sizes. @version 2.1 */
+    EQ_API static size_t getDefaultNumThreads();
+
+    /**
+     * Execute a parallel loop and wait for its completion.
+     *
+     * The items are processed in blocks of at most grain items. Loops with no
+     * more than grain items are executed on the calling thread. Loops may be
+     * executed concurrently from multiple threads, and nested within tasks.
+     *
+     * @param begin the first item.
+     * @param end one past the last item.
+     * @param grain the number of items processed by one task invocation.
+     * @param task the loop body.
+     * @version 2.1
+     */
+    EQ_API void parallelFor(int64_t begin, int64_t end, int64_t grain,
+                            const Task& task);
+
+    /**
+     * Execute a task asynchronously on one of the worker threads.
+     *
+     * Parallel loops take precedence over posted tasks. Without worker threads
+     * the task is executed immediately on the calling thread. Tasks posted
+     * before setup() or destruction are finished beforehand.
+     *
+     * @param task the function to execute.
+     * @version 2.1
+     */
+    EQ_API void post(const std::function<void()>& task);
+
+    /** @return the process-wide thread pool. @version 2.1 */
+    EQ_API static ThreadPool& getInstance();
+
+private:
+    detail::ThreadPool* const _impl;
+};
+}
+}
+
+#endif // EQUTIL_THREADPOOL_H
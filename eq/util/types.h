@@ -30,8 +30,11 @@ namespace util
 class Accum;
 class AccumBufferObject;
 class FrameBufferObject;
+class PixelArena;
 class PixelBufferObject;
+class SharedMemoryRing;
 class Texture;
+class ThreadPool;
 class BitmapFont;
 class ObjectManager;
 
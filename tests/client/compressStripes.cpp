@@ -0,0 +1,133 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that large images are compressed in concurrent stripes, and that the
+// stripes of lossless compressors decompress bit-exactly.
+
+#include <lunchbox/test.h>
+
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/util/threadPool.h>
+#include <pression/plugin.h>
+#include <pression/pluginRegistry.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+const eq::PixelViewport _pvp(16, 8, 1024, 767);
+const size_t _nStripes = 4;
+
+/** Fill the image with compressible, noisy gradients. */
+void _fill(eq::Image& image, const eq::PixelViewport& pvp)
+{
+    std::mt19937 rng(42);
+    std::vector<uint8_t> color(pvp.getArea() * 4);
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            uint8_t* pixel = &color[(size_t(y) * pvp.w + x) * 4];
+            pixel[0] = uint8_t(x);
+            pixel[1] = uint8_t(y);
+            pixel[2] = uint8_t((x / 64) * 16 + rng() % 4);
+            pixel[3] = 255;
+        }
+    }
+
+    image.setPixelViewport(pvp);
+
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    pixels.pixels = color.data();
+    image.setPixelData(eq::Frame::Buffer::color, pixels);
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+    eq::util::ThreadPool::getInstance().setup(_nStripes - 1, 0);
+
+    const eq::Frame::Buffer buffer = eq::Frame::Buffer::color;
+    const auto& registry = pression::PluginRegistry::getInstance();
+    eq::Image image;
+    image.setAlphaUsage(true);
+    _fill(image, _pvp);
+
+    const size_t size = image.getPixelDataSize(buffer);
+    const std::vector<uint32_t> names = image.findCompressors(buffer);
+    TEST(!names.empty());
+
+    size_t nLossless = 0;
+    for (const uint32_t name : names)
+    {
+        TEST(image.allocCompressor(buffer, name));
+        const eq::PixelData& compressed = image.compressPixelData(buffer);
+        TEST(compressed.compressedData.compressor == name);
+        TESTINFO(compressed.compressedStripes.size() == _nStripes, name);
+
+        size_t nRows = 0;
+        size_t nChunks = 0;
+        for (const eq::Vector2ui& stripe : compressed.compressedStripes)
+        {
+            nRows += stripe.x();
+            nChunks += stripe.y();
+        }
+        TEST(nRows == size_t(_pvp.h));
+        TEST(nChunks == compressed.compressedData.chunks.size());
+
+        eq::Image destImage;
+        destImage.setAlphaUsage(true);
+        destImage.setPixelViewport(_pvp);
+        destImage.setPixelData(buffer, compressed);
+        TEST(destImage.hasPixelData(buffer));
+
+        const pression::Plugin* plugin = registry.findPlugin(name);
+        TEST(plugin);
+        if (plugin->findInfo(name).quality >= 1.f &&
+            destImage.getExternalFormat(buffer) == EQ_COMPRESSOR_DATATYPE_RGBA)
+        {
+            ++nLossless;
+            TEST(destImage.getPixelDataSize(buffer) == size);
+            TESTINFO(memcmp(image.getPixelPointer(buffer),
+                            destImage.getPixelPointer(buffer), size) == 0,
+                     "0x" << std::hex << name << std::dec);
+        }
+        destImage.resetPlugins();
+    }
+    TEST(nLossless > 0);
+
+    // small images are compressed at once
+    _fill(image, eq::PixelViewport(0, 0, 64, 64));
+    TEST(image.allocCompressor(buffer, names.front()));
+    TEST(image.compressPixelData(buffer).compressedStripes.empty());
+
+    image.resetPlugins();
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the cost model of the compressor selector, the measurement of unknown
+// and failing compressors and the periodic retry of the oldest measurement.
+
+#include <lunchbox/test.h>
+
+#include <eq/detail/compressorSelector.h>
+#include <pression/plugins/compressor.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+const uint32_t _good = 0x1001;  // compresses to a quarter
+const uint32_t _bad = 0x1002;   // produces no compressed data
+const uint64_t _size = 1024000; // bytes of one image
+const int64_t _bandwidth = 1000; // KB/s, that is, 1024 bytes per ms
+
+bool _equal(const float a, const float b)
+{
+    return std::abs(a - b) <= 1e-3f * std::abs(b);
+}
+
+void _measure(eq::detail::CompressorSelector& selector, const uint32_t name)
+{
+    if (name == _good)
+        selector.addCompression(_good, _size, _size / 4, 100.f);
+    else if (name == _bad)
+        selector.addCompression(_bad, _size, _size, 50.f);
+}
+}
+
+int main(int, char**)
+{
+    eq::detail::CompressorSelector selector(_bandwidth);
+    TEST(_equal(selector.getBandwidth(), 1024.f));
+    TEST(_equal(selector.getTransferTime(EQ_COMPRESSOR_NONE, _size, false),
+                1000.f));
+
+    // unmeasured compressors are tried first, in order
+    const std::vector<uint32_t> candidates = {_good, _bad};
+    TEST(selector.choose(candidates, _size, EQ_COMPRESSOR_NONE) == _good);
+    _measure(selector, _good);
+    TEST(selector.choose(candidates, _size, EQ_COMPRESSOR_NONE) == _bad);
+    _measure(selector, _bad);
+
+    // compress and decompress 100 ms each, send a quarter of 1000 ms
+    TEST(_equal(selector.getTransferTime(_good, _size, false), 450.f));
+    // already compressed data only has to be decompressed
+    TEST(_equal(selector.getTransferTime(_good, _size, true), 350.f));
+    // the failing compressor sends everything after trying to compress
+    TEST(_equal(selector.getTransferTime(_bad, _size, false), 1100.f));
+
+    // the best compressor is used, and every 16th choice retries the other
+    for (size_t i = 3; i <= 48; ++i)
+    {
+        const uint32_t name =
+            selector.choose(candidates, _size, EQ_COMPRESSOR_NONE);
+        TESTINFO(name == (i % 16 == 0 ? _bad : _good), i << ": " << name);
+        _measure(selector, name);
+    }
+
+    // a failing compressor is not used on its own, except for retries
+    const std::vector<uint32_t> bad = {_bad};
+    TEST(selector.choose(bad, _size, EQ_COMPRESSOR_NONE) ==
+         EQ_COMPRESSOR_NONE);
+
+    // small sends don't measure the bandwidth, larger ones are averaged
+    selector.addTransmission(1000, 1.f);
+    TEST(_equal(selector.getBandwidth(), 1024.f));
+    selector.addTransmission(_size, 500.f);
+    TEST(_equal(selector.getBandwidth(), 1280.f));
+    return EXIT_SUCCESS;
+}
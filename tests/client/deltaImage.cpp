@@ -0,0 +1,292 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the temporal delta encoding of images: the round trip of changed
+// tiles, keyframes, partial edge tiles, compressed deltas and the rejection of
+// deltas without a matching reference or out of sequence on the receiving side.
+
+#include <lunchbox/test.h>
+
+#include <eq/detail/deltaImage.h>
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugin.h>
+#include <pression/pluginRegistry.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+using eq::detail::DeltaImage;
+
+const eq::Frame::Buffer _buffer = eq::Frame::Buffer::color;
+// 3x2 tiles, the last column and row of tiles are partial
+const eq::PixelViewport _pvp(8, 4, 150, 70);
+const uint32_t _interval = 2;
+
+/** An RGBA source image and the destination reconstructing it. */
+class Stream
+{
+public:
+    Stream()
+        : sender(_buffer)
+        , receiver(_buffer)
+        , color(_pvp.getArea() * 4)
+    {
+        std::mt19937 rng(42);
+        for (uint8_t& value : color)
+            value = uint8_t(rng());
+        image.setAlphaUsage(true);
+        image.setPixelViewport(_pvp);
+    }
+
+    eq::PixelData getPixels(const eq::PixelViewport& pvp = _pvp,
+                            const uint32_t format = EQ_COMPRESSOR_DATATYPE_RGBA)
+    {
+        eq::PixelData pixels;
+        pixels.internalFormat = format;
+        pixels.externalFormat = format;
+        pixels.pixelSize = 4;
+        pixels.pvp = pvp;
+        pixels.pixels = color.data();
+        return pixels;
+    }
+
+    void setPixel(const int32_t x, const int32_t y, const uint32_t value)
+    {
+        ::memcpy(&color[(size_t(y) * _pvp.w + x) * 4], &value, 4);
+    }
+
+    /** Encode the source and reconstruct it on the destination. */
+    bool transmit(const uint32_t compressor = EQ_COMPRESSOR_NONE,
+                  const eq::PixelViewport& pvp = _pvp,
+                  const uint32_t format = EQ_COMPRESSOR_DATATYPE_RGBA)
+    {
+        const eq::PixelData pixels = getPixels(pvp, format);
+        image.setPixelViewport(pvp);
+        const bool isDelta = sender.encode(pixels, _interval);
+        const uint32_t sequence = sender.getSequence();
+        if (!isDelta)
+        {
+            ++nKeyframes;
+            return receiver.receive(image, pvp, 0, 0, pixels, sequence);
+        }
+
+        const std::vector<uint64_t>& tiles = sender.getTiles();
+        if (sender.getNumChanged() == 0)
+        {
+            // only the tile mask and the pixel format are sent
+            eq::PixelData format_ = pixels;
+            format_.pvp = eq::PixelViewport();
+            format_.pixels = 0;
+            return receiver.receive(image, pvp, tiles.data(), tiles.size(),
+                                    format_, sequence);
+        }
+        return receiver.receive(image, pvp, tiles.data(), tiles.size(),
+                                sender.compress(compressor), sequence);
+    }
+
+    bool isReconstructed() const
+    {
+        return image.hasPixelData(_buffer) &&
+               image.getPixelDataSize(_buffer) == color.size() &&
+               ::memcmp(image.getPixelPointer(_buffer), color.data(),
+                        color.size()) == 0;
+    }
+
+    DeltaImage sender;
+    DeltaImage receiver;
+    eq::Image image;
+    std::vector<uint8_t> color;
+    size_t nKeyframes = 0;
+};
+
+void _testRoundTrip()
+{
+    Stream stream;
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.isReconstructed());
+
+    // one pixel in the first tile
+    stream.setPixel(0, 0, 0xdeadbeef);
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.sender.getNumChanged() == 1);
+    TEST(stream.sender.getTiles().size() == 1);
+    TEST(stream.sender.getTiles()[0] == 1);
+    TEST(stream.isReconstructed());
+
+    // the last pixel lies in the partial last tile
+    stream.setPixel(_pvp.w - 1, _pvp.h - 1, 0xcafebabe);
+    stream.setPixel(DeltaImage::tileSize, _pvp.h - 1, 0x01020304);
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.sender.getNumChanged() == 2);
+    TEST(stream.sender.getTiles()[0] == ((1u << 5) | (1u << 4)));
+    TEST(stream.receiver.getNumChanged() == 2);
+    TEST(stream.isReconstructed());
+}
+
+void _testKeyframes()
+{
+    Stream stream;
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+
+    // unchanged images send the tile mask only
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.sender.getNumChanged() == 0);
+    TEST(DeltaImage::countTiles(stream.sender.getTiles().data(),
+                                stream.sender.getTiles().size()) == 0);
+    TEST(stream.isReconstructed());
+
+    // a keyframe follows the given number of deltas
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 2);
+    TEST(stream.isReconstructed());
+
+    // changes of the layout or the format force a keyframe
+    const eq::PixelViewport smaller(_pvp.x, _pvp.y, _pvp.w, _pvp.h - 1);
+    TEST(stream.transmit(EQ_COMPRESSOR_NONE, smaller));
+    TEST(stream.nKeyframes == 3);
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 4);
+    TEST(stream.transmit(EQ_COMPRESSOR_NONE, _pvp,
+                         EQ_COMPRESSOR_DATATYPE_BGRA));
+    TEST(stream.nKeyframes == 5);
+    TEST(stream.receiver.getReference().externalFormat ==
+         EQ_COMPRESSOR_DATATYPE_BGRA);
+    TEST(stream.isReconstructed());
+}
+
+void _testMismatch()
+{
+    Stream stream;
+    TEST(stream.transmit());
+
+    // a receiver which missed the keyframe rejects all deltas
+    stream.receiver.flush();
+    stream.setPixel(1, 1, 0xdeadbeef);
+    TEST(!stream.transmit());
+    TEST(!stream.receiver.getReference().pixels);
+    TEST(!stream.transmit());
+
+    // until the next keyframe
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 2);
+    TEST(stream.isReconstructed());
+
+    // deltas of another layout are rejected
+    const std::vector<uint64_t> tiles(1, 1);
+    eq::PixelData pixels = stream.getPixels();
+    pixels.pvp = DeltaImage::getPackedPVP(1);
+    const eq::PixelViewport other(0, 0, _pvp.w + 1, _pvp.h);
+    TEST(!stream.receiver.receive(stream.image, other, tiles.data(),
+                                  tiles.size(), pixels,
+                                  stream.receiver.getSequence() + 1));
+    TEST(!stream.receiver.getReference().pixels);
+}
+
+void _testSequence()
+{
+    Stream stream;
+    TEST(stream.transmit());
+    TEST(stream.sender.getSequence() == 1);
+    TEST(stream.receiver.getSequence() == 1);
+
+    // a lost delta breaks the sequence, the next delta is rejected although
+    // the receiver still has a reference of the same layout
+    stream.setPixel(1, 1, 0xdeadbeef);
+    TEST(stream.sender.encode(stream.getPixels(), _interval));
+    stream.setPixel(2, 2, 0xcafebabe);
+    TEST(!stream.transmit());
+    TEST(stream.nKeyframes == 1);
+    TEST(stream.sender.getSequence() == 3);
+    TEST(stream.receiver.getSequence() == 1);
+    TEST(!stream.receiver.getReference().pixels);
+
+    // a requested keyframe restores the image
+    stream.sender.flush();
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 2);
+    TEST(stream.receiver.getSequence() == 4);
+    TEST(stream.isReconstructed());
+
+    stream.setPixel(3, 3, 0x01020304);
+    TEST(stream.transmit());
+    TEST(stream.nKeyframes == 2);
+    TEST(stream.isReconstructed());
+}
+
+void _testCompressed()
+{
+    const auto& registry = pression::PluginRegistry::getInstance();
+    Stream probe;
+    TEST(probe.transmit());
+    const std::vector<uint32_t> names = probe.image.findCompressors(_buffer);
+    TEST(!names.empty());
+
+    size_t nLossless = 0;
+    for (const uint32_t name : names)
+    {
+        const pression::Plugin* plugin = registry.findPlugin(name);
+        TEST(plugin);
+        if (plugin->findInfo(name).quality < 1.f)
+            continue;
+
+        Stream stream;
+        TEST(stream.transmit());
+        stream.setPixel(_pvp.w - 1, 0, 0xdeadbeef);
+        TESTINFO(stream.transmit(name), "0x" << std::hex << name);
+        TEST(stream.receiver.getNumChanged() == 1);
+        TESTINFO(stream.isReconstructed(), "0x" << std::hex << name);
+        ++nLossless;
+    }
+    TEST(nLossless > 0);
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    TEST(DeltaImage::getNumWords(_pvp) == 1);
+    TEST(DeltaImage::getNumWords(eq::PixelViewport(0, 0, 640, 512)) == 2);
+    TEST(DeltaImage::getPackedPVP(3) ==
+         eq::PixelViewport(0, 0, DeltaImage::tileSize,
+                           3 * DeltaImage::tileSize));
+
+    _testRoundTrip();
+    _testKeyframes();
+    _testMismatch();
+    _testSequence();
+    _testCompressed();
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
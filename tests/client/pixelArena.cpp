@@ -0,0 +1,145 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the size buckets, block reuse, cache limit and statistics of the pixel
+// arena, also under concurrent use.
+
+#include <lunchbox/test.h>
+
+#include <eq/util/pixelArena.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void _testBuckets()
+{
+    typedef eq::util::PixelArena Arena;
+    TEST(Arena::getBucketSize(1) == 4096);
+    TEST(Arena::getBucketSize(4096) == 4096);
+    TEST(Arena::getBucketSize(4097) == 5120);
+    TEST(Arena::getBucketSize(8192) == 8192);
+    TEST(Arena::getBucketSize(8193) == 10240);
+
+    for (size_t size = 1; size < (1u << 24); size = size * 3 / 2 + 1)
+    {
+        const size_t bucket = Arena::getBucketSize(size);
+        TESTINFO(bucket >= size, size);
+        TESTINFO(bucket <= 4096 || bucket * 4 <= size * 5, size);
+        TEST(Arena::getBucketSize(bucket) == bucket);
+    }
+}
+
+void _testReuse()
+{
+    eq::util::PixelArena arena(1024 * 1024, 0);
+    size_t capacity = 0;
+    void* first = arena.allocate(100000, capacity);
+    TEST(first);
+    TEST(capacity == eq::util::PixelArena::getBucketSize(100000));
+    memset(first, 0xFF, capacity);
+
+    eq::util::PixelArena::Stats stats = arena.getStats();
+    TEST(stats.inUse == capacity);
+    TEST(stats.cached == 0);
+    TEST(stats.highWater == capacity);
+    TEST(stats.nAllocated == 1);
+
+    // a request of a similar size reuses the released block
+    arena.release(first);
+    size_t reused = 0;
+    TEST(arena.allocate(99000, reused) == first);
+    TEST(reused == capacity);
+    stats = arena.getStats();
+    TEST(stats.nRequests == 2);
+    TEST(stats.nHits == 1);
+    TEST(stats.nAllocated == 1);
+
+    // a different bucket needs a new block
+    size_t other = 0;
+    void* second = arena.allocate(300000, other);
+    TEST(second && second != first);
+    stats = arena.getStats();
+    TEST(stats.inUse == capacity + other);
+    TEST(stats.highWater == capacity + other);
+
+    arena.release(first);
+    arena.release(second);
+    stats = arena.getStats();
+    TEST(stats.inUse == 0);
+    TEST(stats.cached == capacity + other);
+    TEST(stats.highWater == capacity + other);
+
+    arena.resetHighWater();
+    TEST(arena.getStats().highWater == 0);
+
+    // blocks exceeding the cache limit are returned to the system
+    size_t large = 0;
+    void* block = arena.allocate(2 * 1024 * 1024, large);
+    arena.release(block);
+    stats = arena.getStats();
+    TEST(stats.cached == capacity + other);
+    TEST(stats.nReleased == 1);
+
+    arena.setup(capacity, 0);
+    TEST(arena.getStats().cached <= capacity);
+    arena.clear();
+    TEST(arena.getStats().cached == 0);
+}
+
+void _testConcurrency()
+{
+    eq::util::PixelArena arena(64 * 1024 * 1024,
+                               eq::util::PixelArena::getDefaultFlags());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&arena, i] {
+            for (size_t j = 0; j < 1000; ++j)
+            {
+                const size_t size = 1000 + ((i * 7919 + j * 104729) % 3000000);
+                size_t capacity = 0;
+                uint8_t* data =
+                    static_cast<uint8_t*>(arena.allocate(size, capacity));
+                TEST(data && capacity >= size);
+                data[0] = uint8_t(i);
+                data[size - 1] = uint8_t(j);
+                TEST(data[0] == uint8_t(i));
+                arena.release(data);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    const eq::util::PixelArena::Stats stats = arena.getStats();
+    TEST(stats.inUse == 0);
+    TEST(stats.nRequests == 8000);
+    TEST(stats.nHits + stats.nAllocated == stats.nRequests);
+    TEST(stats.highWater <= 8 * eq::util::PixelArena::getBucketSize(3001000));
+}
+}
+
+int main(int, char**)
+{
+    _testBuckets();
+    _testReuse();
+    _testConcurrency();
+    return EXIT_SUCCESS;
+}
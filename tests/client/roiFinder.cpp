@@ -0,0 +1,296 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the CPU ROI finder on synthetic images in main memory: regions of
+// depth and color images, the foreground masks of the pixel formats, and the
+// optional cropping of read back images to their regions.
+
+#include <lunchbox/test.h>
+
+#include <eq/frameData.h>
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/roiFinder.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+const eq::PixelViewport _pvp(0, 0, 256, 256);
+const uint32_t _farDepth = 0xFFFFFFFFu;
+const uint32_t _black = 0xFF000000u; // opaque black RGBA
+
+/** Images with a background and rectangles of foreground pixels. */
+struct Scene
+{
+    explicit Scene(const eq::PixelViewport& pvp_)
+        : pvp(pvp_)
+        , color(pvp_.getArea(), _black)
+        , depth(pvp_.getArea(), _farDepth)
+    {
+    }
+
+    size_t getIndex(const int32_t x, const int32_t y) const
+    {
+        return size_t(y - pvp.y) * pvp.w + x - pvp.x;
+    }
+
+    void add(const eq::PixelViewport& rect)
+    {
+        for (int32_t y = rect.y; y < rect.y + rect.h; ++y)
+            for (int32_t x = rect.x; x < rect.x + rect.w; ++x)
+            {
+                color[getIndex(x, y)] = _black | uint32_t(x << 8 | y);
+                depth[getIndex(x, y)] = uint32_t(x * 1000 + y);
+            }
+    }
+
+    void setImage(eq::Image& image, const bool useDepth) const
+    {
+        image.setPixelViewport(pvp);
+
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = pvp;
+        pixels.pixels = const_cast<uint32_t*>(color.data());
+        image.setPixelData(eq::Frame::Buffer::color, pixels);
+        if (!useDepth)
+            return;
+
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+        pixels.pixels = const_cast<uint32_t*>(depth.data());
+        image.setPixelData(eq::Frame::Buffer::depth, pixels);
+    }
+
+    const eq::PixelViewport pvp;
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+};
+
+/** @return the regions found in the given image by a new finder. */
+eq::PixelViewports _findRegions(const eq::Image& image)
+{
+    eq::ROIFinder finder;
+    return finder.findRegions(image, 0, eq::RenderContext());
+}
+
+bool _contains(const eq::PixelViewport& outer, const eq::PixelViewport& inner)
+{
+    eq::PixelViewport pvp = inner;
+    pvp.intersect(outer);
+    return pvp == inner;
+}
+
+/** @return true if the rectangle is covered by the regions. */
+bool _covers(const eq::PixelViewports& regions, const eq::PixelViewport& rect)
+{
+    for (int32_t y = rect.y; y < rect.y + rect.h; ++y)
+        for (int32_t x = rect.x; x < rect.x + rect.w; ++x)
+        {
+            bool covered = false;
+            for (const eq::PixelViewport& region : regions)
+                covered = covered || _contains(region, eq::PixelViewport(
+                                                           x, y, 1, 1));
+            if (!covered)
+                return false;
+        }
+    return true;
+}
+
+uint32_t _getArea(const eq::PixelViewports& regions)
+{
+    uint32_t area = 0;
+    for (const eq::PixelViewport& region : regions)
+        area += region.getArea();
+    return area;
+}
+
+void _testRegions(const bool useDepth)
+{
+    const eq::PixelViewport rect(40, 100, 40, 40);
+    const eq::PixelViewport aligned(32, 96, 48, 48); // 16 pixel blocks
+    Scene scene(_pvp);
+    scene.add(rect);
+    eq::Image image;
+    scene.setImage(image, useDepth);
+
+    const eq::PixelViewports& regions = _findRegions(image);
+    TEST(!regions.empty());
+    TEST(_covers(regions, rect));
+    for (const eq::PixelViewport& region : regions)
+        TESTINFO(_contains(aligned, region), region);
+
+    // distant objects are found separately
+    const eq::PixelViewport other(200, 8, 30, 20);
+    scene.add(other);
+    scene.setImage(image, useDepth);
+
+    const eq::PixelViewports& both = _findRegions(image);
+    TEST(_covers(both, rect));
+    TEST(_covers(both, other));
+    TESTINFO(_getArea(both) < _pvp.getArea() / 4, _getArea(both));
+
+    // empty images have no regions
+    Scene empty(_pvp);
+    empty.setImage(image, useDepth);
+    TEST(_getArea(_findRegions(image)) == 0);
+}
+
+void _testFormats()
+{
+    // the alpha channel and the sign of floats are not foreground
+    const eq::PixelViewport rect(130, 20, 10, 10);
+    std::vector<float> pixels(_pvp.getArea() * 4, 0.f);
+    for (size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i] = -0.f;
+        pixels[i + 3] = 1.f;
+    }
+    for (int32_t y = rect.y; y < rect.y + rect.h; ++y)
+        for (int32_t x = rect.x; x < rect.x + rect.w; ++x)
+            pixels[(size_t(y) * _pvp.w + x) * 4 + 1] = .5f;
+
+    eq::Image image;
+    image.setPixelViewport(_pvp);
+    eq::PixelData data;
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+    data.pixelSize = 16;
+    data.pvp = _pvp;
+    data.pixels = pixels.data();
+    image.setPixelData(eq::Frame::Buffer::color, data);
+
+    const eq::PixelViewports& regions = _findRegions(image);
+    TEST(_covers(regions, rect));
+    TESTINFO(_getArea(regions) <= 32 * 32, _getArea(regions));
+
+    // pixels not made of 32 bit values are not analysed
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_RGB;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_RGB;
+    data.pixelSize = 3;
+    image.setPixelData(eq::Frame::Buffer::color, data);
+    TEST(_findRegions(image) == eq::PixelViewports(1, _pvp));
+}
+
+void _testCrop()
+{
+    // unaligned image, the grid of the finder is aligned to the window
+    const eq::PixelViewport pvp(8, 4, 200, 150);
+    const eq::PixelViewport rect(50, 60, 20, 10);
+    Scene scene(pvp);
+    scene.add(rect);
+
+    // images are only cropped on request, and if they have depth
+    eq::Image image;
+    scene.setImage(image, true);
+    eq::FrameData frameData;
+    eq::ROIFinder finder;
+    frameData.cropImage(image, finder);
+    TEST(image.getPixelViewport() == pvp);
+
+    frameData.setCropImages(true);
+    scene.setImage(image, false);
+    frameData.cropImage(image, finder);
+    TEST(image.getPixelViewport() == pvp);
+
+    // delta encoding needs images of a constant size
+    frameData.setDeltaInterval(4);
+    scene.setImage(image, true);
+    frameData.cropImage(image, finder);
+    TEST(image.getPixelViewport() == pvp);
+
+    frameData.setDeltaInterval(0);
+    frameData.cropImage(image, finder);
+
+    const eq::PixelViewport& cropped = image.getPixelViewport();
+    TESTINFO(_contains(cropped, rect), cropped);
+    TESTINFO(_contains(eq::PixelViewport(48, 48, 32, 32), cropped), cropped);
+
+    const eq::Frame::Buffer color = eq::Frame::Buffer::color;
+    const eq::Frame::Buffer depth = eq::Frame::Buffer::depth;
+    TEST(image.hasPixelData(color));
+    TEST(image.hasPixelData(depth));
+    TEST(image.getPixelData(color).pvp.getArea() == cropped.getArea());
+
+    const uint32_t* pixels =
+        reinterpret_cast<const uint32_t*>(image.getPixelPointer(color));
+    const uint32_t* depths =
+        reinterpret_cast<const uint32_t*>(image.getPixelPointer(depth));
+    for (int32_t y = 0; y < cropped.h; ++y)
+        for (int32_t x = 0; x < cropped.w; ++x)
+        {
+            const size_t i = size_t(y) * cropped.w + x;
+            const int32_t px = cropped.x + x;
+            const int32_t py = cropped.y + y;
+            TEST(pixels[i] == scene.color[scene.getIndex(px, py)]);
+            TEST(depths[i] == scene.depth[scene.getIndex(px, py)]);
+        }
+
+    // empty images keep one pixel
+    Scene empty(pvp);
+    empty.setImage(image, true);
+    frameData.cropImage(image, finder);
+    TEST(image.getPixelViewport().getArea() == 1);
+}
+
+void _testCropMotion()
+{
+    // a moving object in a still view is never cut by predicted regions
+    eq::FrameData frameData;
+    frameData.setCropImages(true);
+    eq::ROIFinder finder;
+    eq::RenderContext context;
+    context.pvp = _pvp;
+
+    for (int32_t i = 0; i < 8; ++i)
+    {
+        const eq::PixelViewport rect(20 + 24 * i, 40, 20, 10);
+        Scene scene(_pvp);
+        scene.add(rect);
+
+        eq::Image image;
+        scene.setImage(image, true);
+        context.frameID = eq::uint128_t(i + 1);
+        image.setContext(context);
+        frameData.cropImage(image, finder);
+        TESTINFO(_contains(image.getPixelViewport(), rect),
+                 i << ": " << image.getPixelViewport());
+    }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    _testRegions(true);
+    _testRegions(false);
+    _testFormats();
+    _testCrop();
+    _testCropMotion();
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the prediction of regions of interest by the ROI tracker: predicted
+// regions follow the motion of the view, analyses resume after the interval,
+// and overflowing predictions fall back to an analysis.
+
+#include <lunchbox/test.h>
+
+#include <eq/roiTracker.h>
+
+#include <cstdlib>
+
+namespace
+{
+const eq::PixelViewport _pvp(0, 0, 400, 300);
+const eq::PixelViewport _region(100, 100, 50, 40);
+const uint32_t _interval = 8;
+
+/** @return a window space translation. */
+eq::Matrix4f _translate(const float x, const float y)
+{
+    eq::Matrix4f matrix;
+    matrix(0, 3) = x;
+    matrix(1, 3) = y;
+    return matrix;
+}
+
+/** Drives a tracker frame by frame, using a fixed region as analysis. */
+class Frames
+{
+public:
+    Frames()
+        : _frame(0)
+    {
+    }
+
+    /** @return true if the frame was analysed, the regions otherwise. */
+    bool next(const eq::Matrix4f& transform, eq::PixelViewports& regions,
+              const uint32_t interval = _interval)
+    {
+        uint8_t* ticket = 0;
+        if (!_tracker.useROIFinder(_pvp, 0, eq::uint128_t(++_frame),
+                                   transform, interval, ticket, regions))
+        {
+            return false;
+        }
+        _tracker.updateDelay(eq::PixelViewports(1, _region), ticket);
+        return true;
+    }
+
+private:
+    eq::ROITracker _tracker;
+    uint64_t _frame;
+};
+
+void _testMotion()
+{
+    Frames frames;
+    eq::PixelViewports regions;
+    TEST(frames.next(eq::Matrix4f(), regions));
+
+    // a still view reuses the found regions
+    TEST(!frames.next(eq::Matrix4f(), regions));
+    TEST(regions == eq::PixelViewports(1, _region));
+
+    // regions grow by the motion of their corners, in all directions
+    TEST(!frames.next(_translate(5.f, -3.f), regions));
+    TEST(regions.size() == 1);
+    TESTINFO(regions[0] == eq::PixelViewport(_region.x - 5, _region.y - 5,
+                                             _region.w + 10, _region.h + 10),
+             regions[0]);
+
+    // the motion is measured from the last prediction
+    TEST(!frames.next(_translate(5.5f, -3.f), regions));
+    TESTINFO(regions[0] == eq::PixelViewport(_region.x - 6, _region.y - 6,
+                                             _region.w + 12, _region.h + 12),
+             regions[0]);
+
+    // predictions are clipped to the pvp
+    TEST(!frames.next(_translate(5.5f, 102.f), regions));
+    TESTINFO(regions[0] == eq::PixelViewport(0, 0, 261, 251), regions[0]);
+}
+
+void _testInterval()
+{
+    Frames frames;
+    eq::PixelViewports regions;
+    TEST(frames.next(eq::Matrix4f(), regions));
+    for (uint32_t i = 1; i < _interval; ++i)
+        TESTINFO(!frames.next(eq::Matrix4f(), regions), i);
+
+    // the analysis resumes after the interval
+    TEST(frames.next(eq::Matrix4f(), regions));
+    TEST(regions == eq::PixelViewports(1, _pvp));
+    TEST(!frames.next(eq::Matrix4f(), regions));
+
+    // without interval, each frame is analysed
+    Frames unpredicted;
+    TEST(unpredicted.next(eq::Matrix4f(), regions, 0));
+    TEST(unpredicted.next(eq::Matrix4f(), regions, 0));
+}
+
+void _testOverflow()
+{
+    Frames frames;
+    eq::PixelViewports regions;
+    TEST(frames.next(eq::Matrix4f(), regions));
+
+    // dilated regions covering most of the pvp are analysed again
+    TEST(frames.next(_translate(200.f, 0.f), regions));
+    TEST(regions == eq::PixelViewports(1, _pvp));
+
+    // as are motions which can't be estimated, e.g., behind the viewer
+    TEST(!frames.next(_translate(200.f, 0.f), regions));
+    eq::Matrix4f flip = _translate(200.f, 0.f);
+    flip(3, 3) = -1.f;
+    TEST(frames.next(flip, regions));
+}
+}
+
+int main(int, char**)
+{
+    _testMotion();
+    _testInterval();
+    _testOverflow();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the allocation, wrap-around and out-of-order release of the shared
+// memory ring, with the reader in a separate process.
+
+#include <lunchbox/test.h>
+
+#include <eq/util/sharedMemoryRing.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+typedef eq::util::SharedMemoryRing Ring;
+const size_t _capacity = 1024 * 1024;
+
+/** Fill the region with a pattern depending on its index. */
+void _fill(void* data, const Ring::Region& region, const size_t index)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (uint64_t i = 0; i < region.size; ++i)
+        bytes[i] = uint8_t(i * 7 + index);
+}
+
+/** Verify and release the regions in reverse order in a child process. */
+void _read(const std::string& name, const std::vector<Ring::Region>& regions)
+{
+    const pid_t pid = ::fork();
+    TEST(pid >= 0);
+    if (pid == 0)
+    {
+        Ring reader(name);
+        if (!reader.isValid() || reader.getCapacity() != _capacity)
+            ::_exit(EXIT_FAILURE);
+
+        for (size_t i = regions.size(); i > 0; --i)
+        {
+            const Ring::Region& region = regions[i - 1];
+            const uint8_t* bytes =
+                static_cast<const uint8_t*>(reader.getData(region));
+            if (!bytes)
+                ::_exit(EXIT_FAILURE);
+            for (uint64_t j = 0; j < region.size; ++j)
+                if (bytes[j] != uint8_t(j * 7 + i - 1))
+                    ::_exit(EXIT_FAILURE);
+            reader.release(region);
+        }
+        ::_exit(EXIT_SUCCESS);
+    }
+
+    int status = 0;
+    TEST(::waitpid(pid, &status, 0) == pid);
+    TEST(WIFEXITED(status));
+    TEST(WEXITSTATUS(status) == EXIT_SUCCESS);
+}
+}
+
+int main(int, char**)
+{
+    std::ostringstream name;
+    name << "/eqTestSharedMemoryRing." << ::getpid();
+
+    Ring writer(name.str(), _capacity);
+    TEST(writer.isValid());
+    TEST(writer.getCapacity() == _capacity);
+    TEST(writer.getUsed() == 0);
+
+    // fill the ring, the last region does not fit
+    const size_t size = 400000;
+    std::vector<Ring::Region> regions;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Ring::Region region;
+        void* data = writer.allocate(size, region);
+        if (i == 2)
+        {
+            TEST(!data);
+            break;
+        }
+        TEST(data);
+        TEST(region.offset == i * size);
+        _fill(data, region, regions.size());
+        regions.push_back(region);
+    }
+    TEST(writer.getUsed() == 2 * size);
+
+    _read(name.str(), regions);
+    TEST(writer.getUsed() == 0);
+
+    // the next region wraps around, skipping the end of the ring
+    regions.clear();
+    for (size_t i = 0; i < 2; ++i)
+    {
+        Ring::Region region;
+        void* data = writer.allocate(size, region);
+        TEST(data);
+        _fill(data, region, regions.size());
+        regions.push_back(region);
+    }
+    TEST(regions[0].begin == 2 * size);
+    TEST(regions[0].offset == 0);
+    TEST(regions[1].offset == size);
+    TEST(writer.getUsed() == _capacity);
+
+    Ring::Region region;
+    TEST(!writer.allocate(1, region));
+
+    _read(name.str(), regions);
+    TEST(writer.getUsed() == 0);
+
+    TEST(!writer.allocate(_capacity + 1, region));
+    TEST(!Ring(name.str() + ".missing").isValid());
+    return EXIT_SUCCESS;
+}
+#else
+int main(int, char**)
+{
+    return EXIT_SUCCESS; // shared memory rings are not supported
+}
+#endif
@@ -0,0 +1,165 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that the thread pool executes each item of concurrent and nested
+// parallel loops exactly once, and each posted task exactly once, also while
+// the pool is resized.
+
+#include <lunchbox/test.h>
+
+#include <eq/util/threadPool.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void _testLoops(eq::util::ThreadPool& pool)
+{
+    for (int64_t size = 0; size < 1000; size += 37)
+    {
+        for (int64_t grain = 1; grain < 20; grain += 6)
+        {
+            std::vector<std::atomic<int>> counts(size);
+            for (std::atomic<int>& count : counts)
+                count = 0;
+
+            pool.parallelFor(-7, size - 7, grain,
+                             [&](const int64_t begin, const int64_t end) {
+                                 TEST(begin < end);
+                                 TEST(end - begin <= grain);
+                                 for (int64_t i = begin; i < end; ++i)
+                                     ++counts[i + 7];
+                             });
+
+            for (const std::atomic<int>& count : counts)
+                TEST(count == 1);
+        }
+    }
+}
+
+void _testConcurrentLoops(eq::util::ThreadPool& pool)
+{
+    const int64_t nOuter = 64;
+    const int64_t nInner = 10;
+    const size_t nLoops = 100;
+    std::atomic<int64_t> sum(0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < nLoops; ++j)
+            {
+                pool.parallelFor(
+                    0, nOuter, 4, [&](const int64_t begin, const int64_t end) {
+                        pool.parallelFor(begin * nInner, end * nInner, 3,
+                                         [&](const int64_t first,
+                                             const int64_t last) {
+                                             sum += last - first;
+                                         });
+                    });
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+    TEST(sum == int64_t(threads.size() * nLoops) * nOuter * nInner);
+}
+
+void _testPost(eq::util::ThreadPool& pool)
+{
+    const size_t nTasks = 1000;
+    std::atomic<size_t> nDone(0);
+    std::atomic<int64_t> sum(0);
+    for (size_t i = 0; i < nTasks; ++i)
+    {
+        pool.post([&] {
+            // posted tasks may run parallel loops
+            pool.parallelFor(0, 100, 7,
+                             [&](const int64_t begin, const int64_t end) {
+                                 sum += end - begin;
+                             });
+            ++nDone;
+        });
+    }
+
+    while (nDone < nTasks)
+        std::this_thread::yield();
+    TEST(sum == int64_t(nTasks) * 100);
+}
+
+void _testSetup(eq::util::ThreadPool& pool)
+{
+    std::atomic<bool> running(true);
+    std::atomic<size_t> nPosted(0);
+    std::atomic<size_t> nDone(0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 2; ++i)
+        threads.emplace_back([&] {
+            while (running)
+            {
+                std::atomic<int64_t> sum(0);
+                pool.parallelFor(0, 1000, 10,
+                                 [&](const int64_t begin, const int64_t end) {
+                                     sum += end - begin;
+                                 });
+                TEST(sum == 1000);
+                TEST(pool.getNumThreads() <= 4);
+
+                ++nPosted;
+                pool.post([&] { ++nDone; });
+            }
+        });
+
+    for (size_t i = 0; i < 50; ++i)
+        pool.setup(i % 4, 0);
+
+    running = false;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // resizing the pool finishes the posted tasks beforehand
+    pool.setup(0, 0);
+    TEST(nDone == nPosted);
+}
+}
+
+int main(int, char**)
+{
+    eq::util::ThreadPool pool(4);
+    TEST(pool.getNumThreads() == 4);
+    _testLoops(pool);
+    _testConcurrentLoops(pool);
+    _testPost(pool);
+    _testSetup(pool);
+
+    pool.setup(0, 0);
+    TEST(pool.getNumThreads() == 0);
+    _testLoops(pool);
+    _testPost(pool);
+
+    eq::util::ThreadPool& instance = eq::util::ThreadPool::getInstance();
+    TEST(instance.getNumThreads() ==
+         eq::util::ThreadPool::getDefaultNumThreads());
+    _testLoops(instance);
+    _testConcurrentLoops(instance);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the order of the image transmissions of a node: earlier frames go
+// first, small transmissions overtake large ones queued at the same time, and
+// the transmissions of a frame data can be run before signalling it ready.
+
+#include <lunchbox/test.h>
+
+#include <eq/detail/transmitScheduler.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+typedef eq::detail::TransmitScheduler::Task Task;
+
+const co::ObjectVersion _frameData1(lunchbox::uint128_t(1), co::VERSION_FIRST);
+const co::ObjectVersion _frameData2(lunchbox::uint128_t(2), co::VERSION_FIRST);
+const uint64_t _small = 4096;
+const uint64_t _large = 1024 * 1024 * 1024;
+
+std::vector<int> _order;
+
+Task _task(const int id)
+{
+    return [id] {
+        _order.push_back(id);
+        return uint64_t(0);
+    };
+}
+
+void _testFrames()
+{
+    eq::detail::TransmitScheduler scheduler;
+    scheduler.push(_frameData2, 2, _small, _task(2));
+    scheduler.push(_frameData1, 1, _large, _task(1));
+
+    _order.clear();
+    TEST(scheduler.runNext());
+    TEST(scheduler.runNext());
+    TEST(!scheduler.runNext());
+    TEST(_order == std::vector<int>({1, 2}));
+}
+
+void _testDeadlines()
+{
+    eq::detail::TransmitScheduler scheduler;
+    scheduler.push(_frameData1, 1, _large, _task(1));
+    scheduler.push(_frameData1, 1, _small, _task(2));
+    scheduler.push(_frameData1, 1, _small, _task(3));
+
+    // small images overtake the large one, equal ones keep their order
+    _order.clear();
+    while (scheduler.runNext())
+        ;
+    TEST(_order == std::vector<int>({2, 3, 1}));
+}
+
+void _testRunFrameData()
+{
+    eq::detail::TransmitScheduler scheduler;
+    scheduler.push(_frameData1, 1, _small, _task(1));
+    scheduler.push(_frameData2, 1, _small, _task(2));
+    scheduler.push(_frameData1, 1, _large, _task(3));
+
+    // all transmissions of a frame data run before it is signalled ready
+    _order.clear();
+    scheduler.run(_frameData1);
+    TEST(_order == std::vector<int>({1, 3}));
+
+    scheduler.run(_frameData1);
+    TEST(_order.size() == 2);
+
+    TEST(scheduler.runNext());
+    TEST(!scheduler.runNext());
+    TEST(_order == std::vector<int>({1, 3, 2}));
+}
+}
+
+int main(int, char**)
+{
+    _testFrames();
+    _testDeadlines();
+    _testRunFrameData();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests the numerical stability of CPU alpha-blending over many slices against
+// a double-precision reference, and bit-exactness of all SIMD kernels.
+
+namespace
+{
+const eq::PixelViewport _pvp(0, 0, 97, 61);
+const size_t _nSlices = 48;
+
+/** Fill premultiplied color with alpha being the transmitted light. */
+void _fill(eq::Image& image, std::mt19937& rng, const bool transparent)
+{
+    std::vector<uint8_t> color(_pvp.getArea() * 4);
+    for (size_t i = 0; i < color.size(); i += 4)
+    {
+        const uint8_t alpha = transparent ? 255 : 128 + rng() % 128;
+        const uint32_t opacity = 255 - alpha;
+        for (size_t j = 0; j < 3; ++j)
+            color[i + j] = uint8_t(rng() % (opacity + 1));
+        color[i + 3] = alpha;
+    }
+
+    eqTest::setPixels(image, _pvp,
+                      reinterpret_cast<const uint32_t*>(color.data()), 0);
+}
+
+eq::ImageOps _createOps(const std::vector<eq::Image>& images)
+{
+    eq::ImageOps ops;
+    for (const eq::Image& image : images)
+    {
+        eq::ImageOp op;
+        op.image = &image;
+        op.buffers = eq::Frame::Buffer::color;
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+std::vector<double> _blendReference(const eq::ImageOps& ops)
+{
+    // same initialization as Image::clearPixelData
+    std::vector<double> result(_pvp.getArea() * 4, 0.);
+    for (size_t i = 3; i < result.size(); i += 4)
+        result[i] = 255.;
+
+    for (const eq::ImageOp& op : ops)
+    {
+        const uint8_t* src =
+            op.image->getPixelPointer(eq::Frame::Buffer::color);
+        for (size_t i = 0; i < result.size(); i += 4)
+        {
+            const double alpha = src[i + 3] / 255.;
+            for (size_t j = 0; j < 3; ++j)
+                result[i + j] = src[i + j] + alpha * result[i + j];
+            result[i + 3] = alpha * result[i + 3];
+        }
+    }
+    return result;
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    std::vector<eq::Image> slices(_nSlices);
+    for (eq::Image& image : slices)
+    {
+        _fill(image, rng, false);
+        TEST(image.hasAlpha());
+    }
+
+    const eq::ImageOps& ops = _createOps(slices);
+    const std::vector<double>& expected = _blendReference(ops);
+    const size_t size = _pvp.getArea() * 4;
+    std::vector<uint8_t> first;
+
+    const char* const simds[] = {"none", "sse4.1", "avx2", "avx512"};
+    for (const char* simd : simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, true);
+        TEST(result);
+        TEST(result->getPixelDataSize(eq::Frame::Buffer::color) == size);
+
+        const uint8_t* pixels =
+            result->getPixelPointer(eq::Frame::Buffer::color);
+        if (first.empty())
+            first.assign(pixels, pixels + size);
+        TESTINFO(memcmp(pixels, first.data(), size) == 0,
+                 "SIMD blending using " << simd << " is not bit-exact");
+
+        double maxError = 0.;
+        double sumError = 0.;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const double error = pixels[i] - expected[i];
+            maxError = std::max(maxError, std::abs(error));
+            sumError += error;
+        }
+        const double meanError = sumError / double(size);
+
+        // rounding errors stay bounded and unbiased over all slices
+        TESTINFO(maxError <= 3., "Max error " << maxError << " using " << simd);
+        TESTINFO(std::abs(meanError) <= .5,
+                 "Mean error " << meanError << " using " << simd);
+    }
+
+    // fully transparent slices must not darken the image
+    std::vector<eq::Image> transparent(64);
+    _fill(transparent.front(), rng, false);
+    for (size_t i = 1; i < transparent.size(); ++i)
+        _fill(transparent[i], rng, true);
+
+    eq::ImageOps transparentOps = _createOps(transparent);
+    const eq::Image* result =
+        eq::Compositor::mergeImagesCPU(transparentOps, true);
+    TEST(result);
+    const std::vector<uint8_t> blended(
+        result->getPixelPointer(eq::Frame::Buffer::color),
+        result->getPixelPointer(eq::Frame::Buffer::color) + size);
+
+    transparentOps.resize(1);
+    result = eq::Compositor::mergeImagesCPU(transparentOps, true);
+    TEST(result);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                blended.data(), size) == 0);
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQTEST_COMPOSITOR_COMMON_H
+#define EQTEST_COMPOSITOR_COMMON_H
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <random>
+#include <vector>
+
+// Helpers shared by the compositor tests.
+
+namespace eqTest
+{
+/** Select the SIMD kernels used by the compositor: none|sse4.1|avx2|avx512 */
+inline void setSIMD(const char* simd)
+{
+    eq::Compositor::setSIMD(simd);
+}
+
+/** Set RGBA color and, if given, unsigned int depth pixels of an image. */
+inline void setPixels(eq::Image& image, const eq::PixelViewport& pvp,
+                      const uint32_t* color, const uint32_t* depth)
+{
+    image.setPixelViewport(pvp);
+
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    pixels.pixels = const_cast<uint32_t*>(color);
+    image.setPixelData(eq::Frame::Buffer::color, pixels);
+
+    if (!depth)
+        return;
+
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.pixels = const_cast<uint32_t*>(depth);
+    image.setPixelData(eq::Frame::Buffer::depth, pixels);
+}
+
+/** @return a random depth: a mix of background, equal and random values. */
+inline uint32_t randomDepth(std::mt19937& rng)
+{
+    switch (rng() % 4)
+    {
+    case 0:
+        return 0xFFFFFFFFu;
+    case 1:
+        return 0x80000000u;
+    default:
+        return rng();
+    }
+}
+
+/** Fill an image with random color and depth pixels. */
+inline void fill(eq::Image& image, const eq::PixelViewport& pvp,
+                 std::mt19937& rng)
+{
+    const size_t nPixels = pvp.getArea();
+    std::vector<uint32_t> color(nPixels);
+    std::vector<uint32_t> depth(nPixels);
+    for (size_t i = 0; i < nPixels; ++i)
+    {
+        color[i] = rng();
+        depth[i] = randomDepth(rng);
+    }
+    setPixels(image, pvp, color.data(), depth.data());
+}
+}
+
+#endif
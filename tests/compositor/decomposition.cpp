@@ -0,0 +1,246 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/fabric/pixel.h>
+#include <eq/fabric/renderContext.h>
+#include <eq/fabric/subPixel.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests CPU compositing of pixel decompositions, which are de-interleaved into
+// the destination, and of subpixel decompositions, which are averaged, against
+// reference implementations for all SIMD kernels.
+
+namespace
+{
+const int32_t _width = 69; // destination size
+const int32_t _height = 23;
+const eq::Pixel _pixels[] = {eq::Pixel(0, 0, 2, 1), eq::Pixel(0, 0, 4, 1),
+                             eq::Pixel(0, 0, 3, 2), eq::Pixel(0, 0, 1, 3)};
+const char* const _simds[] = {"none", "sse4.1", "avx2", "avx512"};
+
+struct Input
+{
+    eq::PixelViewport pvp;
+    eq::RenderContext context;
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+};
+
+void _fill(Input& input, std::mt19937& rng, const bool withDepth)
+{
+    input.color.resize(input.pvp.getArea());
+    for (uint32_t& pixel : input.color)
+        pixel = rng();
+    if (!withDepth)
+        return;
+
+    input.depth.resize(input.pvp.getArea());
+    for (uint32_t& value : input.depth)
+        value = rng() % 4 == 0 ? 0xFFFFFFFFu : rng();
+}
+
+void _setImage(eq::Image& image, const Input& input)
+{
+    eqTest::setPixels(image, input.pvp, input.color.data(),
+                      input.depth.empty() ? 0 : input.depth.data());
+    image.setContext(input.context);
+}
+
+eq::ImageOps _createOps(const std::vector<Input>& inputs,
+                        std::vector<eq::Image>& images)
+{
+    images.resize(inputs.size());
+    eq::ImageOps ops;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        _setImage(images[i], inputs[i]);
+
+        eq::ImageOp op;
+        op.image = &images[i];
+        op.buffers = inputs[i].depth.empty()
+                         ? eq::Frame::Buffer::color
+                         : eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+/** Merge inputs using the given destination pixel mapping. */
+void _mergeReference(const std::vector<Input>& inputs,
+                     const eq::PixelViewport& destPVP,
+                     std::vector<uint32_t>& color,
+                     std::vector<uint32_t>& depth)
+{
+    // same initialization as Image::clearPixelData
+    color.assign(destPVP.getArea(), 0xFF000000u);
+    depth.assign(destPVP.getArea(), 0xFFFFFFFFu);
+
+    for (const Input& input : inputs)
+    {
+        const eq::Pixel& pixel = input.context.pixel;
+        for (int32_t y = 0; y < input.pvp.h; ++y)
+            for (int32_t x = 0; x < input.pvp.w; ++x)
+            {
+                const int32_t destX = (input.pvp.x + x) * pixel.w + pixel.x;
+                const int32_t destY = (input.pvp.y + y) * pixel.h + pixel.y;
+                const size_t dst =
+                    (destY - destPVP.y) * destPVP.w + destX - destPVP.x;
+                const size_t src = y * input.pvp.w + x;
+
+                if (input.depth.empty())
+                {
+                    color[dst] = input.color[src];
+                    depth[dst] = 0;
+                }
+                else if (depth[dst] > input.depth[src])
+                {
+                    color[dst] = input.color[src];
+                    depth[dst] = input.depth[src];
+                }
+            }
+    }
+}
+
+void _testPixel(const eq::Pixel& decomposition, const size_t nLayers,
+                std::mt19937& rng)
+{
+    // nLayers depth-composited pixel decompositions of the destination
+    std::vector<Input> inputs;
+    for (size_t layer = 0; layer < nLayers; ++layer)
+        for (uint32_t y = 0; y < decomposition.h; ++y)
+            for (uint32_t x = 0; x < decomposition.w; ++x)
+            {
+                Input input;
+                input.context.pixel =
+                    eq::Pixel(x, y, decomposition.w, decomposition.h);
+                input.pvp = eq::PixelViewport(0, 0, _width, _height);
+                input.pvp.apply(input.context.pixel);
+                _fill(input, rng, nLayers > 1);
+                inputs.push_back(input);
+            }
+
+    std::vector<eq::Image> images;
+    const eq::ImageOps& ops = _createOps(inputs, images);
+
+    for (const char* simd : _simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+        TESTINFO(result, decomposition);
+
+        const eq::PixelViewport& pvp = result->getPixelViewport();
+        TEST(pvp.w >= _width && pvp.h >= _height);
+        std::vector<uint32_t> color, depth;
+        _mergeReference(inputs, pvp, color, depth);
+
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                        color.data(), color.size() * 4) == 0,
+                 decomposition << " with " << nLayers << " layers using "
+                               << simd);
+        if (nLayers > 1)
+            TESTINFO(
+                memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                       depth.data(), depth.size() * 4) == 0,
+                decomposition << " depth mismatch using " << simd);
+    }
+}
+
+void _testSubPixel(const bool withDepth, std::mt19937& rng)
+{
+    // three subpixel steps, each rendered by two images which overlap for
+    // depth compositing and are side by side otherwise
+    const uint32_t nSteps = 3;
+    std::vector<Input> inputs;
+    for (uint32_t i = 0; i < nSteps; ++i)
+        for (int32_t j = 0; j < 2; ++j)
+        {
+            Input input;
+            input.context.subPixel = eq::SubPixel(i, nSteps);
+            if (withDepth)
+                input.pvp = eq::PixelViewport(j * 20, j * 3, _width - 20,
+                                              _height - 3);
+            else
+                input.pvp = eq::PixelViewport(j * 35, 0, 35 - j, _height);
+            _fill(input, rng, withDepth);
+            inputs.push_back(input);
+        }
+
+    std::vector<eq::Image> images;
+    const eq::ImageOps& ops = _createOps(inputs, images);
+    TEST(eq::Compositor::isSubPixelDecomposition(ops));
+
+    const eq::PixelViewport destPVP(0, 0, _width, _height);
+    std::vector<uint32_t> sum(destPVP.getArea() * 4, 0);
+    for (uint32_t i = 0; i < nSteps; ++i)
+    {
+        const std::vector<Input> step(inputs.begin() + i * 2,
+                                      inputs.begin() + i * 2 + 2);
+        std::vector<uint32_t> color, depth;
+        _mergeReference(step, destPVP, color, depth);
+        for (size_t j = 0; j < color.size(); ++j)
+            for (size_t k = 0; k < 4; ++k)
+                sum[j * 4 + k] += (color[j] >> (k * 8)) & 0xFF;
+    }
+    std::vector<uint8_t> expected(sum.size());
+    for (size_t i = 0; i < sum.size(); ++i)
+        expected[i] = uint8_t((sum[i] + nSteps / 2) / nSteps);
+
+    for (const char* simd : _simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+        TEST(result);
+        TEST(result->getPixelViewport() == destPVP);
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                        expected.data(), expected.size()) == 0,
+                 "Subpixel average " << (withDepth ? "DB" : "2D") << " using "
+                                     << simd);
+    }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    for (const eq::Pixel& pixel : _pixels)
+    {
+        _testPixel(pixel, 1, rng);
+        _testPixel(pixel, 2, rng);
+    }
+    _testSubPixel(false, rng);
+    _testSubPixel(true, rng);
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
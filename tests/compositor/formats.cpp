@@ -0,0 +1,357 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests CPU depth compositing and alpha-blending of RGB10_A2, RGBA16F and
+// RGBA32F images: depth compositing and blending with all SIMD kernels have to
+// be bit-exact, and blending has to stay close to a double-precision reference.
+
+namespace
+{
+const eq::PixelViewport _pvp(0, 0, 67, 41); // not a multiple of any SIMD width
+const size_t _nImages = 5;
+const size_t _nSlices = 16;
+
+enum Type
+{
+    TYPE_RGB10A2,
+    TYPE_RGBA16F,
+    TYPE_RGBA32F
+};
+
+struct Format
+{
+    const char* name;
+    Type type;
+    uint32_t internalFormat;
+    uint32_t externalFormat;
+    uint32_t pixelSize;
+    double tolerance; // max blending error in channel units
+};
+
+const Format _formats[] = {
+    {"RGB10_A2", TYPE_RGB10A2, EQ_COMPRESSOR_DATATYPE_RGB10_A2,
+     EQ_COMPRESSOR_DATATYPE_RGB10_A2, 4, 2.},
+    {"RGBA16F", TYPE_RGBA16F, EQ_COMPRESSOR_DATATYPE_RGBA16F,
+     EQ_COMPRESSOR_DATATYPE_RGBA16F, 8, 1e-2},
+    {"RGBA32F", TYPE_RGBA32F, EQ_COMPRESSOR_DATATYPE_RGBA32F,
+     EQ_COMPRESSOR_DATATYPE_RGBA32F, 16, 1e-4}};
+
+const char* const _simds[] = {"none", "sse4.1", "avx2", "avx512"};
+
+double _halfToDouble(const uint16_t value)
+{
+    const int exponent = (value >> 10) & 0x1F;
+    const int mantissa = value & 0x3FF;
+    const double result = exponent == 0
+                              ? std::ldexp(double(mantissa), -24)
+                              : std::ldexp(double(1024 + mantissa),
+                                           exponent - 25);
+    return (value & 0x8000) ? -result : result;
+}
+
+void _setColor(eq::Image& image, const Format& format, const void* pixels)
+{
+    image.setPixelViewport(_pvp);
+
+    eq::PixelData data;
+    data.internalFormat = format.internalFormat;
+    data.externalFormat = format.externalFormat;
+    data.pixelSize = format.pixelSize;
+    data.pvp = _pvp;
+    data.pixels = const_cast<void*>(pixels);
+    image.setPixelData(eq::Frame::Buffer::color, data);
+}
+
+void _setDepth(eq::Image& image, const std::vector<uint32_t>& depth)
+{
+    eq::PixelData data;
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    data.pixelSize = 4;
+    data.pvp = _pvp;
+    data.pixels = const_cast<uint32_t*>(depth.data());
+    image.setPixelData(eq::Frame::Buffer::depth, data);
+}
+
+/** @return a cleared pixel, same as Image::clearPixelData. */
+std::vector<uint8_t> _clearPixel(const Format& format)
+{
+    std::vector<uint8_t> pixel(format.pixelSize, 0);
+    switch (format.type)
+    {
+    case TYPE_RGB10A2:
+    {
+        const uint32_t value = 0x3u;
+        memcpy(pixel.data(), &value, 4);
+        break;
+    }
+    case TYPE_RGBA16F:
+    {
+        const uint16_t value = 0x3C00u;
+        memcpy(pixel.data() + 6, &value, 2);
+        break;
+    }
+    case TYPE_RGBA32F:
+    {
+        const float value = 1.f;
+        memcpy(pixel.data() + 12, &value, 4);
+        break;
+    }
+    }
+    return pixel;
+}
+
+/** @return a premultiplied color pixel with alpha in [0.5, 1]. */
+std::vector<uint8_t> _randomPixel(const Format& format, std::mt19937& rng)
+{
+    std::vector<uint8_t> pixel(format.pixelSize);
+    switch (format.type)
+    {
+    case TYPE_RGB10A2:
+    {
+        const uint32_t alpha = 2 + rng() % 2;
+        const uint32_t maxColor = 1023 - alpha * 1023 / 3;
+        uint32_t value = alpha;
+        for (uint32_t shift = 2; shift < 32; shift += 10)
+            value |= (rng() % (maxColor + 1)) << shift;
+        memcpy(pixel.data(), &value, 4);
+        break;
+    }
+    case TYPE_RGBA16F:
+    {
+        // positive half floats are ordered like their bit patterns
+        const uint16_t values[4] = {uint16_t(rng() % 0x3801),
+                                    uint16_t(rng() % 0x3801),
+                                    uint16_t(rng() % 0x3801),
+                                    uint16_t(0x3800 + rng() % 0x401)};
+        memcpy(pixel.data(), values, 8);
+        break;
+    }
+    case TYPE_RGBA32F:
+    {
+        std::uniform_real_distribution<float> color(0.f, .5f);
+        std::uniform_real_distribution<float> alpha(.5f, 1.f);
+        const float values[4] = {color(rng), color(rng), color(rng),
+                                 alpha(rng)};
+        memcpy(pixel.data(), values, 16);
+        break;
+    }
+    }
+    return pixel;
+}
+
+/** @return the channels of the given pixel in channel units. */
+void _decode(const Format& format, const uint8_t* pixel, double channels[4])
+{
+    switch (format.type)
+    {
+    case TYPE_RGB10A2:
+    {
+        uint32_t value;
+        memcpy(&value, pixel, 4);
+        channels[0] = (value >> 22) & 0x3FF;
+        channels[1] = (value >> 12) & 0x3FF;
+        channels[2] = (value >> 2) & 0x3FF;
+        channels[3] = value & 0x3;
+        break;
+    }
+    case TYPE_RGBA16F:
+    {
+        uint16_t values[4];
+        memcpy(values, pixel, 8);
+        for (size_t i = 0; i < 4; ++i)
+            channels[i] = _halfToDouble(values[i]);
+        break;
+    }
+    case TYPE_RGBA32F:
+    {
+        float values[4];
+        memcpy(values, pixel, 16);
+        for (size_t i = 0; i < 4; ++i)
+            channels[i] = values[i];
+        break;
+    }
+    }
+}
+
+void _testMergeDB(const Format& format, std::mt19937& rng)
+{
+    std::vector<eq::Image> images(_nImages);
+    std::vector<std::vector<uint8_t>> colors(_nImages);
+    std::vector<std::vector<uint32_t>> depths(_nImages);
+    eq::ImageOps ops;
+
+    for (size_t i = 0; i < _nImages; ++i)
+    {
+        // raw bytes are fine, depth compositing does not interpret colors
+        colors[i].resize(_pvp.getArea() * format.pixelSize);
+        for (uint8_t& value : colors[i])
+            value = uint8_t(rng());
+        depths[i].resize(_pvp.getArea());
+        for (uint32_t& depth : depths[i])
+            depth = rng() % 3 == 0 ? 0xFFFFFFFFu : rng();
+
+        _setColor(images[i], format, colors[i].data());
+        _setDepth(images[i], depths[i]);
+
+        eq::ImageOp op;
+        op.image = &images[i];
+        op.buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+        ops.push_back(op);
+    }
+
+    // reference
+    const std::vector<uint8_t>& clear = _clearPixel(format);
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < _pvp.getArea(); ++i)
+        expected.insert(expected.end(), clear.begin(), clear.end());
+    std::vector<uint32_t> expectedDepth(_pvp.getArea(), 0xFFFFFFFFu);
+
+    for (size_t i = 0; i < _nImages; ++i)
+        for (size_t j = 0; j < expectedDepth.size(); ++j)
+            if (expectedDepth[j] > depths[i][j])
+            {
+                expectedDepth[j] = depths[i][j];
+                memcpy(&expected[j * format.pixelSize],
+                       &colors[i][j * format.pixelSize], format.pixelSize);
+            }
+
+    for (const char* simd : _simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+        TESTINFO(result, format.name);
+        TEST(result->getPixelDataSize(eq::Frame::Buffer::color) ==
+             expected.size());
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                        expected.data(), expected.size()) == 0,
+                 format.name << " color mismatch using " << simd);
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                        expectedDepth.data(), expectedDepth.size() * 4) == 0,
+                 format.name << " depth mismatch using " << simd);
+    }
+}
+
+void _testBlend(const Format& format, std::mt19937& rng)
+{
+    std::vector<eq::Image> images(_nSlices);
+    std::vector<std::vector<uint8_t>> colors(_nSlices);
+    eq::ImageOps ops;
+
+    for (size_t i = 0; i < _nSlices; ++i)
+    {
+        for (size_t j = 0; j < _pvp.getArea(); ++j)
+        {
+            const std::vector<uint8_t>& pixel = _randomPixel(format, rng);
+            colors[i].insert(colors[i].end(), pixel.begin(), pixel.end());
+        }
+        _setColor(images[i], format, colors[i].data());
+        TESTINFO(images[i].hasAlpha(), format.name);
+
+        eq::ImageOp op;
+        op.image = &images[i];
+        op.buffers = eq::Frame::Buffer::color;
+        ops.push_back(op);
+    }
+
+    // double-precision reference
+    const double alphaScale = format.type == TYPE_RGB10A2 ? 1. / 3. : 1.;
+    double clear[4];
+    _decode(format, _clearPixel(format).data(), clear);
+    std::vector<double> expected;
+    for (size_t i = 0; i < _pvp.getArea(); ++i)
+        expected.insert(expected.end(), clear, clear + 4);
+
+    for (size_t i = 0; i < _nSlices; ++i)
+        for (size_t j = 0; j < _pvp.getArea(); ++j)
+        {
+            double src[4];
+            _decode(format, &colors[i][j * format.pixelSize], src);
+            double* dst = &expected[j * 4];
+            const double alpha = src[3] * alphaScale;
+            for (size_t k = 0; k < 3; ++k)
+                dst[k] = src[k] + alpha * dst[k];
+            dst[3] = alpha * dst[3];
+        }
+
+    const size_t size = _pvp.getArea() * format.pixelSize;
+    std::vector<uint8_t> first;
+    for (const char* simd : _simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, true);
+        TESTINFO(result, format.name);
+        TEST(result->getPixelDataSize(eq::Frame::Buffer::color) == size);
+
+        const uint8_t* pixels =
+            result->getPixelPointer(eq::Frame::Buffer::color);
+        if (first.empty())
+            first.assign(pixels, pixels + size);
+        TESTINFO(memcmp(pixels, first.data(), size) == 0,
+                 format.name << " blending using " << simd
+                             << " is not bit-exact");
+
+        double maxError = 0.;
+        for (size_t j = 0; j < _pvp.getArea(); ++j)
+        {
+            double channels[4];
+            _decode(format, pixels + j * format.pixelSize, channels);
+            for (size_t k = 0; k < 4; ++k)
+            {
+                const double error = channels[k] - expected[j * 4 + k];
+                maxError = std::max(maxError, std::abs(error));
+            }
+        }
+        TESTINFO(maxError <= format.tolerance,
+                 format.name << " max error " << maxError << " using "
+                             << simd);
+    }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    for (const Format& format : _formats)
+    {
+        _testMergeDB(format, rng);
+        _testBlend(format, rng);
+    }
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
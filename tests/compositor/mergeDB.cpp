@@ -0,0 +1,127 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests that all SIMD depth compositing kernels produce bit-exact results
+// compared to a scalar reference implementation.
+
+namespace
+{
+const int32_t _width = 317; // not a multiple of any SIMD width
+const int32_t _height = 123;
+const size_t _nImages = 5;
+
+void _mergeReference(const eq::ImageOps& ops, const eq::PixelViewport& destPVP,
+                     std::vector<uint32_t>& destColor,
+                     std::vector<uint32_t>& destDepth)
+{
+    // same initialization as Image::clearPixelData
+    destColor.assign(destPVP.getArea(), 0);
+    for (uint32_t& pixel : destColor)
+        reinterpret_cast<uint8_t*>(&pixel)[3] = 255;
+    destDepth.assign(destPVP.getArea(), 0xFFFFFFFFu);
+
+    for (const eq::ImageOp& op : ops)
+    {
+        const eq::PixelViewport& pvp = op.image->getPixelViewport();
+        const uint32_t* color = reinterpret_cast<const uint32_t*>(
+            op.image->getPixelPointer(eq::Frame::Buffer::color));
+        const uint32_t* depth = reinterpret_cast<const uint32_t*>(
+            op.image->getPixelPointer(eq::Frame::Buffer::depth));
+
+        for (int32_t y = 0; y < pvp.h; ++y)
+            for (int32_t x = 0; x < pvp.w; ++x)
+            {
+                const size_t src = y * pvp.w + x;
+                const size_t dst =
+                    (op.offset.y() + pvp.y + y - destPVP.y) * destPVP.w +
+                    op.offset.x() + pvp.x + x - destPVP.x;
+                if (destDepth[dst] > depth[src])
+                {
+                    destColor[dst] = color[src];
+                    destDepth[dst] = depth[src];
+                }
+            }
+    }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    std::vector<eq::Image> images(_nImages);
+    eq::ImageOps ops;
+    for (size_t i = 0; i < _nImages; ++i)
+    {
+        // overlapping, unaligned images
+        const eq::PixelViewport pvp(int32_t(i * 7), int32_t(i * 3),
+                                    _width - int32_t(i), _height + int32_t(i));
+        eqTest::fill(images[i], pvp, rng);
+
+        eq::ImageOp op;
+        op.image = &images[i];
+        op.buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+        op.offset = eq::Vector2i(int32_t(i % 2), 0);
+        ops.push_back(op);
+    }
+
+    const char* const simds[] = {"none", "sse4.1", "avx2", "avx512"};
+    std::vector<uint32_t> expectedColor;
+    std::vector<uint32_t> expectedDepth;
+
+    for (const char* simd : simds)
+    {
+        eqTest::setSIMD(simd);
+        const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+        TEST(result);
+
+        const eq::PixelViewport& pvp = result->getPixelViewport();
+        if (expectedColor.empty())
+            _mergeReference(ops, pvp, expectedColor, expectedDepth);
+
+        const size_t size = pvp.getArea() * sizeof(uint32_t);
+        TEST(result->getPixelDataSize(eq::Frame::Buffer::color) == size);
+        TEST(result->getPixelDataSize(eq::Frame::Buffer::depth) == size);
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                        expectedColor.data(), size) == 0,
+                 "Color mismatch using " << simd);
+        TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                        expectedDepth.data(), size) == 0,
+                 "Depth mismatch using " << simd);
+    }
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
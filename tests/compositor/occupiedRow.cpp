@@ -0,0 +1,93 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests that all SIMD foreground test kernels of the CPU ROI finder agree with
+// the scalar implementation, for all row lengths, masks and foreground
+// positions.
+
+#include <lunchbox/test.h>
+
+#include <eq/detail/compositorKernels.h>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+namespace compositor = eq::detail::compositor;
+
+const size_t _maxValues = 70; // covers the tails of all SIMD widths
+
+/** The masks of the supported pixel formats, see roiFinder.cpp */
+const uint32_t _masks[][4] = {
+    {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu}, // depth
+    {0x00FFFFFFu, 0x00FFFFFFu, 0x00FFFFFFu, 0x00FFFFFFu}, // RGBA
+    {0x7FFF7FFFu, 0x00007FFFu, 0x7FFF7FFFu, 0x00007FFFu}, // RGBA16F
+    {0x7FFFFFFFu, 0x7FFFFFFFu, 0x7FFFFFFFu, 0u}};         // RGBA32F
+
+void _testKernel(const compositor::SIMD simd, std::mt19937& rng)
+{
+    const compositor::OccupiedRow reference =
+        compositor::getOccupiedRow(compositor::SIMD_NONE);
+    const compositor::OccupiedRow occupiedRow =
+        compositor::getOccupiedRow(simd);
+    const char* name = compositor::getName(simd);
+
+    for (const uint32_t* mask : _masks)
+    {
+        for (const uint32_t background : {0u, 0xFFFFFFFFu})
+        {
+            for (size_t n = 0; n <= _maxValues; ++n)
+            {
+                std::vector<uint32_t> values(n, background);
+                TESTINFO(!occupiedRow(values.data(), n, mask, background),
+                         name << " " << n);
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    // bits outside of the mask are not foreground
+                    values[i] = background ^ ~mask[i % 4];
+                    TESTINFO(!occupiedRow(values.data(), n, mask, background),
+                             name << " " << n << " " << i);
+
+                    values[i] = background ^ (uint32_t(rng()) | 1u);
+                    TESTINFO(occupiedRow(values.data(), n, mask,
+                                         background) ==
+                                 reference(values.data(), n, mask, background),
+                             name << " " << n << " " << i);
+
+                    values[i] = background ^ mask[i % 4];
+                    TESTINFO(occupiedRow(values.data(), n, mask, background) ==
+                                 (mask[i % 4] != 0),
+                             name << " " << n << " " << i);
+                    values[i] = background;
+                }
+            }
+        }
+    }
+}
+}
+
+int main(int, char**)
+{
+    std::mt19937 rng(42);
+    const compositor::SIMD supported = compositor::getSupportedSIMD();
+    for (int simd = compositor::SIMD_NONE; simd <= supported; ++simd)
+        _testKernel(compositor::SIMD(simd), rng);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/server/radixK.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Simulates the exchange rounds of binary-swap and radix-k compositing on the
+// CPU and tests that the gathered result is identical to merging all source
+// images at once.
+
+namespace
+{
+const eq::PixelViewport _area(0, 0, 131, 97);
+
+/** The framebuffer of one source channel. */
+struct Source
+{
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+};
+
+/** Read back the given region of a source framebuffer. */
+void _readback(const Source& source, const eq::PixelViewport& pvp,
+               eq::Image& image)
+{
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+    for (int32_t y = pvp.y; y < pvp.getYEnd(); ++y)
+    {
+        const size_t start = y * _area.w + pvp.x;
+        color.insert(color.end(), &source.color[start],
+                     &source.color[start + pvp.w]);
+        depth.insert(depth.end(), &source.depth[start],
+                     &source.depth[start + pvp.w]);
+    }
+    eqTest::setPixels(image, pvp, color.data(), depth.data());
+}
+
+/** Write the given image into a source framebuffer. */
+void _draw(const eq::Image& image, Source& source)
+{
+    const eq::PixelViewport& pvp = image.getPixelViewport();
+    const uint32_t* color = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(eq::Frame::Buffer::color));
+    const uint32_t* depth = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(eq::Frame::Buffer::depth));
+
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        const size_t start = (pvp.y + y) * _area.w + pvp.x;
+        memcpy(&source.color[start], color + y * pvp.w, pvp.w * 4);
+        memcpy(&source.depth[start], depth + y * pvp.w, pvp.w * 4);
+    }
+}
+
+eq::ImageOp _getOp(const eq::Image& image)
+{
+    eq::ImageOp op;
+    op.image = &image;
+    op.buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+    return op;
+}
+
+void _testRadixK(const size_t nSources, const uint32_t radix,
+                 std::mt19937& rng)
+{
+    // render
+    std::vector<Source> sources(nSources);
+    std::vector<eq::Image> images(nSources);
+    eq::ImageOps ops;
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        Source& source = sources[i];
+        for (int32_t j = 0; j < _area.getArea(); ++j)
+        {
+            source.color.push_back(rng());
+            source.depth.push_back(rng() % 4 == 0 ? 0xFFFFFFFFu : rng());
+        }
+        eqTest::setPixels(images[i], _area, source.color.data(),
+                   source.depth.data());
+        ops.push_back(_getOp(images[i]));
+    }
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+    const eq::Image expected(*result);
+
+    // exchange
+    const eq::server::RadixK schedule(nSources, radix);
+    size_t nRegions = 1;
+    for (size_t round = 0; round < schedule.getNumRounds(); ++round)
+    {
+        const uint32_t groupSize = schedule.getGroupSize(round);
+        nRegions *= groupSize;
+
+        // send all parts before compositing any of them
+        std::vector<std::vector<eq::Image>> received(nSources);
+        for (size_t i = 0; i < nSources; ++i)
+            received[i].resize(groupSize);
+
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            for (uint32_t part = 0; part < groupSize; ++part)
+            {
+                const size_t partner = schedule.getPartner(i, round, part);
+                TEST(partner < nSources);
+                TEST(schedule.getKeptPart(partner, round) == part);
+
+                const eq::PixelViewport& pvp =
+                    schedule.getPart(i, round, part, _area);
+                TEST(pvp == schedule.getRegion(partner, round + 1, _area));
+                _readback(sources[i], pvp,
+                          received[partner][schedule.getKeptPart(i, round)]);
+            }
+        }
+
+        for (size_t i = 0; i < nSources; ++i)
+        {
+            eq::ImageOps partOps;
+            for (const eq::Image& image : received[i])
+                partOps.push_back(_getOp(image));
+
+            result = eq::Compositor::mergeImagesCPU(partOps, false);
+            TEST(result);
+            TEST(result->getPixelViewport() ==
+                 schedule.getRegion(i, round + 1, _area));
+            _draw(*result, sources[i]);
+        }
+    }
+    TEST(nRegions == nSources);
+
+    // gather
+    std::vector<eq::Image> tiles(nSources);
+    eq::ImageOps tileOps;
+    for (size_t i = 0; i < nSources; ++i)
+    {
+        _readback(sources[i],
+                  schedule.getRegion(i, schedule.getNumRounds(), _area),
+                  tiles[i]);
+        tileOps.push_back(_getOp(tiles[i]));
+    }
+
+    result = eq::Compositor::mergeImagesCPU(tileOps, false);
+    TEST(result);
+    TEST(result->getPixelViewport() == expected.getPixelViewport());
+
+    const size_t size = _area.getArea() * 4;
+    TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                    expected.getPixelPointer(eq::Frame::Buffer::color),
+                    size) == 0,
+             "Color mismatch for " << nSources << " sources, radix " << radix);
+    TESTINFO(memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                    expected.getPixelPointer(eq::Frame::Buffer::depth),
+                    size) == 0,
+             "Depth mismatch for " << nSources << " sources, radix " << radix);
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    _testRadixK(2, 2, rng);
+    _testRadixK(4, 2, rng);  // binary-swap
+    _testRadixK(8, 2, rng);  // binary-swap, three rounds
+    _testRadixK(8, 4, rng);  // radix-k
+    _testRadixK(6, 2, rng);  // groups of two and three
+    _testRadixK(5, 2, rng);  // prime, direct send
+    _testRadixK(12, 8, rng); // groups of six and two
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests the per-row spans of non-background depth pixels and that merging
+// sparse sort-last images using the spans is identical to a full merge.
+
+namespace
+{
+const size_t _nImages = 5;
+const uint32_t _background = 0xFFFFFFFFu;
+
+/** Fill an image with a random disc on a background of maximum depth. */
+void _fill(eq::Image& image, const eq::PixelViewport& pvp, const size_t index,
+           std::mt19937& rng)
+{
+    const size_t nPixels = pvp.getArea();
+    std::vector<uint32_t> color(nPixels);
+    std::vector<uint32_t> depth(nPixels, _background);
+
+    const int32_t cx = int32_t(rng() % pvp.w);
+    const int32_t cy = int32_t(rng() % pvp.h);
+    const int32_t radius = pvp.h / 5;
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const size_t i = size_t(y) * pvp.w + x;
+            color[i] = rng();
+
+            // the last image is empty
+            const int32_t dx = x - cx;
+            const int32_t dy = y - cy;
+            if (index + 1 < _nImages && dx * dx + dy * dy < radius * radius)
+                depth[i] = rng() % (_background - 1);
+        }
+    }
+
+    eqTest::setPixels(image, pvp, color.data(), depth.data());
+}
+
+void _testSpans(const eq::Image& image)
+{
+    const eq::PixelViewport& pvp = image.getPixelViewport();
+    const std::vector<eq::Vector2i>& spans = image.getDepthSpans();
+    TEST(spans.size() == size_t(pvp.h));
+
+    const uint32_t* depth = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(eq::Frame::Buffer::depth));
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        const eq::Vector2i& span = spans[y];
+        TEST(span.x() <= span.y());
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const bool inside = x >= span.x() && x < span.y();
+            const uint32_t value = depth[y * pvp.w + x];
+            if (!inside)
+                TESTINFO(value == _background, x << ", " << y);
+            else if (x == span.x() || x == span.y() - 1)
+                TESTINFO(value != _background, x << ", " << y);
+        }
+    }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    std::vector<eq::Image> images(_nImages);
+    eq::ImageOps ops;
+    for (size_t i = 0; i < _nImages; ++i)
+    {
+        const int32_t n = int32_t(i);
+        _fill(images[i],
+              eq::PixelViewport(n * 11, -n * 7, 211 + n * 13, 143 + n * 5), i,
+              rng);
+        _testSpans(images[i]);
+
+        eq::ImageOp op;
+        op.image = &images[i];
+        op.buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+        op.offset = eq::Vector2i(n % 3, n / 2);
+        ops.push_back(op);
+    }
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+    const eq::Image sparse(*result);
+
+    // writable depth pixels invalidate the spans, forcing a full merge
+    std::vector<eq::Image> copies(images.begin(), images.end());
+    for (size_t i = 0; i < _nImages; ++i)
+    {
+        TEST(!copies[i].getDepthSpans().empty());
+        copies[i].getPixelPointer(eq::Frame::Buffer::depth);
+        TEST(copies[i].getDepthSpans().empty());
+        ops[i].image = &copies[i];
+    }
+
+    result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+    const eq::PixelViewport& pvp = sparse.getPixelViewport();
+    TEST(result->getPixelViewport() == pvp);
+
+    const size_t size = pvp.getArea() * sizeof(uint32_t);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                sparse.getPixelPointer(eq::Frame::Buffer::color), size) == 0);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                sparse.getPixelPointer(eq::Frame::Buffer::depth), size) == 0);
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -26,6 +26,9 @@
 #include <eq/nodeFactory.h>
 #include <lunchbox/clock.h>
 
+#include <cstdlib>
+#include <cstring>
+
 // Tests the functionality of the compositor and computes the performance.
 
 int main(int, char** argv)
@@ -146,6 +149,22 @@ int main(int, char** argv)
               << 5000.0f * size * 2.f / time / 1024.0f / 1024.0f << " MB/s)"
               << std::endl;
 
+    // compare the single-pass tiled merge with one pass per input image
+    const eq::Image reference(*result);
+    eq::Compositor::setTiled(false);
+    clock.reset();
+    result = eq::Compositor::mergeFramesCPU(frames);
+    time = clock.getTimef();
+    eq::Compositor::setTiled(true);
+    TEST(result);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                reference.getPixelPointer(eq::Frame::Buffer::color),
+                reference.getPixelDataSize(eq::Frame::Buffer::color)) == 0);
+
+    std::cout << argv[0] << ": DB 15 images, one pass per image: " << time
+              << " ms (" << 5000.0f * size * 2.f / time / 1024.0f / 1024.0f
+              << " MB/s)" << std::endl;
+
     // 3) alpha-blend assembly test
     frameData->clear();
     frameData->setBuffers(eq::Frame::Buffer::color);
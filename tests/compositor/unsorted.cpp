@@ -0,0 +1,105 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/fabric/drawableConfig.h>
+#include <eq/frame.h>
+#include <eq/frameData.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Tests that merging depth-composited frames as they become ready, which grows
+// the result image frame by frame, produces the same result as merging all
+// images at once.
+
+namespace
+{
+const size_t _nFrames = 4;
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    std::vector<eq::Frame> frames(_nFrames);
+    eq::Frames framePtrs;
+    eq::ImageOps ops;
+
+    for (size_t i = 0; i < _nFrames; ++i)
+    {
+        eq::FrameDataPtr frameData = new eq::FrameData;
+        frameData->setBuffers(eq::Frame::Buffer::color |
+                              eq::Frame::Buffer::depth);
+        eq::Frame& frame = frames[i];
+        frame.setFrameData(frameData);
+        frame.setOffset(eq::Vector2i(int32_t(i % 2), -int32_t(i)));
+
+        // each frame extends the area covered by the previous frames
+        const int32_t n = int32_t(i);
+        for (int32_t j = 0; j < 2; ++j)
+        {
+            eq::Image* image = frameData->newImage(eq::Frame::TYPE_MEMORY,
+                                                   eq::DrawableConfig());
+            eqTest::fill(*image,
+                         eq::PixelViewport(n * 13 - j * 5, j * 7 - n * 3,
+                                           101 + n * 17, 57 + n * 11),
+                         rng);
+
+            eq::ImageOp op(&frame, image);
+            op.offset = frame.getOffset();
+            ops.push_back(op);
+        }
+        framePtrs.push_back(&frame);
+    }
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+    const eq::Image expected(*result);
+    const eq::PixelViewport& pvp = expected.getPixelViewport();
+
+    result = eq::Compositor::mergeFramesCPU(framePtrs);
+    TEST(result);
+    TESTINFO(result->getPixelViewport() == pvp,
+             result->getPixelViewport() << " != " << pvp);
+
+    const size_t size = pvp.getArea() * sizeof(uint32_t);
+    TEST(result->getPixelDataSize(eq::Frame::Buffer::color) == size);
+    TEST(result->getPixelDataSize(eq::Frame::Buffer::depth) == size);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::color),
+                expected.getPixelPointer(eq::Frame::Buffer::color),
+                size) == 0);
+    TEST(memcmp(result->getPixelPointer(eq::Frame::Buffer::depth),
+                expected.getPixelPointer(eq::Frame::Buffer::depth),
+                size) == 0);
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,222 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "common.h"
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Tests CPU compositing of zoomed images with nearest and bilinear filtering
+// against a reference implementation, for fractional up- and downscaling.
+
+namespace
+{
+const eq::Zoom _zooms[] = {eq::Zoom(1.5f, 1.5f), eq::Zoom(.75f, .75f),
+                           eq::Zoom(2.5f, 1.25f), eq::Zoom(.5f, 1.75f)};
+
+eq::PixelViewport _getZoomedPVP(const eq::PixelViewport& pvp,
+                                const eq::Zoom& zoom)
+{
+    eq::PixelViewport zoomed = pvp;
+    zoomed.apply(zoom);
+    return zoomed;
+}
+
+/** @return the nearest source index for a destination pixel. */
+int32_t _nearest(const int32_t position, const int32_t size,
+                 const int32_t zoomedSize)
+{
+    const double source = (position + .5) * size / zoomedSize;
+    return std::min(int32_t(source), size - 1);
+}
+
+/** @return the bilinearly filtered channel at a destination pixel. */
+double _bilinear(const std::vector<uint32_t>& color,
+                 const eq::PixelViewport& pvp,
+                 const eq::PixelViewport& zoomed, const int32_t x,
+                 const int32_t y, const size_t channel)
+{
+    const double u = std::max((x + .5) * pvp.w / zoomed.w - .5, 0.);
+    const double v = std::max((y + .5) * pvp.h / zoomed.h - .5, 0.);
+    const int32_t x0 = std::min(int32_t(u), pvp.w - 1);
+    const int32_t y0 = std::min(int32_t(v), pvp.h - 1);
+    const int32_t x1 = std::min(x0 + 1, pvp.w - 1);
+    const int32_t y1 = std::min(y0 + 1, pvp.h - 1);
+    const double wx = x1 == x0 ? 0. : u - x0;
+    const double wy = y1 == y0 ? 0. : v - y0;
+
+    const auto value = [&](const int32_t sx, const int32_t sy) {
+        return double((color[sy * pvp.w + sx] >> (channel * 8)) & 0xFF);
+    };
+    const double top = value(x0, y0) * (1. - wx) + value(x1, y0) * wx;
+    const double bottom = value(x0, y1) * (1. - wx) + value(x1, y1) * wx;
+    return top * (1. - wy) + bottom * wy;
+}
+
+void _test2D(const eq::Zoom& zoom, const eq::ZoomFilter filter,
+             std::mt19937& rng)
+{
+    const eq::PixelViewport pvp(0, 0, 61, 37);
+    std::vector<uint32_t> color(pvp.getArea());
+    for (uint32_t& pixel : color)
+        pixel = rng();
+
+    eq::Image image;
+    eqTest::setPixels(image, pvp, color.data(), 0);
+
+    // a second, unzoomed image to exercise the mixed case
+    const eq::PixelViewport otherPVP(0, 0, 7, 5);
+    const std::vector<uint32_t> otherColor(otherPVP.getArea(), 0xFFFFFFFFu);
+    eq::Image other;
+    eqTest::setPixels(other, otherPVP, otherColor.data(), 0);
+
+    eq::ImageOps ops(2);
+    ops[0].image = &image;
+    ops[0].buffers = eq::Frame::Buffer::color;
+    ops[0].zoom = zoom;
+    ops[0].zoomFilter = filter;
+    ops[1].image = &other;
+    ops[1].buffers = eq::Frame::Buffer::color;
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+
+    const eq::PixelViewport& zoomed = _getZoomedPVP(pvp, zoom);
+    TESTINFO(result->getPixelViewport() == zoomed,
+             result->getPixelViewport() << " != " << zoomed);
+    const uint32_t* pixels = reinterpret_cast<const uint32_t*>(
+        result->getPixelPointer(eq::Frame::Buffer::color));
+
+    for (int32_t y = 0; y < zoomed.h; ++y)
+        for (int32_t x = 0; x < zoomed.w; ++x)
+        {
+            const uint32_t pixel = pixels[y * zoomed.w + x];
+            if (x < otherPVP.w && y < otherPVP.h)
+            {
+                TEST(pixel == 0xFFFFFFFFu);
+                continue;
+            }
+
+            if (filter == eq::FILTER_NEAREST)
+            {
+                const int32_t sx = _nearest(x, pvp.w, zoomed.w);
+                const int32_t sy = _nearest(y, pvp.h, zoomed.h);
+                TESTINFO(pixel == color[sy * pvp.w + sx],
+                         "Nearest zoom " << zoom << " at " << x << ", " << y);
+                continue;
+            }
+
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const double expected =
+                    _bilinear(color, pvp, zoomed, x, y, i);
+                const double value = (pixel >> (i * 8)) & 0xFF;
+                TESTINFO(std::abs(value - expected) <= 1.,
+                         "Bilinear zoom " << zoom << " at " << x << ", " << y
+                                          << ": " << value
+                                          << " != " << expected);
+            }
+        }
+}
+
+void _testDB(const eq::Zoom& zoom, const eq::ZoomFilter filter,
+             std::mt19937& rng)
+{
+    // a zoomed and an unzoomed image covering the same destination area
+    const eq::PixelViewport pvp(0, 0, 40, 24);
+    const eq::PixelViewport& zoomed = _getZoomedPVP(pvp, zoom);
+
+    std::vector<uint32_t> color(pvp.getArea());
+    std::vector<uint32_t> depth(pvp.getArea());
+    for (size_t i = 0; i < color.size(); ++i)
+    {
+        // constant color per image, bilinear filtering has to preserve it
+        color[i] = 0x80402010u;
+        depth[i] = rng();
+    }
+    std::vector<uint32_t> otherColor(zoomed.getArea(), 0xFF00FF00u);
+    std::vector<uint32_t> otherDepth(zoomed.getArea());
+    for (uint32_t& value : otherDepth)
+        value = rng();
+
+    eq::Image image;
+    eq::Image other;
+    eqTest::setPixels(image, pvp, color.data(), depth.data());
+    eqTest::setPixels(other, zoomed, otherColor.data(), otherDepth.data());
+
+    eq::ImageOps ops(2);
+    ops[0].image = &image;
+    ops[0].buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+    ops[0].zoom = zoom;
+    ops[0].zoomFilter = filter;
+    ops[1].image = &other;
+    ops[1].buffers = eq::Frame::Buffer::color | eq::Frame::Buffer::depth;
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, false);
+    TEST(result);
+    TEST(result->getPixelViewport() == zoomed);
+
+    const uint32_t* pixels = reinterpret_cast<const uint32_t*>(
+        result->getPixelPointer(eq::Frame::Buffer::color));
+    const uint32_t* depths = reinterpret_cast<const uint32_t*>(
+        result->getPixelPointer(eq::Frame::Buffer::depth));
+
+    for (int32_t y = 0; y < zoomed.h; ++y)
+        for (int32_t x = 0; x < zoomed.w; ++x)
+        {
+            const size_t i = y * zoomed.w + x;
+            const int32_t sx = _nearest(x, pvp.w, zoomed.w);
+            const int32_t sy = _nearest(y, pvp.h, zoomed.h);
+            const uint32_t zoomedDepth = depth[sy * pvp.w + sx];
+            const bool zoomedWins = zoomedDepth < otherDepth[i];
+
+            TEST(depths[i] == std::min(zoomedDepth, otherDepth[i]));
+            TESTINFO(pixels[i] == (zoomedWins ? color[0] : otherColor[i]),
+                     "DB zoom " << zoom << " at " << x << ", " << y);
+        }
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::mt19937 rng(42);
+    for (const eq::Zoom& zoom : _zooms)
+    {
+        _test2D(zoom, eq::FILTER_NEAREST, rng);
+        _test2D(zoom, eq::FILTER_LINEAR, rng);
+        _testDB(zoom, eq::FILTER_NEAREST, rng);
+        _testDB(zoom, eq::FILTER_LINEAR, rng);
+    }
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests that the cost map splits viewports by their measured cost, and by area
+// where no cost has been measured.
+
+#include <lunchbox/test.h>
+
+#include <eq/server/equalizers/costMap.h>
+
+#include <cmath>
+
+using eq::server::CostMap;
+using eq::server::Viewport;
+
+namespace
+{
+bool _equals(const float a, const float b)
+{
+    return std::abs(a - b) < .001f;
+}
+
+void _testEmpty()
+{
+    const CostMap map;
+    TEST(!map.isValid());
+
+    const Viewport vp(.2f, .1f, .4f, .8f);
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, true, .5f), .5f),
+             map.findSplit(Viewport::FULL, true, .5f));
+    TESTINFO(_equals(map.findSplit(vp, true, .25f), .3f),
+             map.findSplit(vp, true, .25f));
+    TESTINFO(_equals(map.findSplit(vp, false, .25f), .3f),
+             map.findSplit(vp, false, .25f));
+}
+
+void _testUniform()
+{
+    CostMap map;
+    map.update(Viewport::FULL, Viewport::FULL, 10.f);
+    TEST(map.isValid());
+    TESTINFO(_equals(map.getCost(Viewport::FULL), 10.f),
+             map.getCost(Viewport::FULL));
+
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, true, .5f), .5f),
+             map.findSplit(Viewport::FULL, true, .5f));
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, false, .3f), .3f),
+             map.findSplit(Viewport::FULL, false, .3f));
+}
+
+void _testHotspot()
+{
+    // all pixels are rendered in the left quarter
+    CostMap map;
+    map.update(Viewport::FULL, Viewport(0.f, 0.f, .25f, 1.f), 8.f);
+
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, true, .5f), .125f),
+             map.findSplit(Viewport::FULL, true, .5f));
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, false, .5f), .5f),
+             map.findSplit(Viewport::FULL, false, .5f));
+
+    const Viewport left(0.f, 0.f, .5f, 1.f);
+    TESTINFO(_equals(map.findSplit(left, true, .5f), .125f),
+             map.findSplit(left, true, .5f));
+
+    // parts without cost are split by area
+    const Viewport right(.5f, 0.f, .5f, 1.f);
+    TESTINFO(_equals(map.findSplit(right, true, .5f), .75f),
+             map.findSplit(right, true, .5f));
+}
+
+void _testRefine()
+{
+    // the halves are measured separately, the right one is three times slower
+    CostMap map;
+    const Viewport left(0.f, 0.f, .5f, 1.f);
+    const Viewport right(.5f, 0.f, .5f, 1.f);
+    map.update(left, left, 1.f);
+    map.update(right, right, 3.f);
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, true, .5f), 2.f / 3.f),
+             map.findSplit(Viewport::FULL, true, .5f));
+
+    // new measurements blend into the map until it converges
+    map.update(left, left, 3.f);
+    const float split = map.findSplit(Viewport::FULL, true, .5f);
+    TESTINFO(split < 2.f / 3.f && split > .5f, split);
+
+    for (size_t i = 0; i < 100; ++i)
+        map.update(left, left, 3.f);
+    TESTINFO(_equals(map.findSplit(Viewport::FULL, true, .5f), .5f),
+             map.findSplit(Viewport::FULL, true, .5f));
+
+    map.clear();
+    TEST(!map.isValid());
+    TESTINFO(_equals(map.findSplit(right, true, .5f), .75f),
+             map.findSplit(right, true, .5f));
+}
+}
+
+int main(int, char**)
+{
+    _testEmpty();
+    _testUniform();
+    _testHotspot();
+    _testRefine();
+    return EXIT_SUCCESS;
+}
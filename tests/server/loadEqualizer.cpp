@@ -0,0 +1,202 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests that the load equalizer uses the load data independent of its arrival
+// order, ignores the load data of pruned frames and keeps its splits without
+// history when damping is disabled.
+
+#include <lunchbox/test.h>
+
+#include <eq/server/compound.h>
+#include <eq/server/config.h>
+#include <eq/server/equalizers/equalizer.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <eq/server/simulator.h>
+
+#include <lunchbox/init.h>
+
+#include <cmath>
+
+using eq::server::Simulator;
+
+namespace
+{
+const char* const _configFile = "configs/2-window.DB.lb.eqc";
+const eq::server::PixelViewport _pvp(0, 0, 1920, 1200);
+
+eq::server::ServerPtr _load()
+{
+    eq::server::Loader loader;
+    eq::server::ServerPtr server = loader.loadFile(_configFile);
+    TEST(server.isValid());
+    TEST(!server->getConfigs().empty());
+
+    eq::server::Loader::addOutputCompounds(server);
+    eq::server::Loader::addDestinationViews(server);
+    eq::server::Loader::addDefaultObserver(server);
+    eq::server::Loader::convertTo11(server);
+    eq::server::Loader::convertTo12(server);
+    return server;
+}
+
+/** A scene with a hotspot in the front quarter of the range. */
+Simulator::Regions _getRegions()
+{
+    Simulator::Regions regions;
+    regions.push_back(Simulator::Region(eq::server::Viewport::FULL,
+                                        eq::server::Range::ALL, 8.f));
+    regions.push_back(Simulator::Region(eq::server::Viewport::FULL,
+                                        eq::server::Range(0.f, .25f), 32.f));
+    return regions;
+}
+
+bool _equals(const Simulator::Result& lhs, const Simulator::Result& rhs)
+{
+    if (lhs.tasks.size() != rhs.tasks.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.tasks.size(); ++i)
+    {
+        const Simulator::Task& left = lhs.tasks[i];
+        const Simulator::Task& right = rhs.tasks[i];
+        if (left.channel != right.channel || left.range != right.range ||
+            left.drawTime != right.drawTime)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+float _getStart(const Simulator::Result& result, const std::string& channel)
+{
+    for (const Simulator::Task& task : result.tasks)
+        if (task.channel == channel)
+            return task.range.start;
+    TESTINFO(false, channel);
+    return 0.f;
+}
+
+void _testOutOfOrder()
+{
+    eq::server::ServerPtr server = _load();
+    eq::server::ServerPtr reference = _load();
+    {
+        // channel2 reports two frames after channel1 ...
+        Simulator simulator(server->getConfigs().front(), _pvp);
+        simulator.setRegions(_getRegions());
+        simulator.setDelay("channel2", 2);
+
+        // ... while both report in order here, completing the same frames
+        Simulator inOrder(reference->getConfigs().front(), _pvp);
+        inOrder.setRegions(_getRegions());
+        inOrder.setDelay("channel1", 2);
+        inOrder.setDelay("channel2", 2);
+
+        for (size_t i = 0; i < 50; ++i)
+        {
+            const Simulator::Result& result = simulator.simulate();
+            const Simulator::Result& expected = inOrder.simulate();
+            TESTINFO(_equals(result, expected), result.frameNumber);
+        }
+        TESTINFO(simulator.getResult().imbalance < .3f,
+                 simulator.getResult().imbalance);
+    }
+    server->deleteConfigs(); // break server <-> config ref circle
+    reference->deleteConfigs();
+}
+
+void _testPruning()
+{
+    eq::server::ServerPtr server = _load();
+    eq::server::ServerPtr reference = _load();
+    {
+        Simulator simulator(server->getConfigs().front(), _pvp);
+        simulator.setRegions(_getRegions());
+        Simulator inOrder(reference->getConfigs().front(), _pvp);
+        inOrder.setRegions(_getRegions());
+
+        for (size_t i = 0; i < 10; ++i)
+        {
+            simulator.simulate();
+            inOrder.simulate();
+        }
+
+        // the next frame of channel2 arrives after the frame following it,
+        // which prunes the incomplete frame from the history
+        simulator.setDelay("channel2", 3);
+        simulator.simulate();
+        inOrder.simulate();
+        simulator.setDelay("channel2", 0);
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            simulator.simulate();
+            inOrder.simulate();
+        }
+
+        const Simulator::Result& result = simulator.getResult();
+        const Simulator::Result& expected = inOrder.getResult();
+        TESTINFO(result.imbalance < .3f, result.imbalance);
+        const float start = _getStart(result, "channel2");
+        TESTINFO(std::abs(start - _getStart(expected, "channel2")) < .05f,
+                 start << " " << _getStart(expected, "channel2"));
+    }
+    server->deleteConfigs();
+    reference->deleteConfigs();
+}
+
+void _testNoDamping()
+{
+    eq::server::ServerPtr server = _load();
+    eq::server::Config* config = server->getConfigs().front();
+    {
+        const eq::server::Compounds& compounds = config->getCompounds();
+        TEST(!compounds.empty());
+        TEST(!compounds.front()->getEqualizers().empty());
+        compounds.front()->getEqualizers().front()->setDamping(1.f);
+
+        Simulator simulator(config, _pvp);
+        simulator.setRegions(_getRegions());
+        const Simulator::Result first = simulator.simulate();
+        TESTINFO(first.imbalance > .5f, first.imbalance);
+
+        // the load data is dropped, the splits never adapt
+        for (size_t i = 0; i < 20; ++i)
+        {
+            const Simulator::Result& result = simulator.simulate();
+            TESTINFO(_equals(result, first), result.frameNumber);
+        }
+    }
+    server->deleteConfigs();
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+
+    _testOutOfOrder();
+    _testPruning();
+    _testNoDamping();
+
+    eq::server::Global::clear();
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests that the simulated load equalizer of a sort-first config balances a
+// scene with a hotspot.
+
+#include <lunchbox/test.h>
+
+#include <eq/server/config.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <eq/server/simulator.h>
+
+#include <lunchbox/init.h>
+
+#include <cmath>
+
+using eq::server::Simulator;
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+
+    eq::server::Loader loader;
+    eq::server::ServerPtr server =
+        loader.loadFile("configs/2-window.2D.lb.eqc");
+    TEST(server.isValid());
+    TEST(!server->getConfigs().empty());
+
+    eq::server::Loader::addOutputCompounds(server);
+    eq::server::Loader::addDestinationViews(server);
+    eq::server::Loader::addDefaultObserver(server);
+    eq::server::Loader::convertTo11(server);
+    eq::server::Loader::convertTo12(server);
+
+    {
+        Simulator simulator(server->getConfigs().front(),
+                            eq::server::PixelViewport(0, 0, 1920, 1200));
+        Simulator::Regions regions;
+        regions.push_back(Simulator::Region(eq::server::Viewport::FULL,
+                                            eq::server::Range::ALL, 8.f));
+        regions.push_back(
+            Simulator::Region(eq::server::Viewport(.6f, .5f, .2f, .2f),
+                              eq::server::Range::ALL, 32.f));
+        simulator.setRegions(regions);
+
+        // the first frame is split evenly, with the hotspot on one side
+        const Simulator::Result& result = simulator.simulate();
+        TEST(result.frameNumber == 1);
+        TESTINFO(result.tasks.size() == 2, result.tasks.size());
+        TESTINFO(result.imbalance > .5f, result.imbalance);
+
+        for (size_t i = 0; i < 100; ++i)
+            simulator.simulate();
+
+        TESTINFO(result.tasks.size() == 2, result.tasks.size());
+        float width = 0.f;
+        float time = 0.f;
+        for (const Simulator::Task& task : result.tasks)
+        {
+            width += task.vp.w;
+            time += task.drawTime;
+        }
+        TESTINFO(std::abs(width - 1.f) < .001f, width);
+        TESTINFO(std::abs(time - 40.f) < .1f, time);
+        TESTINFO(result.imbalance < .3f, result.imbalance);
+        TESTINFO(result.time < 30.f, result.time);
+    }
+
+    eq::server::Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
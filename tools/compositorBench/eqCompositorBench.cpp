@@ -0,0 +1,508 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Benchmarks the CPU compositing of synthetic images over a sweep of image
+// sizes, input counts, pixel formats, compositing modes, depth occupancy and
+// thread counts. One CSV line or JSON object is written per configuration.
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/util/threadPool.h>
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace po = boost::program_options;
+
+namespace
+{
+const uint32_t _background = 0xFFFFFFFFu;
+
+enum Mode
+{
+    MODE_2D,
+    MODE_DB,
+    MODE_BLEND
+};
+
+struct Format
+{
+    const char* name;
+    uint32_t internalFormat;
+    uint32_t externalFormat;
+    uint32_t pixelSize;
+};
+
+const Format _formats[] = {
+    {"rgba8", EQ_COMPRESSOR_DATATYPE_RGBA, EQ_COMPRESSOR_DATATYPE_RGBA, 4},
+    {"rgba16f", EQ_COMPRESSOR_DATATYPE_RGBA16F, EQ_COMPRESSOR_DATATYPE_RGBA16F,
+     8}};
+
+/** One benchmarked configuration and its results. */
+struct Run
+{
+    Mode mode;
+    const Format* format;
+    eq::Vector2i size;
+    size_t nInputs;
+    float occupancy;
+    size_t nThreads;
+    size_t repetitions;
+    size_t bytes;   // input pixel data per merge
+    size_t pixels;  // input pixels per merge
+    double minTime; // ms
+    double medianTime;
+};
+
+const char* _getModeName(const Mode mode)
+{
+    switch (mode)
+    {
+    case MODE_2D:
+        return "2D";
+    case MODE_DB:
+        return "DB";
+    case MODE_BLEND:
+        return "blend";
+    }
+    return "unknown";
+}
+
+std::vector<std::string> _split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+std::vector<eq::Vector2i> _parseSizes(const std::string& list)
+{
+    std::vector<eq::Vector2i> sizes;
+    for (const std::string& item : _split(list))
+    {
+        const size_t pos = item.find('x');
+        if (pos == std::string::npos)
+            throw std::runtime_error("Size " + item + " is not WIDTHxHEIGHT");
+
+        const eq::Vector2i size(std::stoi(item.substr(0, pos)),
+                                std::stoi(item.substr(pos + 1)));
+        if (size.x() <= 0 || size.y() <= 0)
+            throw std::runtime_error("Invalid size " + item);
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+template <class T>
+std::vector<T> _parseNumbers(const std::string& list, const T minimum)
+{
+    std::vector<T> numbers;
+    for (const std::string& item : _split(list))
+    {
+        const T number = T(std::stod(item));
+        if (number < minimum)
+            throw std::runtime_error("Invalid value " + item);
+        numbers.push_back(number);
+    }
+    return numbers;
+}
+
+std::vector<Mode> _parseModes(const std::string& list)
+{
+    std::vector<Mode> modes;
+    for (const std::string& item : _split(list))
+    {
+        if (item == "2D" || item == "2d")
+            modes.push_back(MODE_2D);
+        else if (item == "DB" || item == "db")
+            modes.push_back(MODE_DB);
+        else if (item == "blend")
+            modes.push_back(MODE_BLEND);
+        else
+            throw std::runtime_error("Unknown mode " + item);
+    }
+    return modes;
+}
+
+std::vector<const Format*> _parseFormats(const std::string& list)
+{
+    std::vector<const Format*> formats;
+    for (const std::string& item : _split(list))
+    {
+        const Format* found = 0;
+        for (const Format& format : _formats)
+            if (item == format.name)
+                found = &format;
+        if (!found)
+            throw std::runtime_error("Unknown format " + item);
+        formats.push_back(found);
+    }
+    return formats;
+}
+
+/** Set a random premultiplied pixel, in [0, 1] for floats. */
+void _setColor(uint8_t* pixel, const Format& format, std::mt19937& rng)
+{
+    if (format.pixelSize == 4)
+    {
+        const uint8_t alpha = uint8_t(rng());
+        for (size_t i = 0; i < 3; ++i)
+            pixel[i] = uint8_t(rng() % (alpha + 1u));
+        pixel[3] = alpha;
+        return;
+    }
+
+    // half floats: 0x3C00 is 1.0, and smaller bit patterns are smaller values
+    uint16_t* half = reinterpret_cast<uint16_t*>(pixel);
+    const uint16_t alpha = uint16_t(rng() % 0x3C01u);
+    for (size_t i = 0; i < 3; ++i)
+        half[i] = uint16_t(rng() % (alpha + 1u));
+    half[3] = alpha;
+}
+
+/**
+ * Fill the images of one configuration.
+ *
+ * 2D inputs are disjoint horizontal stripes of the destination. DB inputs
+ * cover the destination with a foreground rectangle of the given occupancy on
+ * a background of maximum depth. Blend inputs are full-size premultiplied
+ * color images.
+ */
+void _fillImages(std::vector<eq::Image>& images, eq::ImageOps& ops,
+                 const Mode mode, const Format& format,
+                 const eq::Vector2i& size, const float occupancy,
+                 std::mt19937& rng)
+{
+    const size_t nInputs = images.size();
+    ops.clear();
+    for (size_t i = 0; i < nInputs; ++i)
+    {
+        eq::PixelViewport pvp(0, 0, size.x(), size.y());
+        if (mode == MODE_2D)
+        {
+            pvp.y = int32_t(int64_t(size.y()) * i / nInputs);
+            pvp.h = int32_t(int64_t(size.y()) * (i + 1) / nInputs) - pvp.y;
+        }
+
+        const size_t nPixels = pvp.getArea();
+        std::vector<uint8_t> color(nPixels * format.pixelSize);
+        for (size_t j = 0; j < nPixels; ++j)
+            _setColor(&color[j * format.pixelSize], format, rng);
+
+        eq::Image& image = images[i];
+        image.reset();
+        image.setPixelViewport(pvp);
+
+        eq::PixelData pixels;
+        pixels.internalFormat = format.internalFormat;
+        pixels.externalFormat = format.externalFormat;
+        pixels.pixelSize = format.pixelSize;
+        pixels.pvp = pvp;
+        pixels.pixels = color.data();
+        image.setPixelData(eq::Frame::Buffer::color, pixels);
+
+        eq::ImageOp op;
+        op.image = &image;
+        op.buffers = eq::Frame::Buffer::color;
+        op.offset = eq::Vector2i(0, 0);
+
+        if (mode == MODE_DB)
+        {
+            const float scale = std::sqrt(occupancy);
+            const int32_t w = std::max(1, int32_t(scale * pvp.w + .5f));
+            const int32_t h = std::max(1, int32_t(scale * pvp.h + .5f));
+            const int32_t x0 = int32_t(rng() % (pvp.w - w + 1));
+            const int32_t y0 = int32_t(rng() % (pvp.h - h + 1));
+
+            std::vector<uint32_t> depth(nPixels, _background);
+            for (int32_t y = y0; y < y0 + h; ++y)
+                for (int32_t x = x0; x < x0 + w; ++x)
+                    depth[size_t(y) * pvp.w + x] = rng() % _background;
+
+            pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+            pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+            pixels.pixelSize = 4;
+            pixels.pixels = depth.data();
+            image.setPixelData(eq::Frame::Buffer::depth, pixels);
+            op.buffers |= eq::Frame::Buffer::depth;
+        }
+        ops.push_back(op);
+    }
+}
+
+size_t _getDataSize(const eq::ImageOps& ops)
+{
+    size_t size = 0;
+    for (const eq::ImageOp& op : ops)
+    {
+        size += op.image->getPixelDataSize(eq::Frame::Buffer::color);
+        if (op.buffers & eq::Frame::Buffer::depth)
+            size += op.image->getPixelDataSize(eq::Frame::Buffer::depth);
+    }
+    return size;
+}
+
+size_t _getNumPixels(const eq::ImageOps& ops)
+{
+    size_t pixels = 0;
+    for (const eq::ImageOp& op : ops)
+        pixels += op.image->getPixelViewport().getArea();
+    return pixels;
+}
+
+/** Time the merge of the given operations, after one warm-up merge. */
+void _measure(const eq::ImageOps& ops, Run& run)
+{
+    const bool blend = run.mode == MODE_BLEND;
+    if (!eq::Compositor::mergeImagesCPU(ops, blend))
+        throw std::runtime_error("Image merge failed");
+
+    std::vector<double> times;
+    lunchbox::Clock clock;
+    for (size_t i = 0; i < run.repetitions; ++i)
+    {
+        clock.reset();
+        eq::Compositor::mergeImagesCPU(ops, blend);
+        times.push_back(clock.getTimed());
+    }
+
+    std::sort(times.begin(), times.end());
+    run.minTime = times.front();
+    run.medianTime = times[times.size() / 2];
+    run.bytes = _getDataSize(ops);
+    run.pixels = _getNumPixels(ops);
+}
+
+double _getRate(const size_t amount, const double time)
+{
+    return time > 0. ? double(amount) / time / 1000. : 0.;
+}
+
+void _writeHeader(std::ostream& os, const bool json)
+{
+    if (json)
+        os << "[" << std::endl;
+    else
+        os << "mode,format,width,height,inputs,occupancy,threads,repetitions,"
+           << "min_ms,median_ms,MB_per_s,Mpixel_per_s" << std::endl;
+}
+
+void _writeRun(std::ostream& os, const Run& run, const bool json,
+               const bool first)
+{
+    const double mbPerSecond = _getRate(run.bytes, run.medianTime);
+    const double mpixelPerSecond = _getRate(run.pixels, run.medianTime);
+    if (json)
+    {
+        os << (first ? "" : ",\n") << "  {\"mode\": \""
+           << _getModeName(run.mode) << "\", \"format\": \""
+           << run.format->name << "\", \"width\": " << run.size.x()
+           << ", \"height\": " << run.size.y()
+           << ", \"inputs\": " << run.nInputs
+           << ", \"occupancy\": " << run.occupancy
+           << ", \"threads\": " << run.nThreads
+           << ", \"repetitions\": " << run.repetitions
+           << ", \"min_ms\": " << run.minTime
+           << ", \"median_ms\": " << run.medianTime
+           << ", \"MB_per_s\": " << mbPerSecond
+           << ", \"Mpixel_per_s\": " << mpixelPerSecond << "}";
+        return;
+    }
+
+    os << _getModeName(run.mode) << "," << run.format->name << ","
+       << run.size.x() << "," << run.size.y() << "," << run.nInputs << ","
+       << run.occupancy << "," << run.nThreads << "," << run.repetitions << ","
+       << run.minTime << "," << run.medianTime << "," << mbPerSecond << ","
+       << mpixelPerSecond << std::endl;
+}
+
+void _writeFooter(std::ostream& os, const bool json)
+{
+    if (json)
+        os << "\n]" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::string sizeList = "640x480,1920x1080";
+    std::string inputList = "2,4,8";
+    std::string formatList = "rgba8,rgba16f";
+    std::string modeList = "2D,DB,blend";
+    std::string occupancyList = "1,0.5,0.15";
+    std::ostringstream threadDefault;
+    threadDefault << "1," << eq::util::ThreadPool::getDefaultNumThreads() + 1;
+    std::string threadList = threadDefault.str();
+    size_t repetitions = 10;
+    std::string outputFile;
+    bool json = false;
+    bool showHelp = false;
+
+    std::vector<eq::Vector2i> sizes;
+    std::vector<size_t> inputs;
+    std::vector<const Format*> formats;
+    std::vector<Mode> modes;
+    std::vector<float> occupancies;
+    std::vector<size_t> threads;
+
+    po::options_description options(
+        "eqCompositorBench - CPU compositing benchmark");
+    options.add_options()("help,h", po::bool_switch(&showHelp),
+                          "produce help message")(
+        "sizes,s", po::value<std::string>(&sizeList)->default_value(sizeList),
+        "destination sizes, e.g. 1920x1080,3840x2160")(
+        "inputs,i",
+        po::value<std::string>(&inputList)->default_value(inputList),
+        "number of input images")(
+        "formats,f",
+        po::value<std::string>(&formatList)->default_value(formatList),
+        "color formats: rgba8, rgba16f")(
+        "modes,m", po::value<std::string>(&modeList)->default_value(modeList),
+        "compositing modes: 2D, DB, blend")(
+        "occupancy,c",
+        po::value<std::string>(&occupancyList)->default_value(occupancyList),
+        "foreground fraction of the DB input images")(
+        "threads,t",
+        po::value<std::string>(&threadList)->default_value(threadList),
+        "number of compositing threads, including the calling thread")(
+        "repetitions,r",
+        po::value<size_t>(&repetitions)->default_value(repetitions),
+        "timed merges per configuration")("json,j", po::bool_switch(&json),
+                                          "write JSON instead of CSV")(
+        "output,o", po::value<std::string>(&outputFile),
+        "output file, default stdout");
+
+    try
+    {
+        po::variables_map variableMap;
+        po::store(po::parse_command_line(argc, argv, options), variableMap);
+        po::notify(variableMap);
+
+        sizes = _parseSizes(sizeList);
+        inputs = _parseNumbers<size_t>(inputList, 1);
+        formats = _parseFormats(formatList);
+        modes = _parseModes(modeList);
+        occupancies = _parseNumbers<float>(occupancyList, 0.f);
+        threads = _parseNumbers<size_t>(threadList, 1);
+        if (repetitions == 0)
+            throw std::runtime_error("Need at least one repetition");
+        for (const float occupancy : occupancies)
+            if (occupancy > 1.f)
+                throw std::runtime_error("Occupancy has to be in [0, 1]");
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Command line parse error: " << e.what() << std::endl
+                  << options << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (showHelp)
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+    {
+        file.open(outputFile.c_str());
+        if (!file)
+        {
+            std::cerr << "Can't open " << outputFile << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& os = outputFile.empty() ? std::cout : file;
+
+    eq::NodeFactory nodeFactory;
+    if (!eq::init(0, 0, &nodeFactory))
+    {
+        std::cerr << "Equalizer initialization failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    eq::util::ThreadPool& pool = eq::util::ThreadPool::getInstance();
+    const std::vector<float> fullOccupancy(1, 1.f);
+    std::mt19937 rng(42);
+    bool first = true;
+
+    _writeHeader(os, json);
+    try
+    {
+        for (const eq::Vector2i& size : sizes)
+            for (const Format* format : formats)
+                for (const Mode mode : modes)
+                    for (const size_t nInputs : inputs)
+                    {
+                        const std::vector<float>& occupancyRuns =
+                            mode == MODE_DB ? occupancies : fullOccupancy;
+                        for (const float occupancy : occupancyRuns)
+                        {
+                            std::vector<eq::Image> images(nInputs);
+                            eq::ImageOps ops;
+                            _fillImages(images, ops, mode, *format, size,
+                                        occupancy, rng);
+
+                            for (const size_t nThreads : threads)
+                            {
+                                pool.setup(nThreads - 1, 0);
+
+                                Run run = Run();
+                                run.mode = mode;
+                                run.format = format;
+                                run.size = size;
+                                run.nInputs = nInputs;
+                                run.occupancy = occupancy;
+                                run.nThreads = nThreads;
+                                run.repetitions = repetitions;
+                                _measure(ops, run);
+                                _writeRun(os, run, json, first);
+                                first = false;
+                            }
+                        }
+                    }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        eq::exit();
+        return EXIT_FAILURE;
+    }
+    _writeFooter(os, json);
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
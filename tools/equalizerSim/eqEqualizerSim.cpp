@@ -0,0 +1,405 @@
+/* Copyright (c) 2026, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Simulates the load balancing of a configuration without starting its nodes.
+// The rendering cost of each frame is taken from a synthetic scene or replayed
+// from a trace file. One CSV line per task or one JSON object per frame is
+// written with the assigned viewports and ranges, the task times, the
+// predicted frame time and the load imbalance.
+//
+// Trace files contain one entry per line, '#' starts a comment:
+//   frame                          starts the scene of the next frame
+//   region x y w h start end cost [destination]
+//                                  adds a cost region to the current frame
+//   speed channel factor           sets the speed of a channel from now on
+// The trace is replayed cyclically if more frames are simulated.
+
+#include <eq/server/config.h>
+#include <eq/server/global.h>
+#include <eq/server/init.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <eq/server/simulator.h>
+
+#include <boost/program_options.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace po = boost::program_options;
+using eq::server::Simulator;
+
+namespace
+{
+/** The cost regions and channel speeds of one frame. */
+struct Scene
+{
+    Simulator::Regions regions;
+    std::vector<std::pair<std::string, float>> speeds;
+};
+typedef std::vector<Scene> Scenes;
+
+std::vector<std::string> _split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+eq::server::PixelViewport _parseResolution(const std::string& resolution)
+{
+    const size_t pos = resolution.find('x');
+    if (pos == std::string::npos)
+        throw std::runtime_error("Resolution " + resolution +
+                                 " is not WIDTHxHEIGHT");
+
+    const eq::server::PixelViewport pvp(0, 0,
+                                        std::stoi(resolution.substr(0, pos)),
+                                        std::stoi(resolution.substr(pos + 1)));
+    if (!pvp.hasArea())
+        throw std::runtime_error("Invalid resolution " + resolution);
+    return pvp;
+}
+
+/** Parse channel=factor pairs. */
+std::vector<std::pair<std::string, float>> _parseSpeeds(
+    const std::string& list)
+{
+    std::vector<std::pair<std::string, float>> speeds;
+    for (const std::string& item : _split(list))
+    {
+        const size_t pos = item.rfind('=');
+        if (pos == std::string::npos)
+            throw std::runtime_error("Speed " + item +
+                                     " is not CHANNEL=FACTOR");
+
+        const float speed = std::stof(item.substr(pos + 1));
+        if (speed <= 0.f)
+            throw std::runtime_error("Invalid speed " + item);
+        speeds.push_back(std::make_pair(item.substr(0, pos), speed));
+    }
+    return speeds;
+}
+
+Scenes _readTrace(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file)
+        throw std::runtime_error("Can't open trace " + filename);
+
+    Scenes scenes;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(file, line); ++lineNumber)
+    {
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream stream(line);
+        std::string keyword;
+        if (!(stream >> keyword))
+            continue;
+
+        std::ostringstream where;
+        where << filename << ":" << lineNumber;
+        if (keyword == "frame")
+        {
+            scenes.push_back(Scene());
+            continue;
+        }
+        if (scenes.empty())
+            throw std::runtime_error(where.str() + ": expected frame");
+
+        if (keyword == "region")
+        {
+            Simulator::Region region;
+            stream >> region.vp.x >> region.vp.y >> region.vp.w >>
+                region.vp.h >> region.range.start >> region.range.end >>
+                region.cost;
+            if (!stream || region.cost < 0.f)
+                throw std::runtime_error(where.str() + ": invalid region");
+
+            stream >> region.destination;
+            scenes.back().regions.push_back(region);
+        }
+        else if (keyword == "speed")
+        {
+            std::pair<std::string, float> speed;
+            stream >> speed.first >> speed.second;
+            if (!stream || speed.second <= 0.f)
+                throw std::runtime_error(where.str() + ": invalid speed");
+            scenes.back().speeds.push_back(speed);
+        }
+        else
+            throw std::runtime_error(where.str() + ": unknown entry " +
+                                     keyword);
+    }
+
+    if (scenes.empty())
+        throw std::runtime_error("Trace " + filename + " has no frames");
+    return scenes;
+}
+
+/**
+ * @return the synthetic scene of a frame: a uniform background and a hotspot
+ *         of 80% of the cost, which moves on a circle for the moving scene.
+ */
+Scene _createScene(const std::string& name, const float cost,
+                   const uint32_t period, const uint32_t frameNumber)
+{
+    Scene scene;
+    if (name == "uniform")
+    {
+        scene.regions.push_back(Simulator::Region(eq::server::Viewport::FULL,
+                                                  eq::server::Range::ALL,
+                                                  cost));
+        return scene;
+    }
+
+    float x = .7f;
+    float y = .6f;
+    if (name == "moving")
+    {
+        const float angle = 2.f * float(M_PI) * float(frameNumber % period) /
+                            float(period);
+        x = .5f + .3f * std::cos(angle);
+        y = .5f + .3f * std::sin(angle);
+    }
+    else if (name != "hotspot")
+        throw std::runtime_error("Unknown scene " + name);
+
+    scene.regions.push_back(Simulator::Region(eq::server::Viewport::FULL,
+                                              eq::server::Range::ALL,
+                                              .2f * cost));
+    scene.regions.push_back(
+        Simulator::Region(eq::server::Viewport(x - .1f, y - .1f, .2f, .2f),
+                          eq::server::Range(x - .1f, x + .1f), .8f * cost));
+    return scene;
+}
+
+void _writeHeader(std::ostream& os, const bool json)
+{
+    if (json)
+        os << "[" << std::endl;
+    else
+        os << "frame,channel,destination,x,y,w,h,start,end,draw_ms,"
+           << "transmit_ms,frame_ms,imbalance" << std::endl;
+}
+
+void _writeResult(std::ostream& os, const Simulator::Result& result,
+                  const bool json, const bool first)
+{
+    if (json)
+    {
+        os << (first ? "" : ",\n") << "  {\"frame\": " << result.frameNumber
+           << ", \"frame_ms\": " << result.time
+           << ", \"imbalance\": " << result.imbalance << ", \"tasks\": [";
+        for (size_t i = 0; i < result.tasks.size(); ++i)
+        {
+            const Simulator::Task& task = result.tasks[i];
+            os << (i == 0 ? "" : ",") << "\n    {\"channel\": \""
+               << task.channel << "\", \"destination\": \""
+               << task.destination << "\", \"viewport\": [" << task.vp.x
+               << ", " << task.vp.y << ", " << task.vp.w << ", "
+               << task.vp.h << "], \"range\": [" << task.range.start << ", "
+               << task.range.end << "], \"draw_ms\": " << task.drawTime
+               << ", \"transmit_ms\": " << task.transmitTime << "}";
+        }
+        os << "]}";
+        return;
+    }
+
+    for (const Simulator::Task& task : result.tasks)
+        os << result.frameNumber << "," << task.channel << ","
+           << task.destination << "," << task.vp.x << "," << task.vp.y << ","
+           << task.vp.w << "," << task.vp.h << "," << task.range.start << ","
+           << task.range.end << "," << task.drawTime << ","
+           << task.transmitTime << "," << result.time << ","
+           << result.imbalance << std::endl;
+}
+
+void _writeFooter(std::ostream& os, const bool json)
+{
+    if (json)
+        os << "\n]" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::string configFile;
+    std::string traceFile;
+    std::string sceneName = "moving";
+    std::string speedList;
+    std::string resolution = "1920x1200";
+    uint32_t nFrames = 100;
+    uint32_t period = 100;
+    float cost = 40.f;
+    float transmitCost = 0.f;
+    float assembleCost = 0.f;
+    std::string outputFile;
+    bool json = false;
+    bool showHelp = false;
+
+    Scenes trace;
+    std::vector<std::pair<std::string, float>> speeds;
+    eq::server::PixelViewport pvp;
+
+    po::options_description options(
+        "eqEqualizerSim - offline load balancing simulator");
+    options.add_options()("help,h", po::bool_switch(&showHelp),
+                          "produce help message")(
+        "config,c", po::value<std::string>(&configFile), "the .eqc config")(
+        "frames,n", po::value<uint32_t>(&nFrames)->default_value(nFrames),
+        "number of simulated frames")(
+        "scene,s", po::value<std::string>(&sceneName)->default_value(sceneName),
+        "synthetic scene: uniform, hotspot, moving")(
+        "cost", po::value<float>(&cost)->default_value(cost),
+        "cost of the synthetic scene in ms on a channel of speed one")(
+        "period", po::value<uint32_t>(&period)->default_value(period),
+        "frames per revolution of the moving hotspot")(
+        "trace,t", po::value<std::string>(&traceFile),
+        "replay the scene from a trace file")(
+        "speeds", po::value<std::string>(&speedList),
+        "channel speeds, e.g. channel1=2,channel2=0.5")(
+        "resolution,r",
+        po::value<std::string>(&resolution)->default_value(resolution),
+        "pixel viewport of pipes without a configured one")(
+        "transmit", po::value<float>(&transmitCost)->default_value(0.f),
+        "ms to transmit a frame of the destination size")(
+        "assemble", po::value<float>(&assembleCost)->default_value(0.f),
+        "ms to assemble a frame of the destination size")(
+        "json,j", po::bool_switch(&json), "write JSON instead of CSV")(
+        "output,o", po::value<std::string>(&outputFile),
+        "output file, default stdout");
+
+    po::positional_options_description positional;
+    positional.add("config", 1);
+
+    try
+    {
+        po::variables_map variableMap;
+        po::store(po::command_line_parser(argc, argv)
+                      .options(options)
+                      .positional(positional)
+                      .run(),
+                  variableMap);
+        po::notify(variableMap);
+
+        if (!showHelp && configFile.empty())
+            throw std::runtime_error("No config given");
+        if (period == 0)
+            throw std::runtime_error("Period has to be positive");
+        if (cost < 0.f || transmitCost < 0.f || assembleCost < 0.f)
+            throw std::runtime_error("Costs have to be positive");
+
+        pvp = _parseResolution(resolution);
+        speeds = _parseSpeeds(speedList);
+        if (!traceFile.empty())
+            trace = _readTrace(traceFile);
+        else
+            _createScene(sceneName, cost, period, 0); // validate name
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Command line parse error: " << e.what() << std::endl
+                  << options << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (showHelp)
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+    {
+        file.open(outputFile.c_str());
+        if (!file)
+        {
+            std::cerr << "Can't open " << outputFile << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& os = outputFile.empty() ? std::cout : file;
+
+    if (!eq::server::init(argc, argv))
+        return EXIT_FAILURE;
+
+    eq::server::Loader loader;
+    eq::server::ServerPtr server = loader.loadFile(configFile);
+    if (!server || server->getConfigs().empty())
+    {
+        std::cerr << "Failed to load " << configFile << std::endl;
+        eq::server::exit();
+        return EXIT_FAILURE;
+    }
+
+    eq::server::Loader::addOutputCompounds(server);
+    eq::server::Loader::addDestinationViews(server);
+    eq::server::Loader::addDefaultObserver(server);
+    eq::server::Loader::convertTo11(server);
+    eq::server::Loader::convertTo12(server);
+
+    float totalTime = 0.f;
+    float totalImbalance = 0.f;
+    {
+        Simulator simulator(server->getConfigs().front(), pvp);
+        simulator.setTransmitCost(transmitCost);
+        simulator.setAssembleCost(assembleCost);
+        for (const auto& speed : speeds)
+            simulator.setSpeed(speed.first, speed.second);
+
+        _writeHeader(os, json);
+        for (uint32_t i = 0; i < nFrames; ++i)
+        {
+            const Scene scene =
+                trace.empty() ? _createScene(sceneName, cost, period, i + 1)
+                              : trace[i % trace.size()];
+            for (const auto& speed : scene.speeds)
+                simulator.setSpeed(speed.first, speed.second);
+            simulator.setRegions(scene.regions);
+
+            const Simulator::Result& result = simulator.simulate();
+            _writeResult(os, result, json, i == 0);
+            totalTime += result.time;
+            totalImbalance += result.imbalance;
+        }
+        _writeFooter(os, json);
+    }
+
+    if (nFrames > 0)
+        std::cerr << nFrames << " frames, average frame time "
+                  << totalTime / float(nFrames) << " ms, average imbalance "
+                  << totalImbalance / float(nFrames) << std::endl;
+
+    eq::server::Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    server = 0;
+    return eq::server::exit() ? EXIT_SUCCESS : EXIT_FAILURE;
+}